@@ -512,6 +512,31 @@ Bool TAppEncCfg::parseCfg( Int argc, Char* argv[] )
   ("MIMergeCand,-mi",             m_bUseMIMergeCand,          false, "1: MI merge and AMVP candidate flag")
     ("MIsize,-mir",                 m_iMicroImSize,                  0, "MI picture size (squared)")
 #endif
+#if IT_SS_MI_LATTICE_SEARCH
+  ("MILatticeSearch,-mls",        m_bUseMILatticeSearch,       false, "1: SS integer search only around multiples of the MI size")
+  ("MILatticeRange",              m_iMILatticeRange,               2, "SS search range around each MI lattice point")
+#endif
+#if IT_SS_SEA
+  ("SEASearch,-sea",              m_iSEASearch,                    0, "Full search pruning 0:off 1:successive elimination (SEA) 2:SEA and multilevel SEA (MSEA)")
+#endif
+#if IT_SS_HASH_SEARCH
+  ("SSHashSearch,-ssh",           m_bUseSSHashSearch,          false, "1: look up SS matches in a hash table of the coded CTUs before the window search")
+  ("SSHashThreshold",             m_iSSHashThreshold,              4, "mean absolute difference per sample, in 1/16 of the quantization step, under which a hash match ends the SS search")
+#endif
+#if IT_SS_SAD_CACHE
+  ("SSSadCache,-ssc",             m_bUseSSSadCache,             true, "1: reuse the 8x8 SADs of the SS integer search across the CU depths of a CTU")
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  ("SSBestCand",                  m_iSSBestCandNum, IT_SS_NUMBER_OF_BEST_CAND, "number of best SS integer vectors kept as seeds of the GT search")
+  ("SSBestCandDist",              m_iSSBestCandDist,               0, "SS vectors whose components both differ by at most this are kept once in the best vector list")
+#endif
+#if IT_GT
+  ("GTAffine",                    m_bGTAffine,          (Bool)IT_GT_AFFINE, "1: affine GT, the fourth corner is derived from the other three 0: projective GT, four corners are coded")
+  ("GTMaxIteration",              m_iGTMaxIteration,  IT_MAX_NSS_Iteration, "number of halvings of the GT corner search step, the last step is the precision of the coded corners")
+  ("GTInterpFilter",              m_iGTInterpFilter, IT_GT_Interpolation_Filter, "interpolation of the GT warped samples 0:bilinear 1:nearest 2:DCT-IF")
+  ("GTGradientSearch",            m_iGTGradientSearch,             0, "0: GT corner search, N>0: the GT corners are estimated from the image gradients with at most N Gauss-Newton iterations")
+  ("GTSearchThreads",             m_iGTSearchThreads,              0, "0: the SS seeds of the GT search share their best cost, N>0: the seeds are refined independently on N threads (deterministic for any N)")
+#endif
 
   /* Misc. */
   ("SEIDecodedPictureHash",       m_decodedPictureHashSEIEnabled, 0, "Control generation of decode picture hash SEI messages\n"
@@ -1041,6 +1066,32 @@ Void TAppEncCfg::xCheckParameter()
 #if IT_MI_MERGE_CANDIDATE
   xConfirmPara( m_bUseMIMergeCand == true && m_iMicroImSize <= 0, "Micro-image (MI) size must be greater than 0 when MI merge candidates is available");
 #endif
+#if IT_SS_MI_LATTICE_SEARCH
+  xConfirmPara( m_bUseMILatticeSearch == true && m_iMicroImSize <= 0, "Micro-image (MI) size must be greater than 0 when the MI lattice search is used");
+  xConfirmPara( m_bUseMILatticeSearch == true && ( m_iMILatticeRange < 0 || 2*m_iMILatticeRange >= m_iMicroImSize ), "MILatticeRange must be in the range 0 to (MIsize-1)/2");
+#endif
+#if IT_SS_SEA
+  xConfirmPara( m_iSEASearch < 0 || m_iSEASearch > 2, "SEASearch must be 0, 1 or 2");
+#endif
+#if IT_SS_HASH_SEARCH
+  xConfirmPara( m_iSSHashThreshold < 0, "SSHashThreshold must be greater than or equal to 0");
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  xConfirmPara( m_iSSBestCandNum < 1, "SSBestCand must be greater than 0");
+  xConfirmPara( m_iSSBestCandDist < 0, "SSBestCandDist must be greater than or equal to 0");
+#endif
+#if IT_GT
+  xConfirmPara( m_iGTMaxIteration < 1 || m_iGTMaxIteration > 8, "GTMaxIteration must be in the range 1 to 8");
+  xConfirmPara( m_iGTInterpFilter < 0 || m_iGTInterpFilter > 2, "GTInterpFilter must be 0, 1 or 2");
+  xConfirmPara( m_iGTGradientSearch < 0 || m_iGTGradientSearch > 16, "GTGradientSearch must be in the range 0 to 16");
+#if !IT_GT_FIXED_POINT_WARP
+  xConfirmPara( m_iGTGradientSearch > 0, "GTGradientSearch requires IT_GT_FIXED_POINT_WARP");
+#endif
+  xConfirmPara( m_iGTSearchThreads < 0 || m_iGTSearchThreads > IT_GT_MAX_SEARCH_THREADS, "GTSearchThreads must be in the range 0 to IT_GT_MAX_SEARCH_THREADS");
+#if !IT_GT_PARALLEL_SEEDS
+  xConfirmPara( m_iGTSearchThreads > 0, "GTSearchThreads requires IT_GT_PARALLEL_SEEDS");
+#endif
+#endif
 
 #if ADAPTIVE_QP_SELECTION
   xConfirmPara( m_bUseAdaptQpSelect == true && m_iQP < 0,                                              "AdaptiveQpSelection must be disabled when QP < 0.");
@@ -1971,6 +2022,26 @@ Void TAppEncCfg::xPrintParameter()
 #if IT_MI_MERGE_CANDIDATE
   printf("MI Merge Candidate           : %d\n", m_bUseMIMergeCand );
   printf("MI Resolution                : %dx%d\n", m_iMicroImSize, m_iMicroImSize );
+#endif
+#if IT_SS_MI_LATTICE_SEARCH
+  printf("MI Lattice Search            : %d (range %d)\n", m_bUseMILatticeSearch, m_iMILatticeRange );
+#endif
+#if IT_SS_SEA
+  printf("SEA Search                   : %d\n", m_iSEASearch );
+#endif
+#if IT_SS_HASH_SEARCH
+  printf("SS Hash Search               : %d (threshold %d)\n", m_bUseSSHashSearch, m_iSSHashThreshold );
+#endif
+#if IT_SS_SAD_CACHE
+  printf("SS SAD Cache                 : %d\n", m_bUseSSSadCache );
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  printf("SS Best Candidates           : %d (distance %d)\n", m_iSSBestCandNum, m_iSSBestCandDist );
+#endif
+#if IT_GT
+  printf("GT Tools                     : affine %d, max iteration %d, filter %d\n", m_bGTAffine, m_iGTMaxIteration, m_iGTInterpFilter );
+  printf("GT Gradient Search           : %d\n", m_iGTGradientSearch );
+  printf("GT Search Threads            : %d\n", m_iGTSearchThreads );
 #endif
   printf("Decoding refresh type        : %d\n", m_iDecodingRefreshType );
   printf("QP                           : %5.2f\n", m_fQP );
@@ -270,6 +270,31 @@ protected:
 #if IT_MI_MERGE_CANDIDATE
   Bool      m_bUseMIMergeCand;                                ///< Use of co-located MI candidates in AMVP and Merge
   Int       m_iMicroImSize;
+#endif
+#if IT_SS_MI_LATTICE_SEARCH
+  Bool      m_bUseMILatticeSearch;                            ///< SS integer search only around multiples of the MI size
+  Int       m_iMILatticeRange;                                ///< refinement range around each MI lattice point
+#endif
+#if IT_SS_SEA
+  Int       m_iSEASearch;                                     ///< successive elimination in the full search (0: off, 1: SEA, 2: SEA and MSEA)
+#endif
+#if IT_SS_HASH_SEARCH
+  Bool      m_bUseSSHashSearch;                               ///< hash lookup of SS matches before the window search
+  Int       m_iSSHashThreshold;                               ///< mean absolute difference per sample accepted from the hash lookup (1/16 Qstep)
+#endif
+#if IT_SS_SAD_CACHE
+  Bool      m_bUseSSSadCache;                                 ///< reuse of the SS search SADs across the CU depths of a CTU
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  Int       m_iSSBestCandNum;                                 ///< number of best SS vectors kept for the GT search
+  Int       m_iSSBestCandDist;                                ///< distance under which two SS vectors are kept once
+#endif
+#if IT_GT
+  Bool      m_bGTAffine;                                      ///< affine GT model, three coded corners
+  Int       m_iGTMaxIteration;                                ///< number of halvings of the GT corner search step
+  Int       m_iGTInterpFilter;                                ///< interpolation filter of the GT warp
+  Int       m_iGTGradientSearch;                              ///< Gauss-Newton iterations of the gradient GT estimation (0: corner search)
+  Int       m_iGTSearchThreads;                               ///< threads refining the SS seeds of the GT search independently (0: sequential shared search)
 #endif
   Int       m_TMVPModeId;
   Int       m_signHideFlag;
@@ -90,6 +90,11 @@ Void TAppEncTop::xInitLibCfg()
 #if IT_HOLOSS
   vps.setVpsHoloExtensionFlag                ( m_bUseIntraSS );
   vps.setVpsHoloMIsize                       ( m_iMicroImSize );
+#if IT_GT
+  vps.setVpsHoloGTAffineFlag                 ( m_bGTAffine );
+  vps.setVpsHoloGTMaxIteration               ( m_iGTMaxIteration );
+  vps.setVpsHoloGTInterpFilter               ( m_iGTInterpFilter );
+#endif
 #endif
   m_cTEncTop.setVPS(&vps);
 
@@ -212,6 +217,31 @@ Void TAppEncTop::xInitLibCfg()
   m_cTEncTop.setMIMergeCandFlag               ( m_bUseMIMergeCand );
   m_cTEncTop.setMicroImSize                   ( m_iMicroImSize );
 #endif
+#if IT_SS_MI_LATTICE_SEARCH
+  m_cTEncTop.setUseMILatticeSearch            ( m_bUseMILatticeSearch );
+  m_cTEncTop.setMILatticeRange                ( m_iMILatticeRange );
+#endif
+#if IT_SS_SEA
+  m_cTEncTop.setSEASearch                     ( m_iSEASearch );
+#endif
+#if IT_SS_HASH_SEARCH
+  m_cTEncTop.setUseSSHashSearch               ( m_bUseSSHashSearch );
+  m_cTEncTop.setSSHashThreshold               ( m_iSSHashThreshold );
+#endif
+#if IT_SS_SAD_CACHE
+  m_cTEncTop.setUseSSSadCache                 ( m_bUseSSSadCache );
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  m_cTEncTop.setSSBestCandNum                 ( m_iSSBestCandNum );
+  m_cTEncTop.setSSBestCandDist                ( m_iSSBestCandDist );
+#endif
+#if IT_GT
+  m_cTEncTop.setGTAffine                      ( m_bGTAffine );
+  m_cTEncTop.setGTMaxIteration                ( m_iGTMaxIteration );
+  m_cTEncTop.setGTInterpFilter                ( m_iGTInterpFilter );
+  m_cTEncTop.setGTGradientSearch              ( m_iGTGradientSearch );
+  m_cTEncTop.setGTSearchThreads               ( m_iGTSearchThreads );
+#endif
   
 
   //====== Weighted Prediction ========
@@ -105,8 +105,7 @@ private:
   TComCUMvField m_acCUGT3Field[2];     ///< array of gt3 vectors
 #endif
 #if IT_SS_NUMBER_OF_BEST_CAND
-  TComMv m_SSBestCand[IT_SS_NUMBER_OF_BEST_CAND];
-  Int m_UsedSSBestCand;
+  TComMvTopK m_cSSBestCand;         ///< best integer vectors of the last SS search
 #endif
 
   TCoeff*       m_pcTrCoeffY;         ///< transformed coefficient buffer (Y)
@@ -300,10 +299,8 @@ public:
 #endif
   
 #if IT_SS_NUMBER_OF_BEST_CAND
-  TComMv* getSSBestCand () {return m_SSBestCand;}
-  TComMv getSSBestCand (Int i) {return m_SSBestCand[i];}
-  Int getUsedSSBestCand() {return m_UsedSSBestCand;}
-  Void setUsedSSBestCand(Int Used) {m_UsedSSBestCand = Used;}
+  TComMvTopK* getSSBestCand () {return &m_cSSBestCand;}
+  TComMv getSSBestCand (Int i) {return m_cSSBestCand.getMv(i);}
 #endif
 
   TCoeff*&      getCoeffY             ()                        { return m_pcTrCoeffY;        }
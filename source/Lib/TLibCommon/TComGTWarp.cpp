@@ -0,0 +1,313 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComGTWarp.cpp
+    \brief    row kernels of the fixed-point GT warp
+*/
+
+#include <string.h>
+#include "TComGTWarp.h"
+#include "TComSimd.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if IT_GT && IT_GT_FIXED_POINT_WARP
+
+// ====================================================================================================================
+// C kernels
+// ====================================================================================================================
+
+/** Warp one row, the samples are either written to piDst or compared to piOrg (bSAD)
+ * \returns sum of absolute differences against piOrg (bSAD), 0 otherwise
+ */
+template <Bool bSAD>
+static UInt xGTWarpRowC( const GTWarpRow& rcRow, Pel* piDst, const Pel* piOrg )
+{
+  Int  iPosX = rcRow.iPosX;
+  Int  iPosY = rcRow.iPosY;
+  UInt uiSum = 0;
+
+  for ( Int x = 0; x < rcRow.iWidth; x++ )
+  {
+    Pel iPel = interpolateGTBilinear( rcRow.piRefY, rcRow.iStrideCur, iPosX, iPosY, rcRow.offsetX, rcRow.offsetY, rcRow.iMinPos, rcRow.iMaxPosX, rcRow.iMaxPosY, rcRow.iMaxVal );
+    if ( bSAD )
+    {
+      uiSum += abs( piOrg[x] - iPel );
+    }
+    else
+    {
+      piDst[x] = iPel;
+    }
+    iPosX += rcRow.iStepX;
+    iPosY += rcRow.iStepY;
+  }
+  return uiSum;
+}
+
+static Void xGTWarpRowC( const GTWarpRow& rcRow, Pel* piDst )
+{
+  xGTWarpRowC<false>( rcRow, piDst, NULL );
+}
+
+static UInt xGTWarpRowSADC( const GTWarpRow& rcRow, const Pel* piOrg )
+{
+  return xGTWarpRowC<true>( rcRow, NULL, piOrg );
+}
+
+#if SIMD_X86
+// ====================================================================================================================
+// SSE4.1 kernels
+// ====================================================================================================================
+
+/// two horizontally adjacent samples as one 32-bit word (gather element)
+static inline Int xLoadPelPair( const Pel* piSrc )
+{
+  Int iPair;
+  memcpy( &iPair, piSrc, sizeof( Int ) );
+  return iPair;
+}
+
+/** Interpolate four warped samples
+ * \param vPosX positions of the samples on the transformed grid (32-bit lanes)
+ * \param vPosY positions of the samples on the transformed grid (32-bit lanes)
+ * \returns interpolated samples in 32-bit lanes
+ */
+SIMD_TARGET_SSE41 static inline __m128i xGTWarp4SSE41( const GTWarpRow& rcRow, __m128i vPosX, __m128i vPosY )
+{
+  const Int     iOne      = 1 << IT_GT_WARP_FRAC_BITS;
+  const __m128i vOne      = _mm_set1_epi32( iOne );
+  const __m128i vFracMask = _mm_set1_epi32( iOne - 1 );
+  const __m128i vMinPos   = _mm_set1_epi32( rcRow.iMinPos );
+
+  __m128i vX = _mm_sub_epi32( _mm_srai_epi32( vPosX, IT_GT_WARP_POS_BITS ), _mm_set1_epi32( rcRow.offsetX ) );
+  __m128i vY = _mm_sub_epi32( _mm_srai_epi32( vPosY, IT_GT_WARP_POS_BITS ), _mm_set1_epi32( rcRow.offsetY ) );
+  __m128i vP = _mm_and_si128( _mm_srli_epi32( vPosX, IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ), vFracMask );
+  __m128i vQ = _mm_and_si128( _mm_srli_epi32( vPosY, IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ), vFracMask );
+
+  vX = _mm_min_epi32( _mm_max_epi32( vX, vMinPos ), _mm_set1_epi32( rcRow.iMaxPosX - 1 ) );
+  vY = _mm_min_epi32( _mm_max_epi32( vY, vMinPos ), _mm_set1_epi32( rcRow.iMaxPosY - 1 ) );
+
+  Int aiIdx[4];
+  _mm_storeu_si128( (__m128i*)aiIdx, _mm_add_epi32( _mm_mullo_epi32( vY, _mm_set1_epi32( rcRow.iStrideCur ) ), vX ) );
+
+  const Pel* piTop    = rcRow.piRefY;
+  const Pel* piBottom = rcRow.piRefY + rcRow.iStrideCur;
+  __m128i vTop    = _mm_setr_epi32( xLoadPelPair( piTop    + aiIdx[0] ), xLoadPelPair( piTop    + aiIdx[1] ), xLoadPelPair( piTop    + aiIdx[2] ), xLoadPelPair( piTop    + aiIdx[3] ) );
+  __m128i vBottom = _mm_setr_epi32( xLoadPelPair( piBottom + aiIdx[0] ), xLoadPelPair( piBottom + aiIdx[1] ), xLoadPelPair( piBottom + aiIdx[2] ), xLoadPelPair( piBottom + aiIdx[3] ) );
+
+  // horizontal filter: one multiply-add of the sample pair with the weights (iOne - p, p)
+  __m128i vWeightX = _mm_or_si128( _mm_sub_epi32( vOne, vP ), _mm_slli_epi32( vP, 16 ) );
+  vTop    = _mm_madd_epi16( vTop,    vWeightX );
+  vBottom = _mm_madd_epi16( vBottom, vWeightX );
+
+  // vertical filter: top * (iOne - q) + bottom * q == (top << IT_GT_WARP_FRAC_BITS) + (bottom - top) * q
+  __m128i vSum = _mm_add_epi32( _mm_slli_epi32( vTop, IT_GT_WARP_FRAC_BITS ), _mm_mullo_epi32( _mm_sub_epi32( vBottom, vTop ), vQ ) );
+  vSum = _mm_srai_epi32( _mm_add_epi32( vSum, _mm_set1_epi32( 1 << ( 2 * IT_GT_WARP_FRAC_BITS - 1 ) ) ), 2 * IT_GT_WARP_FRAC_BITS );
+  return _mm_min_epi32( _mm_max_epi32( vSum, _mm_setzero_si128() ), _mm_set1_epi32( rcRow.iMaxVal ) );
+}
+
+template <Bool bSAD>
+SIMD_TARGET_SSE41 static UInt xGTWarpRowSSE41( const GTWarpRow& rcRow, Pel* piDst, const Pel* piOrg )
+{
+  const Int iWidth4 = rcRow.iWidth & ~3;
+  __m128i vPosX  = _mm_add_epi32( _mm_set1_epi32( rcRow.iPosX ), _mm_mullo_epi32( _mm_set1_epi32( rcRow.iStepX ), _mm_setr_epi32( 0, 1, 2, 3 ) ) );
+  __m128i vPosY  = _mm_add_epi32( _mm_set1_epi32( rcRow.iPosY ), _mm_mullo_epi32( _mm_set1_epi32( rcRow.iStepY ), _mm_setr_epi32( 0, 1, 2, 3 ) ) );
+  __m128i vStepX = _mm_set1_epi32( rcRow.iStepX * 4 );
+  __m128i vStepY = _mm_set1_epi32( rcRow.iStepY * 4 );
+  __m128i vSum   = _mm_setzero_si128();
+  Int x;
+
+  for ( x = 0; x < iWidth4; x += 4 )
+  {
+    __m128i vPel = xGTWarp4SSE41( rcRow, vPosX, vPosY );
+    if ( bSAD )
+    {
+      __m128i vOrg = _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)( piOrg + x ) ) );
+      vSum = _mm_add_epi32( vSum, _mm_abs_epi32( _mm_sub_epi32( vOrg, vPel ) ) );
+    }
+    else
+    {
+      _mm_storel_epi64( (__m128i*)( piDst + x ), _mm_packs_epi32( vPel, vPel ) );
+    }
+    vPosX = _mm_add_epi32( vPosX, vStepX );
+    vPosY = _mm_add_epi32( vPosY, vStepY );
+  }
+
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  UInt uiSum = (UInt)_mm_cvtsi128_si32( vSum );
+
+  if ( x < rcRow.iWidth )
+  {
+    GTWarpRow cTail = rcRow;
+    cTail.iPosX  += rcRow.iStepX * x;
+    cTail.iPosY  += rcRow.iStepY * x;
+    cTail.iWidth -= x;
+    uiSum += xGTWarpRowC<bSAD>( cTail, bSAD ? NULL : piDst + x, bSAD ? piOrg + x : NULL );
+  }
+  return uiSum;
+}
+
+SIMD_TARGET_SSE41 static Void xGTWarpRowSSE41( const GTWarpRow& rcRow, Pel* piDst )
+{
+  xGTWarpRowSSE41<false>( rcRow, piDst, NULL );
+}
+
+SIMD_TARGET_SSE41 static UInt xGTWarpRowSADSSE41( const GTWarpRow& rcRow, const Pel* piOrg )
+{
+  return xGTWarpRowSSE41<true>( rcRow, NULL, piOrg );
+}
+
+// ====================================================================================================================
+// AVX2 kernels
+// ====================================================================================================================
+
+/** Interpolate eight warped samples, the sample pairs are fetched with gathers
+ * \param vPosX positions of the samples on the transformed grid (32-bit lanes)
+ * \param vPosY positions of the samples on the transformed grid (32-bit lanes)
+ * \returns interpolated samples in 32-bit lanes
+ */
+SIMD_TARGET_AVX2 static inline __m256i xGTWarp8AVX2( const GTWarpRow& rcRow, __m256i vPosX, __m256i vPosY )
+{
+  const Int     iOne      = 1 << IT_GT_WARP_FRAC_BITS;
+  const __m256i vOne      = _mm256_set1_epi32( iOne );
+  const __m256i vFracMask = _mm256_set1_epi32( iOne - 1 );
+  const __m256i vMinPos   = _mm256_set1_epi32( rcRow.iMinPos );
+
+  __m256i vX = _mm256_sub_epi32( _mm256_srai_epi32( vPosX, IT_GT_WARP_POS_BITS ), _mm256_set1_epi32( rcRow.offsetX ) );
+  __m256i vY = _mm256_sub_epi32( _mm256_srai_epi32( vPosY, IT_GT_WARP_POS_BITS ), _mm256_set1_epi32( rcRow.offsetY ) );
+  __m256i vP = _mm256_and_si256( _mm256_srli_epi32( vPosX, IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ), vFracMask );
+  __m256i vQ = _mm256_and_si256( _mm256_srli_epi32( vPosY, IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ), vFracMask );
+
+  vX = _mm256_min_epi32( _mm256_max_epi32( vX, vMinPos ), _mm256_set1_epi32( rcRow.iMaxPosX - 1 ) );
+  vY = _mm256_min_epi32( _mm256_max_epi32( vY, vMinPos ), _mm256_set1_epi32( rcRow.iMaxPosY - 1 ) );
+
+  // each 32-bit gather element holds the sample pair (X, X+1) of the row
+  __m256i vIdx    = _mm256_add_epi32( _mm256_mullo_epi32( vY, _mm256_set1_epi32( rcRow.iStrideCur ) ), vX );
+  __m256i vTop    = _mm256_i32gather_epi32( (const int*)rcRow.piRefY,                      vIdx, sizeof( Pel ) );
+  __m256i vBottom = _mm256_i32gather_epi32( (const int*)( rcRow.piRefY + rcRow.iStrideCur ), vIdx, sizeof( Pel ) );
+
+  __m256i vWeightX = _mm256_or_si256( _mm256_sub_epi32( vOne, vP ), _mm256_slli_epi32( vP, 16 ) );
+  vTop    = _mm256_madd_epi16( vTop,    vWeightX );
+  vBottom = _mm256_madd_epi16( vBottom, vWeightX );
+
+  __m256i vSum = _mm256_add_epi32( _mm256_slli_epi32( vTop, IT_GT_WARP_FRAC_BITS ), _mm256_mullo_epi32( _mm256_sub_epi32( vBottom, vTop ), vQ ) );
+  vSum = _mm256_srai_epi32( _mm256_add_epi32( vSum, _mm256_set1_epi32( 1 << ( 2 * IT_GT_WARP_FRAC_BITS - 1 ) ) ), 2 * IT_GT_WARP_FRAC_BITS );
+  return _mm256_min_epi32( _mm256_max_epi32( vSum, _mm256_setzero_si256() ), _mm256_set1_epi32( rcRow.iMaxVal ) );
+}
+
+template <Bool bSAD>
+SIMD_TARGET_AVX2 static UInt xGTWarpRowAVX2( const GTWarpRow& rcRow, Pel* piDst, const Pel* piOrg )
+{
+  const Int iWidth8 = rcRow.iWidth & ~7;
+  const __m256i vLane = _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 );
+  __m256i vPosX  = _mm256_add_epi32( _mm256_set1_epi32( rcRow.iPosX ), _mm256_mullo_epi32( _mm256_set1_epi32( rcRow.iStepX ), vLane ) );
+  __m256i vPosY  = _mm256_add_epi32( _mm256_set1_epi32( rcRow.iPosY ), _mm256_mullo_epi32( _mm256_set1_epi32( rcRow.iStepY ), vLane ) );
+  __m256i vStepX = _mm256_set1_epi32( rcRow.iStepX * 8 );
+  __m256i vStepY = _mm256_set1_epi32( rcRow.iStepY * 8 );
+  __m256i vSum   = _mm256_setzero_si256();
+  Int x;
+
+  for ( x = 0; x < iWidth8; x += 8 )
+  {
+    __m256i vPel = xGTWarp8AVX2( rcRow, vPosX, vPosY );
+    if ( bSAD )
+    {
+      __m256i vOrg = _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)( piOrg + x ) ) );
+      vSum = _mm256_add_epi32( vSum, _mm256_abs_epi32( _mm256_sub_epi32( vOrg, vPel ) ) );
+    }
+    else
+    {
+      _mm_storeu_si128( (__m128i*)( piDst + x ), _mm_packs_epi32( _mm256_castsi256_si128( vPel ), _mm256_extracti128_si256( vPel, 1 ) ) );
+    }
+    vPosX = _mm256_add_epi32( vPosX, vStepX );
+    vPosY = _mm256_add_epi32( vPosY, vStepY );
+  }
+
+  __m128i vSum128 = _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) );
+  vSum128 = _mm_add_epi32( vSum128, _mm_shuffle_epi32( vSum128, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  vSum128 = _mm_add_epi32( vSum128, _mm_shuffle_epi32( vSum128, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  UInt uiSum = (UInt)_mm_cvtsi128_si32( vSum128 );
+
+  if ( x < rcRow.iWidth )
+  {
+    // remaining samples with the four lanes kernel
+    GTWarpRow cTail = rcRow;
+    cTail.iPosX  += rcRow.iStepX * x;
+    cTail.iPosY  += rcRow.iStepY * x;
+    cTail.iWidth -= x;
+    uiSum += xGTWarpRowSSE41<bSAD>( cTail, bSAD ? NULL : piDst + x, bSAD ? piOrg + x : NULL );
+  }
+  return uiSum;
+}
+
+SIMD_TARGET_AVX2 static Void xGTWarpRowAVX2( const GTWarpRow& rcRow, Pel* piDst )
+{
+  xGTWarpRowAVX2<false>( rcRow, piDst, NULL );
+}
+
+SIMD_TARGET_AVX2 static UInt xGTWarpRowSADAVX2( const GTWarpRow& rcRow, const Pel* piOrg )
+{
+  return xGTWarpRowAVX2<true>( rcRow, NULL, piOrg );
+}
+#endif
+
+// ====================================================================================================================
+// Kernel selection
+// ====================================================================================================================
+
+Void initGTWarpRowKernels( FpGTWarpRow& rfpWarpRow, FpGTWarpRowSAD& rfpWarpRowSAD )
+{
+  rfpWarpRow    = xGTWarpRowC;
+  rfpWarpRowSAD = xGTWarpRowSADC;
+#if SIMD_X86
+  switch ( getSimdLevel() )
+  {
+    case SIMD_AVX2:
+      rfpWarpRow    = xGTWarpRowAVX2;
+      rfpWarpRowSAD = xGTWarpRowSADAVX2;
+      break;
+    case SIMD_SSE41:
+      rfpWarpRow    = xGTWarpRowSSE41;
+      rfpWarpRowSAD = xGTWarpRowSADSSE41;
+      break;
+    default:
+      break;
+  }
+#endif
+}
+
+#endif
+
+//! \}
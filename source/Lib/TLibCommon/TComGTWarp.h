@@ -0,0 +1,116 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComGTWarp.h
+    \brief    row kernels of the fixed-point GT warp (header)
+*/
+
+#ifndef __TCOMGTWARP__
+#define __TCOMGTWARP__
+
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if IT_GT && IT_GT_FIXED_POINT_WARP
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// one row of a linear (affine or bilinear) GT warp, the sample positions advance by a constant step along the row
+struct GTWarpRow
+{
+  Pel*  piRefY;         ///< top-left sample of the block in the (extended) reference
+  Int   iStrideCur;     ///< stride of the reference
+  Int   iPosX;          ///< horizontal position of the first sample on the transformed grid, in units of 1/(1<<IT_GT_WARP_POS_BITS) samples
+  Int   iPosY;          ///< vertical position of the first sample on the transformed grid
+  Int   iStepX;         ///< horizontal position increment from one sample to the next
+  Int   iStepY;         ///< vertical position increment from one sample to the next
+  Int   offsetX;        ///< horizontal position of the block inside the transformed grid
+  Int   offsetY;        ///< vertical position of the block inside the transformed grid
+  Int   iMinPos;        ///< first reference sample available around the block
+  Int   iMaxPosX;       ///< last reference column available around the block
+  Int   iMaxPosY;       ///< last reference row available around the block
+  Int   iMaxVal;        ///< largest value of the warped samples, (1<<bitDepth)-1
+  Int   iWidth;         ///< number of samples of the row
+};
+
+// for function pointer
+typedef Void (*FpGTWarpRow)    ( const GTWarpRow& rcRow, Pel* piDst );
+typedef UInt (*FpGTWarpRowSAD) ( const GTWarpRow& rcRow, const Pel* piOrg );
+
+// ====================================================================================================================
+// Function definition
+// ====================================================================================================================
+
+/** Bilinear interpolation of one warped sample (IT_GT_Interpolation_Filter == 0)
+ * \param piRefY     pointer to the top-left sample of the block in the (extended) reference
+ * \param iStrideCur stride of the reference
+ * \param iPosX      horizontal position on the transformed grid, in units of 1/(1<<IT_GT_WARP_POS_BITS) samples
+ * \param iPosY      vertical position on the transformed grid, in units of 1/(1<<IT_GT_WARP_POS_BITS) samples
+ * \param offsetX    horizontal position of the block inside the transformed grid
+ * \param offsetY    vertical position of the block inside the transformed grid
+ * \param iMinPos    first reference sample available around the block
+ * \param iMaxPosX   last reference column available around the block
+ * \param iMaxPosY   last reference row available around the block
+ * \param iMaxVal    largest value of the warped samples, (1<<bitDepth)-1
+ */
+inline Pel interpolateGTBilinear( const Pel* piRefY, Int iStrideCur, Int iPosX, Int iPosY, Int offsetX, Int offsetY, Int iMinPos, Int iMaxPosX, Int iMaxPosY, Int iMaxVal )
+{
+  const Int iOne = 1 << IT_GT_WARP_FRAC_BITS;
+  Int X = ( iPosX >> IT_GT_WARP_POS_BITS ) - offsetX;
+  Int Y = ( iPosY >> IT_GT_WARP_POS_BITS ) - offsetY;
+  Int p = ( iPosX >> ( IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ) ) & ( iOne - 1 );
+  Int q = ( iPosY >> ( IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ) ) & ( iOne - 1 );
+
+  // the window clamps the integer position only, the interpolation weights are kept
+  X = Clip3( iMinPos, iMaxPosX - 1, X );
+  Y = Clip3( iMinPos, iMaxPosY - 1, Y );
+
+  const Pel* paux = piRefY + Y * iStrideCur + X;
+  Int iTop    = paux[0]          * ( iOne - p ) + paux[1]              * p;
+  Int iBottom = paux[iStrideCur] * ( iOne - p ) + paux[iStrideCur + 1] * p;
+  Int aux = ( iTop * ( iOne - q ) + iBottom * q + ( 1 << ( 2 * IT_GT_WARP_FRAC_BITS - 1 ) ) ) >> ( 2 * IT_GT_WARP_FRAC_BITS );
+  return (Pel)Clip3( 0, iMaxVal, aux );
+}
+
+/// select the row kernels for the instruction set of the CPU
+Void initGTWarpRowKernels( FpGTWarpRow& rfpWarpRow, FpGTWarpRowSAD& rfpWarpRowSAD );
+
+#endif
+
+//! \}
+
+#endif // __TCOMGTWARP__
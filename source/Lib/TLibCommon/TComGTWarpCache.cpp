@@ -0,0 +1,158 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComGTWarpCache.cpp
+    \brief    cache of GT predicted blocks
+*/
+
+#include "TComGTWarpCache.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+Bool GTWarpCacheKey::operator==( const GTWarpCacheKey& rcKey ) const
+{
+  if ( pcRefPic != rcKey.pcRefPic || iCUAddr != rcKey.iCUAddr || uiAbsPartIdx != rcKey.uiAbsPartIdx ||
+       iWidth != rcKey.iWidth || iHeight != rcKey.iHeight || bBi != rcKey.bBi )
+  {
+    return false;
+  }
+  for ( Int i = 0; i < 5; i++ )
+  {
+    if ( acMv[i] != rcKey.acMv[i] )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+TComGTWarpCache::TComGTWarpCache()
+: m_pcEntries( NULL )
+, m_uiNumEntries( 0 )
+, m_uiNext( 0 )
+{
+}
+
+TComGTWarpCache::~TComGTWarpCache()
+{
+  destroy();
+}
+
+/** Allocate the cache
+ * \param uiNumEntries number of PUs kept
+ * \param iMaxWidth    largest luma width of a PU
+ * \param iMaxHeight   largest luma height of a PU
+ */
+Void TComGTWarpCache::create( UInt uiNumEntries, Int iMaxWidth, Int iMaxHeight )
+{
+  destroy();
+  m_pcEntries    = new Entry[ uiNumEntries ];
+  m_uiNumEntries = uiNumEntries;
+  for ( UInt i = 0; i < uiNumEntries; i++ )
+  {
+    m_pcEntries[i].apiBlk[0] = new Pel[ iMaxWidth * iMaxHeight ];
+    m_pcEntries[i].apiBlk[1] = new Pel[ ( iMaxWidth >> 1 ) * ( iMaxHeight >> 1 ) ];
+    m_pcEntries[i].apiBlk[2] = new Pel[ ( iMaxWidth >> 1 ) * ( iMaxHeight >> 1 ) ];
+  }
+  clear();
+}
+
+Void TComGTWarpCache::destroy()
+{
+  for ( UInt i = 0; i < m_uiNumEntries; i++ )
+  {
+    for ( Int iComp = 0; iComp < 3; iComp++ )
+    {
+      delete[] m_pcEntries[i].apiBlk[iComp];
+    }
+  }
+  delete[] m_pcEntries;
+  m_pcEntries    = NULL;
+  m_uiNumEntries = 0;
+  m_uiNext       = 0;
+}
+
+/** Forget every stored block, to be called whenever the reference samples may have changed
+ */
+Void TComGTWarpCache::clear()
+{
+  for ( UInt i = 0; i < m_uiNumEntries; i++ )
+  {
+    m_pcEntries[i].abValid[0] = m_pcEntries[i].abValid[1] = m_pcEntries[i].abValid[2] = false;
+  }
+  m_uiNext = 0;
+}
+
+/** Find the block of a component predicted with the motion rcKey
+ * \returns the block, of stride the width of the component, or NULL if it is not stored
+ */
+const Pel* TComGTWarpCache::find( const GTWarpCacheKey& rcKey, UInt uiComp ) const
+{
+  for ( UInt i = 0; i < m_uiNumEntries; i++ )
+  {
+    if ( m_pcEntries[i].abValid[uiComp] && m_pcEntries[i].cKey == rcKey )
+    {
+      return m_pcEntries[i].apiBlk[uiComp];
+    }
+  }
+  return NULL;
+}
+
+/** Take the buffer where the block of a component predicted with the motion rcKey is to be written
+ * \returns buffer of stride the width of the component, the block is valid from this call on
+ */
+Pel* TComGTWarpCache::store( const GTWarpCacheKey& rcKey, UInt uiComp )
+{
+  Entry* pcEntry = NULL;
+  for ( UInt i = 0; i < m_uiNumEntries && !pcEntry; i++ )
+  {
+    Entry& rcEntry = m_pcEntries[i];
+    if ( ( rcEntry.abValid[0] || rcEntry.abValid[1] || rcEntry.abValid[2] ) && rcEntry.cKey == rcKey )
+    {
+      pcEntry = &rcEntry;
+    }
+  }
+  if ( !pcEntry )
+  {
+    // the oldest key is replaced
+    pcEntry = &m_pcEntries[m_uiNext];
+    m_uiNext = ( m_uiNext + 1 ) % m_uiNumEntries;
+    pcEntry->cKey       = rcKey;
+    pcEntry->abValid[0] = pcEntry->abValid[1] = pcEntry->abValid[2] = false;
+  }
+  pcEntry->abValid[uiComp] = true;
+  return pcEntry->apiBlk[uiComp];
+}
+
+//! \}
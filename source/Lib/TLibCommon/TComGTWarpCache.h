@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComGTWarpCache.h
+    \brief    cache of GT predicted blocks (header)
+*/
+
+#ifndef __TCOMGTWARPCACHE__
+#define __TCOMGTWARPCACHE__
+
+#include "CommonDef.h"
+#include "TComMv.h"
+
+class TComPicYuv;
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// motion of a GT predicted PU, the key of the cache
+struct GTWarpCacheKey
+{
+  const TComPicYuv* pcRefPic;      ///< reference picture
+  Int               iCUAddr;       ///< address of the CTU
+  UInt              uiAbsPartIdx;  ///< z-order index of the PU in the CTU
+  Int               iWidth;        ///< luma width of the PU
+  Int               iHeight;       ///< luma height of the PU
+  Bool              bBi;           ///< the prediction is kept at the intermediate precision
+  TComMv            acMv[5];       ///< SS vector followed by the four GT corner offsets
+
+  Bool operator==( const GTWarpCacheKey& rcKey ) const;
+};
+
+/// the last GT predicted blocks, so that a PU predicted again with the same motion is copied instead of warped
+class TComGTWarpCache
+{
+private:
+  struct Entry
+  {
+    GTWarpCacheKey cKey;
+    Bool           abValid[3];     ///< the block of each component is stored
+    Pel*           apiBlk [3];     ///< blocks of each component, stored contiguously
+  };
+
+  Entry* m_pcEntries;
+  UInt   m_uiNumEntries;
+  UInt   m_uiNext;                 ///< entry replaced by the next new key
+
+public:
+  TComGTWarpCache();
+  ~TComGTWarpCache();
+
+  Void create ( UInt uiNumEntries, Int iMaxWidth, Int iMaxHeight );
+  Void destroy();
+
+  Bool isActive() const { return m_uiNumEntries > 0; }
+  Void clear  ();
+
+  const Pel* find ( const GTWarpCacheKey& rcKey, UInt uiComp ) const;
+  Pel*       store( const GTWarpCacheKey& rcKey, UInt uiComp );
+};
+
+//! \}
+
+#endif // __TCOMGTWARPCACHE__
@@ -353,4 +353,114 @@ Void TComCUMvField::compress(Char* pePredMode, Int scale)
     }
   }
 } 
+
+#if IT_SS_NUMBER_OF_BEST_CAND
+/** Set the size of the list and empty it
+ * \param iMaxCand number of vectors kept
+ * \param iMinDist vectors whose components both differ by at most this are considered the same
+ */
+Void TComMvTopK::init( Int iMaxCand, Int iMinDist )
+{
+  if ( iMaxCand != m_iMaxCand )
+  {
+    m_acMv   .resize( iMaxCand );
+    m_auiCost.resize( iMaxCand );
+    m_iMaxCand = iMaxCand;
+  }
+  m_iMinDist = iMinDist;
+  m_iNumCand = 0;
+}
+
+/** Offer a searched vector to the list
+ * \param iHor   integer vector
+ * \param iVer
+ * \param uiCost distortion plus vector cost
+ *
+ * A vector close to one already kept only replaces it when cheaper. Otherwise it enters the list while the list
+ * is not full, or replaces the worst vector when cheaper. Ties keep the vector found first.
+ */
+Void TComMvTopK::insert( Int iHor, Int iVer, UInt uiCost )
+{
+  if ( uiCost >= getWorstCost() )
+  {
+    return;
+  }
+
+  for ( Int i = 0; i < m_iNumCand; i++ )
+  {
+    if ( abs( m_acMv[i].getHor() - iHor ) <= m_iMinDist && abs( m_acMv[i].getVer() - iVer ) <= m_iMinDist )
+    {
+      if ( uiCost < m_auiCost[i] )
+      {
+        m_acMv[i].set( iHor, iVer );
+        m_auiCost[i] = uiCost;
+        xSiftDown( i );
+      }
+      return;
+    }
+  }
+
+  if ( m_iNumCand < m_iMaxCand )
+  {
+    m_acMv   [m_iNumCand].set( iHor, iVer );
+    m_auiCost[m_iNumCand] = uiCost;
+    xSiftUp( m_iNumCand++ );
+  }
+  else
+  {
+    m_acMv   [0].set( iHor, iVer );
+    m_auiCost[0] = uiCost;
+    xSiftDown( 0 );
+  }
+}
+
+/** Order the list by increasing cost, for the consumers. No vector can be inserted afterwards before clear()
+ */
+Void TComMvTopK::sort()
+{
+  for ( Int i = 1; i < m_iNumCand; i++ )
+  {
+    TComMv cMv    = m_acMv[i];
+    UInt   uiCost = m_auiCost[i];
+    Int    j      = i;
+    for ( ; j > 0 && m_auiCost[j - 1] > uiCost; j-- )
+    {
+      m_acMv   [j] = m_acMv   [j - 1];
+      m_auiCost[j] = m_auiCost[j - 1];
+    }
+    m_acMv   [j] = cMv;
+    m_auiCost[j] = uiCost;
+  }
+}
+
+Void TComMvTopK::xSiftUp( Int i )
+{
+  while ( i > 0 && m_auiCost[( i - 1 ) >> 1] < m_auiCost[i] )
+  {
+    Int iParent = ( i - 1 ) >> 1;
+    std::swap( m_acMv   [i], m_acMv   [iParent] );
+    std::swap( m_auiCost[i], m_auiCost[iParent] );
+    i = iParent;
+  }
+}
+
+Void TComMvTopK::xSiftDown( Int i )
+{
+  for ( ;; )
+  {
+    Int iLargest = i;
+    Int iLeft    = 2 * i + 1;
+    Int iRight   = iLeft + 1;
+    if ( iLeft  < m_iNumCand && m_auiCost[iLeft]  > m_auiCost[iLargest] ) iLargest = iLeft;
+    if ( iRight < m_iNumCand && m_auiCost[iRight] > m_auiCost[iLargest] ) iLargest = iRight;
+    if ( iLargest == i )
+    {
+      return;
+    }
+    std::swap( m_acMv   [i], m_acMv   [iLargest] );
+    std::swap( m_auiCost[i], m_auiCost[iLargest] );
+    i = iLargest;
+  }
+}
+#endif
 //! \}
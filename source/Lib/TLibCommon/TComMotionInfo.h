@@ -40,6 +40,7 @@
 #define __TCOMMOTIONINFO__
 
 #include <memory.h>
+#include <vector>
 #include "CommonDef.h"
 #include "TComMv.h"
 
@@ -159,6 +160,37 @@ public:
   Void compress(Char* pePredMode, Int scale); 
 };
 
+#if IT_SS_NUMBER_OF_BEST_CAND
+/// K best integer vectors of an SS search, used as seeds of the GT search
+class TComMvTopK
+{
+private:
+  std::vector<TComMv> m_acMv;       ///< max-heap on the cost: the worst kept vector first
+  std::vector<UInt>   m_auiCost;
+  Int                 m_iNumCand;
+  Int                 m_iMaxCand;
+  Int                 m_iMinDist;   ///< vectors closer than this in both components are merged
+
+  Void    xSiftUp     ( Int i );
+  Void    xSiftDown   ( Int i );
+
+public:
+  TComMvTopK() : m_iNumCand(0), m_iMaxCand(0), m_iMinDist(0) {}
+
+  Void    init        ( Int iMaxCand, Int iMinDist );
+  Void    clear       ()                    { m_iNumCand = 0; }
+  Void    insert      ( Int iHor, Int iVer, UInt uiCost );
+  Void    sort        ();
+
+  /// cost a vector must beat to enter the list
+  UInt    getWorstCost() const              { return m_iNumCand < m_iMaxCand ? MAX_UINT : m_auiCost[0]; }
+  Int     getNumCand  () const              { return m_iNumCand; }
+  Int     getMaxCand  () const              { return m_iMaxCand; }
+  TComMv const & getMv( Int i ) const       { return m_acMv[i]; }
+  UInt    getCost     ( Int i ) const       { return m_auiCost[i]; }
+};
+#endif
+
 //! \}
 
 #endif // __TCOMMOTIONINFO__
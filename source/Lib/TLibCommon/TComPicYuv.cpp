@@ -61,6 +61,9 @@ TComPicYuv::TComPicYuv()
   m_piPicOrgV       = NULL;
   
   m_bIsBorderExtended = false;
+#if IT_HOLOSS
+  m_piSSValidWidth  = NULL;
+#endif
 }
 
 TComPicYuv::~TComPicYuv()
@@ -116,6 +119,10 @@ Void TComPicYuv::create( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt
       m_buOffsetC[(buRow << uiMaxCUDepth) + buCol] = getCStride() * buRow * (uiMaxCUHeight / 2 >> uiMaxCUDepth) + buCol * (uiMaxCUWidth / 2 >> uiMaxCUDepth);
     }
   }
+#if IT_HOLOSS
+  m_piSSValidWidth  = new Int[m_iPicHeight];
+  resetSSValid();
+#endif
   return;
 }
 
@@ -133,6 +140,10 @@ Void TComPicYuv::destroy()
   delete[] m_cuOffsetC;
   delete[] m_buOffsetY;
   delete[] m_buOffsetC;
+#if IT_HOLOSS
+  delete[] m_piSSValidWidth;
+  m_piSSValidWidth = NULL;
+#endif
 }
 
 Void TComPicYuv::createLuma( Int iPicWidth, Int iPicHeight, UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxCUDepth )
@@ -204,6 +215,92 @@ Void  TComPicYuv::setPicPel (Pel  cPelValue)
   ::memset ( m_apiPicBufV, cPelValue, sizeof (Pel) * ((m_iPicWidth >> 1) + (m_iChromaMarginX << 1)) * ((m_iPicHeight >> 1) + (m_iChromaMarginY << 1)) );
   return;
 }
+
+/** Mark the whole SS reference as not reconstructed
+ */
+Void TComPicYuv::resetSSValid()
+{
+  ::memset( m_piSSValidWidth, 0, sizeof(Int) * m_iPicHeight );
+}
+
+/** Mark a reconstructed luma block of the SS reference
+ * \param iPelX   left position of the block
+ * \param iPelY   top position of the block
+ * \param iWidth  width of the block
+ * \param iHeight height of the block
+ *
+ * Blocks are reconstructed in coding order, so everything left of the block is already valid.
+ */
+Void TComPicYuv::setSSValid( Int iPelX, Int iPelY, Int iWidth, Int iHeight )
+{
+  Int iRight  = std::min( iPelX + iWidth,  m_iPicWidth  );
+  Int iBottom = std::min( iPelY + iHeight, m_iPicHeight );
+  for ( Int y = std::max( iPelY, 0 ); y < iBottom; y++ )
+  {
+    m_piSSValidWidth[y] = std::max( m_piSSValidWidth[y], iRight );
+  }
+}
+
+/** Check one luma sample of the SS reference, positions in the margin follow the nearest picture sample
+ * \param iPelX horizontal position
+ * \param iPelY vertical position
+ * \returns true when the sample is reconstructed
+ */
+Bool TComPicYuv::isSSValid( Int iPelX, Int iPelY )
+{
+  iPelX = Clip3( 0, m_iPicWidth  - 1, iPelX );
+  iPelY = Clip3( 0, m_iPicHeight - 1, iPelY );
+  return iPelX < m_piSSValidWidth[iPelY];
+}
+
+/** Check whether a block of the SS reference can be used for prediction, same test as TComRdCost::isValidPattern
+ * \param iPelX   left position of the block
+ * \param iPelY   top position of the block
+ * \param iWidth  width of the block
+ * \param iHeight height of the block
+ * \returns true when the bottom corners, including the half filter length, are reconstructed
+ */
+Bool TComPicYuv::isSSValidBlock( Int iPelX, Int iPelY, Int iWidth, Int iHeight )
+{
+  const Int iHalfFilterSize = 4;
+  return isSSValid( iPelX + iWidth + iHalfFilterSize, iPelY + iHeight + iHalfFilterSize );
+}
+
+/** Check whether a vector into the SS reference points to a reconstructed block
+ * \param iCuAddr        CU address of the current block
+ * \param uiAbsZorderIdx partition index of the current block
+ * \param cMv            vector, quarter-sample precision
+ * \param iWidth         width of the block
+ * \param iHeight        height of the block
+ */
+Bool TComPicYuv::isSSValidBlock( Int iCuAddr, Int uiAbsZorderIdx, TComMv cMv, Int iWidth, Int iHeight )
+{
+  Int iNumCuInWidth = m_iPicWidth / m_iCuWidth + (m_iPicWidth % m_iCuWidth != 0);
+  Int iPelX = ( iCuAddr % iNumCuInWidth ) * m_iCuWidth  + g_auiRasterToPelX[ g_auiZscanToRaster[uiAbsZorderIdx] ];
+  Int iPelY = ( iCuAddr / iNumCuInWidth ) * m_iCuHeight + g_auiRasterToPelY[ g_auiZscanToRaster[uiAbsZorderIdx] ];
+  return isSSValidBlock( iPelX + ( cMv.getHor() >> 2 ), iPelY + ( cMv.getVer() >> 2 ), iWidth, iHeight );
+}
+
+/** Right-most left position of a valid block in one row of the SS reference
+ * \param iPelY   top position of the block
+ * \param iWidth  width of the block
+ * \param iHeight height of the block
+ * \returns MAX_INT when the whole row is valid, -MAX_INT when no block is valid
+ */
+Int TComPicYuv::getSSValidRight( Int iPelY, Int iWidth, Int iHeight )
+{
+  const Int iHalfFilterSize = 4;
+  Int iValidWidth = m_piSSValidWidth[ Clip3( 0, m_iPicHeight - 1, iPelY + iHeight + iHalfFilterSize ) ];
+  if ( iValidWidth == m_iPicWidth )
+  {
+    return MAX_INT;
+  }
+  if ( iValidWidth == 0 )
+  {
+    return -MAX_INT;
+  }
+  return iValidWidth - 1 - iWidth - iHalfFilterSize;
+}
 #endif
 
 Void  TComPicYuv::copyToPicLuma (TComPicYuv*  pcPicYuvDst)
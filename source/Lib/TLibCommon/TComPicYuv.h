@@ -41,6 +41,9 @@
 #include <stdio.h>
 #include "CommonDef.h"
 #include "TComRom.h"
+#if IT_HOLOSS
+#include "TComMv.h"
+#endif
 
 //! \ingroup TLibCommon
 //! \{
@@ -86,6 +89,10 @@ private:
   Int   m_iChromaMarginY;
   
   Bool  m_bIsBorderExtended;
+
+#if IT_HOLOSS
+  Int*  m_piSSValidWidth;       ///< SS reference: number of reconstructed luma samples from the left edge, per row
+#endif
   
 protected:
   Void  xExtendPicCompBorder (Pel* piTxt, Int iStride, Int iWidth, Int iHeight, Int iMarginX, Int iMarginY);
@@ -147,6 +154,15 @@ public:
   Void  copyToPic       ( TComPicYuv*  pcPicYuvDst );
 #if IT_HOLOSS
   Void  setPicPel       ( Pel  cPelValue );
+
+  //  Causal area of the SS reference. Coding order makes the reconstructed part of every row a prefix,
+  //  so one width per row describes it; the margins follow the picture edge samples as after extendPicBorder().
+  Void  resetSSValid    ();
+  Void  setSSValid      ( Int iPelX, Int iPelY, Int iWidth, Int iHeight );
+  Bool  isSSValid       ( Int iPelX, Int iPelY );
+  Bool  isSSValidBlock  ( Int iPelX, Int iPelY, Int iWidth, Int iHeight );
+  Bool  isSSValidBlock  ( Int iCuAddr, Int uiAbsZorderIdx, TComMv cMv, Int iWidth, Int iHeight );
+  Int   getSSValidRight ( Int iPelY, Int iWidth, Int iHeight );
 #endif
   Void  copyToPicLuma   ( TComPicYuv*  pcPicYuvDst );
   Void  copyToPicCb     ( TComPicYuv*  pcPicYuvDst );
@@ -50,6 +50,18 @@ TComPrediction::TComPrediction()
 , m_iLumaRecStride(0)
 {
   m_piYuvExt = NULL;
+  xSelectIntraKernels();
+#if IT_GT && IT_GT_FIXED_POINT_WARP
+  initGTWarpRowKernels( m_fpGTWarpRow, m_fpGTWarpRowSAD );
+#endif
+#if IT_GT
+  m_iGTMaxIteration = IT_MAX_NSS_Iteration;
+  m_iGTInterpFilter = IT_GT_Interpolation_Filter;
+#if IT_GT_FIXED_POINT_WARP
+  xSelectGTKernels();
+  xInitGTDCTIFTaps();
+#endif
+#endif
 }
 
 TComPrediction::~TComPrediction()
@@ -110,6 +122,10 @@ Void TComPrediction::initTempBuff()
     m_acYuvPred[1] .create( MAX_CU_SIZE, MAX_CU_SIZE );
 
     m_cYuvPredTemp.create( MAX_CU_SIZE, MAX_CU_SIZE );
+#if IT_GT
+    // largest use: the 2x up-sampled luma block and its warp (5 blocks), plus the alignment of each buffer
+    m_cGTScratch.create( 6 * MAX_CU_SIZE * MAX_CU_SIZE * sizeof(Pel) );
+#endif
   }
 
   if (m_iLumaRecStride != (MAX_CU_SIZE>>1) + 1)
@@ -168,6 +184,357 @@ Pel TComPrediction::predIntraGetPredValDC( Int* pSrc, Int iSrcStride, UInt iWidt
   return pDcVal;
 }
 
+// ====================================================================================================================
+// Intra prediction kernels
+// ====================================================================================================================
+
+static Void xPredIntraAngC( const Pel* refMain, Pel* pDst, Int dstStride, Int blkSize, Int intraPredAngle )
+{
+  Int deltaPos=0;
+  Int deltaInt;
+  Int deltaFract;
+  Int refMainIndex;
+
+  for (Int k=0;k<blkSize;k++)
+  {
+    deltaPos += intraPredAngle;
+    deltaInt   = deltaPos >> 5;
+    deltaFract = deltaPos & (32 - 1);
+
+    if (deltaFract)
+    {
+      // Do linear filtering
+      for (Int l=0;l<blkSize;l++)
+      {
+        refMainIndex        = l+deltaInt+1;
+        pDst[k*dstStride+l] = (Pel) ( ((32-deltaFract)*refMain[refMainIndex]+deltaFract*refMain[refMainIndex+1]+16) >> 5 );
+      }
+    }
+    else
+    {
+      // Just copy the integer samples
+      for (Int l=0;l<blkSize;l++)
+      {
+        pDst[k*dstStride+l] = refMain[l+deltaInt+1];
+      }
+    }
+  }
+}
+
+static Void xPredIntraPlanarC( const Int* pSrc, Int srcStride, Pel* rpDst, Int dstStride, Int blkSize )
+{
+  Int k, l, bottomLeft, topRight;
+  Int horPred;
+  Int leftColumn[MAX_CU_SIZE+1], topRow[MAX_CU_SIZE+1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
+  UInt offset2D = blkSize;
+  UInt shift1D = g_aucConvertToBit[ blkSize ] + 2;
+  UInt shift2D = shift1D + 1;
+
+  // Get left and above reference column and row
+  for(k=0;k<blkSize+1;k++)
+  {
+    topRow[k] = pSrc[k-srcStride];
+    leftColumn[k] = pSrc[k*srcStride-1];
+  }
+
+  // Prepare intermediate variables used in interpolation
+  bottomLeft = leftColumn[blkSize];
+  topRight   = topRow[blkSize];
+  for (k=0;k<blkSize;k++)
+  {
+    bottomRow[k]   = bottomLeft - topRow[k];
+    rightColumn[k] = topRight   - leftColumn[k];
+    topRow[k]      <<= shift1D;
+    leftColumn[k]  <<= shift1D;
+  }
+
+  // Generate prediction signal
+  for (k=0;k<blkSize;k++)
+  {
+    horPred = leftColumn[k] + offset2D;
+    for (l=0;l<blkSize;l++)
+    {
+      horPred += rightColumn[k];
+      topRow[l] += bottomRow[l];
+      rpDst[k*dstStride+l] = ( (horPred + topRow[l]) >> shift2D );
+    }
+  }
+}
+
+static Void xPredIntraDCC( Pel dcVal, Pel* pDst, Int dstStride, Int blkSize )
+{
+  for (Int k=0;k<blkSize;k++)
+  {
+    for (Int l=0;l<blkSize;l++)
+    {
+      pDst[k*dstStride+l] = dcVal;
+    }
+  }
+}
+
+static Void xTransposePelC( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize )
+{
+  for (Int k=0;k<blkSize;k++)
+  {
+    for (Int l=0;l<blkSize;l++)
+    {
+      pDst[l*dstStride+k] = pSrc[k*srcStride+l];
+    }
+  }
+}
+
+#if SIMD_X86
+// The interpolations are computed on 32-bit sums, the planar prediction in its closed form
+//   ( (N-1-x)*left[y] + (x+1)*topRight + (N-1-y)*top[x] + (y+1)*bottomLeft + N ) >> (log2(N)+1)
+// which the C recursion accumulates, so the predictions are identical for all bit depths.
+
+/// ( (32-f)*a + f*b + 16 ) >> 5 of eight pairs of samples
+SIMD_TARGET_SSE41 static inline __m128i xIntraAngInterp8SSE41( __m128i vA, __m128i vB, __m128i vWeight )
+{
+  const __m128i vAdd = _mm_set1_epi32( 16 );
+  __m128i vLo = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpacklo_epi16( vA, vB ), vWeight ), vAdd ), 5 );
+  __m128i vHi = _mm_srai_epi32( _mm_add_epi32( _mm_madd_epi16( _mm_unpackhi_epi16( vA, vB ), vWeight ), vAdd ), 5 );
+  return _mm_packs_epi32( vLo, vHi );
+}
+
+SIMD_TARGET_SSE41 static Void xPredIntraAngSSE41( const Pel* refMain, Pel* pDst, Int dstStride, Int blkSize, Int intraPredAngle )
+{
+  Int deltaPos = 0;
+  for ( Int k = 0; k < blkSize; k++, pDst += dstStride )
+  {
+    deltaPos += intraPredAngle;
+    Int        deltaFract = deltaPos & (32 - 1);
+    const Pel* pRef       = refMain + ( deltaPos >> 5 ) + 1;
+    __m128i    vWeight    = _mm_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+
+    if ( blkSize == 4 )
+    {
+      __m128i vA = _mm_loadl_epi64( (const __m128i*)pRef );
+      if ( deltaFract )
+      {
+        vA = xIntraAngInterp8SSE41( vA, _mm_loadl_epi64( (const __m128i*)( pRef + 1 ) ), vWeight );
+      }
+      _mm_storel_epi64( (__m128i*)pDst, vA );
+      continue;
+    }
+    for ( Int l = 0; l < blkSize; l += 8 )
+    {
+      __m128i vA = _mm_loadu_si128( (const __m128i*)( pRef + l ) );
+      if ( deltaFract )
+      {
+        vA = xIntraAngInterp8SSE41( vA, _mm_loadu_si128( (const __m128i*)( pRef + l + 1 ) ), vWeight );
+      }
+      _mm_storeu_si128( (__m128i*)( pDst + l ), vA );
+    }
+  }
+}
+
+SIMD_TARGET_SSE41 static Void xPredIntraPlanarSSE41( const Int* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize )
+{
+  const Int     iShift     = g_aucConvertToBit[ blkSize ] + 3;
+  const Int     topRight   = pSrc[blkSize-srcStride];
+  const Int     bottomLeft = pSrc[blkSize*srcStride-1];
+  const __m128i vStep      = _mm_set1_epi32( 4 );
+  __m128i avVer  [ MAX_CU_SIZE / 4 ];   // (N-1-y)*top[x] + (y+1)*bottomLeft
+  __m128i avDelta[ MAX_CU_SIZE / 4 ];   // bottomLeft - top[x]
+
+  for ( Int l = 0; l < blkSize; l += 4 )
+  {
+    __m128i vTop = _mm_loadu_si128( (const __m128i*)( pSrc - srcStride + l ) );
+    avVer  [l/4] = _mm_slli_epi32( vTop, iShift - 1 );
+    avDelta[l/4] = _mm_sub_epi32( _mm_set1_epi32( bottomLeft ), vTop );
+  }
+  for ( Int k = 0; k < blkSize; k++, pDst += dstStride )
+  {
+    Int     left  = pSrc[k*srcStride-1];
+    __m128i vDiff = _mm_set1_epi32( topRight - left );
+    __m128i vHor  = _mm_add_epi32( _mm_set1_epi32( ( left << ( iShift - 1 ) ) + blkSize ), _mm_mullo_epi32( _mm_setr_epi32( 1, 2, 3, 4 ), vDiff ) );
+    __m128i vHorStep = _mm_mullo_epi32( vStep, vDiff );
+    for ( Int l = 0; l < blkSize; l += 8 )
+    {
+      avVer[l/4] = _mm_add_epi32( avVer[l/4], avDelta[l/4] );
+      __m128i vLo = _mm_srai_epi32( _mm_add_epi32( vHor, avVer[l/4] ), iShift );
+      vHor = _mm_add_epi32( vHor, vHorStep );
+      if ( blkSize == 4 )
+      {
+        _mm_storel_epi64( (__m128i*)pDst, _mm_packs_epi32( vLo, vLo ) );
+        break;
+      }
+      avVer[l/4+1] = _mm_add_epi32( avVer[l/4+1], avDelta[l/4+1] );
+      __m128i vHi = _mm_srai_epi32( _mm_add_epi32( vHor, avVer[l/4+1] ), iShift );
+      vHor = _mm_add_epi32( vHor, vHorStep );
+      _mm_storeu_si128( (__m128i*)( pDst + l ), _mm_packs_epi32( vLo, vHi ) );
+    }
+  }
+}
+
+SIMD_TARGET_SSE41 static Void xPredIntraDCSSE41( Pel dcVal, Pel* pDst, Int dstStride, Int blkSize )
+{
+  __m128i vDC = _mm_set1_epi16( dcVal );
+  for ( Int k = 0; k < blkSize; k++, pDst += dstStride )
+  {
+    if ( blkSize == 4 )
+    {
+      _mm_storel_epi64( (__m128i*)pDst, vDC );
+      continue;
+    }
+    for ( Int l = 0; l < blkSize; l += 8 )
+    {
+      _mm_storeu_si128( (__m128i*)( pDst + l ), vDC );
+    }
+  }
+}
+
+SIMD_TARGET_SSE41 static Void xTransposePelSSE41( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize )
+{
+  if ( blkSize == 4 )
+  {
+    __m128i v01 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( pSrc               ) ), _mm_loadl_epi64( (const __m128i*)( pSrc +   srcStride ) ) );
+    __m128i v23 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( pSrc + 2*srcStride ) ), _mm_loadl_epi64( (const __m128i*)( pSrc + 3*srcStride ) ) );
+    __m128i vLo = _mm_unpacklo_epi32( v01, v23 );
+    __m128i vHi = _mm_unpackhi_epi32( v01, v23 );
+    _mm_storel_epi64( (__m128i*)( pDst               ), vLo );
+    _mm_storel_epi64( (__m128i*)( pDst +   dstStride ), _mm_srli_si128( vLo, 8 ) );
+    _mm_storel_epi64( (__m128i*)( pDst + 2*dstStride ), vHi );
+    _mm_storel_epi64( (__m128i*)( pDst + 3*dstStride ), _mm_srli_si128( vHi, 8 ) );
+    return;
+  }
+  for ( Int y = 0; y < blkSize; y += 8 )
+  {
+    for ( Int x = 0; x < blkSize; x += 8 )
+    {
+      const Pel* pIn = pSrc + y * srcStride + x;
+      __m128i av[8], avTmp[8];
+      for ( Int k = 0; k < 8; k++ )
+      {
+        av[k] = _mm_loadu_si128( (const __m128i*)( pIn + k * srcStride ) );
+      }
+      for ( Int k = 0; k < 4; k++ )
+      {
+        avTmp[k  ] = _mm_unpacklo_epi16( av[2*k], av[2*k+1] );
+        avTmp[k+4] = _mm_unpackhi_epi16( av[2*k], av[2*k+1] );
+      }
+      for ( Int k = 0; k < 8; k += 4 )
+      {
+        av[k  ] = _mm_unpacklo_epi32( avTmp[k  ], avTmp[k+1] );
+        av[k+1] = _mm_unpackhi_epi32( avTmp[k  ], avTmp[k+1] );
+        av[k+2] = _mm_unpacklo_epi32( avTmp[k+2], avTmp[k+3] );
+        av[k+3] = _mm_unpackhi_epi32( avTmp[k+2], avTmp[k+3] );
+      }
+      // columns 0,1 of rows 0..3 in av[0] and of rows 4..7 in av[2], columns 2,3 in av[1] and av[3], 4..7 in av[4..7]
+      Pel* pOut = pDst + x * dstStride + y;
+      for ( Int k = 0; k < 4; k++ )
+      {
+        Int b = k < 2 ? k : k + 2;
+        _mm_storeu_si128( (__m128i*)( pOut + ( 2*k   ) * dstStride ), _mm_unpacklo_epi64( av[b], av[b+2] ) );
+        _mm_storeu_si128( (__m128i*)( pOut + ( 2*k+1 ) * dstStride ), _mm_unpackhi_epi64( av[b], av[b+2] ) );
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 static Void xPredIntraAngAVX2( const Pel* refMain, Pel* pDst, Int dstStride, Int blkSize, Int intraPredAngle )
+{
+  if ( blkSize < 16 )
+  {
+    xPredIntraAngSSE41( refMain, pDst, dstStride, blkSize, intraPredAngle );
+    return;
+  }
+  const __m256i vAdd = _mm256_set1_epi32( 16 );
+  Int deltaPos = 0;
+  for ( Int k = 0; k < blkSize; k++, pDst += dstStride )
+  {
+    deltaPos += intraPredAngle;
+    Int        deltaFract = deltaPos & (32 - 1);
+    const Pel* pRef       = refMain + ( deltaPos >> 5 ) + 1;
+    __m256i    vWeight    = _mm256_set1_epi32( ( deltaFract << 16 ) | ( 32 - deltaFract ) );
+
+    for ( Int l = 0; l < blkSize; l += 16 )
+    {
+      __m256i vA = _mm256_loadu_si256( (const __m256i*)( pRef + l ) );
+      if ( deltaFract )
+      {
+        // the unpacks and the pack work on 128-bit lanes, the order of the samples is kept
+        __m256i vB  = _mm256_loadu_si256( (const __m256i*)( pRef + l + 1 ) );
+        __m256i vLo = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpacklo_epi16( vA, vB ), vWeight ), vAdd ), 5 );
+        __m256i vHi = _mm256_srai_epi32( _mm256_add_epi32( _mm256_madd_epi16( _mm256_unpackhi_epi16( vA, vB ), vWeight ), vAdd ), 5 );
+        vA = _mm256_packs_epi32( vLo, vHi );
+      }
+      _mm256_storeu_si256( (__m256i*)( pDst + l ), vA );
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 static Void xPredIntraPlanarAVX2( const Int* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize )
+{
+  if ( blkSize < 16 )
+  {
+    xPredIntraPlanarSSE41( pSrc, srcStride, pDst, dstStride, blkSize );
+    return;
+  }
+  const Int     iShift     = g_aucConvertToBit[ blkSize ] + 3;
+  const Int     topRight   = pSrc[blkSize-srcStride];
+  const Int     bottomLeft = pSrc[blkSize*srcStride-1];
+  const __m256i vStep      = _mm256_set1_epi32( 8 );
+  __m256i avVer  [ MAX_CU_SIZE / 8 ];   // (N-1-y)*top[x] + (y+1)*bottomLeft
+  __m256i avDelta[ MAX_CU_SIZE / 8 ];   // bottomLeft - top[x]
+
+  for ( Int l = 0; l < blkSize; l += 8 )
+  {
+    __m256i vTop = _mm256_loadu_si256( (const __m256i*)( pSrc - srcStride + l ) );
+    avVer  [l/8] = _mm256_slli_epi32( vTop, iShift - 1 );
+    avDelta[l/8] = _mm256_sub_epi32( _mm256_set1_epi32( bottomLeft ), vTop );
+  }
+  for ( Int k = 0; k < blkSize; k++, pDst += dstStride )
+  {
+    Int     left  = pSrc[k*srcStride-1];
+    __m256i vDiff = _mm256_set1_epi32( topRight - left );
+    __m256i vHor  = _mm256_add_epi32( _mm256_set1_epi32( ( left << ( iShift - 1 ) ) + blkSize ), _mm256_mullo_epi32( _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ), vDiff ) );
+    __m256i vHorStep = _mm256_mullo_epi32( vStep, vDiff );
+    for ( Int l = 0; l < blkSize; l += 16 )
+    {
+      avVer[l/8  ] = _mm256_add_epi32( avVer[l/8  ], avDelta[l/8  ] );
+      avVer[l/8+1] = _mm256_add_epi32( avVer[l/8+1], avDelta[l/8+1] );
+      __m256i vLo = _mm256_srai_epi32( _mm256_add_epi32( vHor, avVer[l/8] ), iShift );
+      vHor = _mm256_add_epi32( vHor, vHorStep );
+      __m256i vHi = _mm256_srai_epi32( _mm256_add_epi32( vHor, avVer[l/8+1] ), iShift );
+      vHor = _mm256_add_epi32( vHor, vHorStep );
+      // the pack works on 128-bit lanes
+      _mm256_storeu_si256( (__m256i*)( pDst + l ), _mm256_permute4x64_epi64( _mm256_packs_epi32( vLo, vHi ), _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+    }
+  }
+}
+#endif
+
+/** Select the intra prediction kernels of the CPU
+ */
+Void TComPrediction::xSelectIntraKernels()
+{
+  m_fpPredIntraAng    = xPredIntraAngC;
+  m_fpPredIntraPlanar = xPredIntraPlanarC;
+  m_fpPredIntraDC     = xPredIntraDCC;
+  m_fpTransposePel    = xTransposePelC;
+#if SIMD_X86
+  switch ( getSimdLevel() )
+  {
+    case SIMD_AVX2:
+      m_fpPredIntraAng    = xPredIntraAngAVX2;
+      m_fpPredIntraPlanar = xPredIntraPlanarAVX2;
+      m_fpPredIntraDC     = xPredIntraDCSSE41;
+      m_fpTransposePel    = xTransposePelSSE41;
+      break;
+    case SIMD_SSE41:
+      m_fpPredIntraAng    = xPredIntraAngSSE41;
+      m_fpPredIntraPlanar = xPredIntraPlanarSSE41;
+      m_fpPredIntraDC     = xPredIntraDCSSE41;
+      m_fpTransposePel    = xTransposePelSSE41;
+      break;
+    default:
+      break;
+  }
+#endif
+}
+
 // Function for deriving the angular Intra predictions
 
 /** Function for deriving the simplified angular intra predictions.
@@ -191,7 +558,7 @@ Pel TComPrediction::predIntraGetPredValDC( Int* pSrc, Int iSrcStride, UInt iWidt
  */
 Void TComPrediction::xPredIntraAng(Int bitDepth, Int* pSrc, Int srcStride, Pel*& rpDst, Int dstStride, UInt width, UInt height, UInt dirMode, Bool blkAboveAvailable, Bool blkLeftAvailable, Bool bFilter )
 {
-  Int k,l;
+  Int k;
   Int blkSize        = width;
   Pel* pDst          = rpDst;
 
@@ -216,13 +583,7 @@ Void TComPrediction::xPredIntraAng(Int bitDepth, Int* pSrc, Int srcStride, Pel*&
   {
     Pel dcval = predIntraGetPredValDC(pSrc, srcStride, width, height, blkAboveAvailable, blkLeftAvailable);
 
-    for (k=0;k<blkSize;k++)
-    {
-      for (l=0;l<blkSize;l++)
-      {
-        pDst[k*dstStride+l] = dcval;
-      }
-    }
+    m_fpPredIntraDC( dcval, pDst, dstStride, blkSize );
   }
 
   // Do angular predictions
@@ -232,6 +593,11 @@ Void TComPrediction::xPredIntraAng(Int bitDepth, Int* pSrc, Int srcStride, Pel*&
     Pel* refSide;
     Pel  refAbove[2*MAX_CU_SIZE+1];
     Pel  refLeft[2*MAX_CU_SIZE+1];
+    Pel  predHor[MAX_CU_SIZE*MAX_CU_SIZE];
+
+    // The horizontal modes are predicted as vertical ones, then transposed
+    Pel* pRows      = modeHor ? predHor : pDst;
+    Int  rowsStride = modeHor ? blkSize : dstStride;
 
     // Initialise the Main and Left reference array.
     if (intraPredAngle < 0)
@@ -273,66 +639,26 @@ Void TComPrediction::xPredIntraAng(Int bitDepth, Int* pSrc, Int srcStride, Pel*&
     {
       for (k=0;k<blkSize;k++)
       {
-        for (l=0;l<blkSize;l++)
-        {
-          pDst[k*dstStride+l] = refMain[l+1];
-        }
+        ::memcpy( pRows + k*rowsStride, refMain + 1, blkSize * sizeof(Pel) );
       }
 
       if ( bFilter )
       {
         for (k=0;k<blkSize;k++)
         {
-          pDst[k*dstStride] = Clip3(0, (1<<bitDepth)-1, pDst[k*dstStride] + (( refSide[k+1] - refSide[0] ) >> 1) );
+          pRows[k*rowsStride] = Clip3(0, (1<<bitDepth)-1, pRows[k*rowsStride] + (( refSide[k+1] - refSide[0] ) >> 1) );
         }
       }
     }
     else
     {
-      Int deltaPos=0;
-      Int deltaInt;
-      Int deltaFract;
-      Int refMainIndex;
-
-      for (k=0;k<blkSize;k++)
-      {
-        deltaPos += intraPredAngle;
-        deltaInt   = deltaPos >> 5;
-        deltaFract = deltaPos & (32 - 1);
-
-        if (deltaFract)
-        {
-          // Do linear filtering
-          for (l=0;l<blkSize;l++)
-          {
-            refMainIndex        = l+deltaInt+1;
-            pDst[k*dstStride+l] = (Pel) ( ((32-deltaFract)*refMain[refMainIndex]+deltaFract*refMain[refMainIndex+1]+16) >> 5 );
-          }
-        }
-        else
-        {
-          // Just copy the integer samples
-          for (l=0;l<blkSize;l++)
-          {
-            pDst[k*dstStride+l] = refMain[l+deltaInt+1];
-          }
-        }
-      }
+      m_fpPredIntraAng( refMain, pRows, rowsStride, blkSize, intraPredAngle );
     }
 
     // Flip the block if this is the horizontal mode
     if (modeHor)
     {
-      Pel  tmp;
-      for (k=0;k<blkSize-1;k++)
-      {
-        for (l=k+1;l<blkSize;l++)
-        {
-          tmp                 = pDst[k*dstStride+l];
-          pDst[k*dstStride+l] = pDst[l*dstStride+k];
-          pDst[l*dstStride+k] = tmp;
-        }
-      }
+      m_fpTransposePel( predHor, blkSize, pDst, dstStride, blkSize );
     }
   }
 }
@@ -679,6 +1005,23 @@ Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt
 
 #if IT_GT
 	}else{
+#if IT_GT_WARP_CACHE
+		GTWarpCacheKey cCacheKey;
+		if ( m_cGTWarpCache.isActive() )
+		{
+			xGetGTWarpCacheKey( cu, refPic, partAddr, mv, width, height, bi, mGT0, mGT1, mGT2, mGT3, cCacheKey );
+			const Pel* piCached = m_cGTWarpCache.find( cCacheKey, 0 );
+			if ( piCached )
+			{
+				Pel* piDst = dstPic->getLumaAddr( partAddr );
+				for ( Int y = 0; y < height; y++, piCached += width, piDst += dstPic->getStride() )
+				{
+					::memcpy( piDst, piCached, width * sizeof(Pel) );
+				}
+				return;
+			}
+		}
+#endif
 		Int refStride = refPic->getStride();
 		Int refOffset = ( mv->getHor() >> 2 ) - width / 2 + (( mv->getVer() >> 2 ) - height / 2) * refStride;
 		Pel *ref      = refPic->getLumaAddr( cu->getAddr(), cu->getZorderIdxInCU() + partAddr ) + refOffset;
@@ -688,8 +1031,8 @@ Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt
 		Pel* piRefYorig = ref;
 		Int xFrac = mv->getHor() & 0x3;
 		Int yFrac = mv->getVer() & 0x3;
-		Pel *dst1Org = (Pel*)xMalloc(Pel, (width * height * 4));
-		Pel *dst1 = dst1Org;
+		UInt uiScratchMark = m_cGTScratch.getMark();
+		Pel *dst1 = m_cGTScratch.alloc<Pel>( width * height * 4 );
 		Int dst1Stride = width * 2;
 
 		if ( yFrac == 0 )
@@ -714,23 +1057,64 @@ Void TComPrediction::xPredInterLumaBlk( TComDataCU *cu, TComPicYuv *refPic, UInt
 
 		xPredGTLuma(piDstYorig, dst1, height, width, mGT0, mGT1, mGT2, mGT3, dstStride, dst1Stride);
 
-		xFree(dst1Org);
+		m_cGTScratch.release( uiScratchMark );
+#if IT_GT_WARP_CACHE
+		if ( m_cGTWarpCache.isActive() )
+		{
+			Pel* piCache = m_cGTWarpCache.store( cCacheKey, 0 );
+			for ( Int y = 0; y < height; y++, piCache += width, piDstYorig += dstStride )
+			{
+				::memcpy( piCache, piDstYorig, width * sizeof(Pel) );
+			}
+		}
+#endif
 	}
 #endif
 }
 
 #if IT_GT
+#if IT_GT_WARP_CACHE
+/** Derive the key of the GT prediction cache for the motion of a PU
+ */
+Void TComPrediction::xGetGTWarpCacheKey( TComDataCU* cu, TComPicYuv* refPic, UInt partAddr, TComMv* mv, Int width, Int height, Bool bi, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, GTWarpCacheKey& rcKey )
+{
+  rcKey.pcRefPic     = refPic;
+  rcKey.iCUAddr      = cu->getAddr();
+  rcKey.uiAbsPartIdx = cu->getZorderIdxInCU() + partAddr;
+  rcKey.iWidth       = width;
+  rcKey.iHeight      = height;
+  rcKey.bBi          = bi;
+  rcKey.acMv[0]      = *mv;
+  rcKey.acMv[1]      = *mGT0;
+  rcKey.acMv[2]      = *mGT1;
+  rcKey.acMv[3]      = *mGT2;
+  rcKey.acMv[4]      = *mGT3;
+}
+
+#endif
+/** Select the GT tools of a slice, the warp kernels are specialised for its interpolation filter
+ * \param pcSlice slice whose GT tools are used
+ */
+Void TComPrediction::setGTTools( TComSlice* pcSlice )
+{
+  m_iGTMaxIteration = pcSlice->getGTMaxIteration();
+  m_iGTInterpFilter = pcSlice->getGTInterpFilter();
+#if IT_GT_FIXED_POINT_WARP
+  xSelectGTKernels();
+#endif
+}
+
 Void TComPrediction::xPredGTLuma(Pel* dst, Pel* dst1, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride)
 {
 	Int iCurrCornerX[4], iCurrCornerY[4];
-	Double dProjective[9];
-	Pel* piAuxOrg = (Pel*)xMalloc(Pel, (width * height));
-	Pel* piAux = piAuxOrg;;
+	GTWarpParam dProjective;
+	UInt uiScratchMark = m_cGTScratch.getMark();
+	Pel* piAux = m_cGTScratch.alloc<Pel>( width * height );
 	Int iNSSWindow = ((height < width) ? (height) : (width)) >> 1;
 #if IT_GT_GRID_SIZE > 1
 	iNSSWindow *= IT_GT_GRID_SIZE;
 #endif
-	Int iMaxNSSIteration = IT_MAX_NSS_Iteration;
+	Int iMaxNSSIteration = m_iGTMaxIteration;
 #if IT_GT_Iteration_Limit
 	iMaxNSSIteration = log2((double)(iNSSWindow/IT_GT_GRID_SIZE));
 #endif
@@ -801,11 +1185,512 @@ Void TComPrediction::xPredGTLuma(Pel* dst, Pel* dst1, Int height, Int width, TCo
 		dst += dstStride;
 		piAux += width;
 	}
-	xFree(piAuxOrg);
+	m_cGTScratch.release( uiScratchMark );
+}
+
+#if IT_GT_FIXED_POINT_WARP
+/** Rounded integer division (positive denominator)
+ */
+static inline Int64 xGTRoundDiv( Int64 iNum, Int64 iDen )
+{
+  return ( iNum >= 0 ) ? ( iNum + ( iDen >> 1 ) ) / iDen : -( ( -iNum + ( iDen >> 1 ) ) / iDen );
+}
+
+/** Floor of the integer division (positive denominator)
+ */
+static inline Int64 xGTFloorDiv( Int64 iNum, Int64 iDen )
+{
+  return ( iNum >= 0 ) ? iNum / iDen : -( ( -iNum + iDen - 1 ) / iDen );
+}
+
+/** Derive the projective transform that maps the grid corners to (x[k], y[k])
+ * \param x            horizontal corner positions (top-left, top-right, bottom-right, bottom-left)
+ * \param y            vertical corner positions
+ * \param h            derived transform, Fx = (h0*x + h3*y + h6) / (h2*x + h5*y + h8) and Fy = (h1*x + h4*y + h7) / (h2*x + h5*y + h8)
+ * \param Width        width of the transformed grid
+ * \param Height       height of the transformed grid
+ * \param iCornerShift corners are given in units of 1/(1<<iCornerShift) samples
+ *
+ * The coefficients of the double precision solution are scaled by their common denominator, so that the transform is exact in integers.
+ */
+Void TComPrediction::calcParamProjective(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height, Int iCornerShift)
+{
+  Int64 W = Width - 1;
+  Int64 H = Height - 1;
+  Int64 deltax[4], deltay[4];
+  Int64* c = h.iCoef;
+
+  deltax[1] = x[1] - x[2];
+  deltax[2] = x[3] - x[2];
+  deltax[3] = x[0] - x[1] + x[2] - x[3];
+  deltay[1] = y[1] - y[2];
+  deltay[2] = y[3] - y[2];
+  deltay[3] = y[0] - y[1] + y[2] - y[3];
+
+  Int64 iDet = deltax[1] * deltay[2] - deltax[2] * deltay[1];
+
+  h.iCornerShift = iCornerShift;
+  h.iMaxVal = ( 1 << g_bitDepthY ) - 1;
+  if ( iDet == 0 )
+  {
+    // degenerated corners: keep the grid untouched
+    for ( Int k = 0; k < 9; k++ )
+    {
+      c[k] = 0;
+    }
+    c[0] = c[4] = c[8] = 1;
+    h.iCornerShift = 0;
+    h.bAffine = true;
+    h.bBilinear = false;
+    return;
+  }
+
+  c[2] = ( deltax[3] * deltay[2] - deltax[2] * deltay[3] ) * H;
+  c[5] = ( deltax[1] * deltay[3] - deltax[3] * deltay[1] ) * W;
+
+  c[0] = ( x[1] - x[0] ) * iDet * H + c[2] * x[1];
+  c[3] = ( x[3] - x[0] ) * iDet * W + c[5] * x[3];
+  c[6] = x[0] * iDet * W * H;
+  c[1] = ( y[1] - y[0] ) * iDet * H + c[2] * y[1];
+  c[4] = ( y[3] - y[0] ) * iDet * W + c[5] * y[3];
+  c[7] = y[0] * iDet * W * H;
+
+  c[8] = iDet * W * H;
+
+  if ( iDet < 0 )
+  {
+    for ( Int k = 0; k < 9; k++ )
+    {
+      c[k] = -c[k];
+    }
+  }
+  h.bAffine = ( c[2] == 0 && c[5] == 0 );
+  h.bBilinear = false;
+}
+
+/** Derive the bilinear transform that maps the grid corners to (x[k], y[k])
+ * \param x            horizontal corner positions (top-left, top-right, bottom-right, bottom-left)
+ * \param y            vertical corner positions
+ * \param h            derived transform, Fx = (h0 + h1*x + h2*y + h3*x*y) / h8 and Fy = (h4 + h5*x + h6*y + h7*x*y) / h8
+ * \param Width        width of the transformed grid
+ * \param Height       height of the transformed grid
+ * \param iCornerShift corners are given in units of 1/(1<<iCornerShift) samples
+ */
+Void TComPrediction::calcParamBilinear(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height, Int iCornerShift)
+{
+  Int64 W = Width - 1;
+  Int64 H = Height - 1;
+  Int64* c = h.iCoef;
+
+  c[0] = x[0] * W * H;
+  c[1] = ( x[1] - x[0] ) * W;
+  c[2] = ( x[3] - x[0] ) * H;
+  c[3] = x[2] - x[3] - x[1] + x[0];
+
+  c[4] = y[0] * W * H;
+  c[5] = ( y[1] - y[0] ) * W;
+  c[6] = ( y[3] - y[0] ) * H;
+  c[7] = y[2] - y[3] - y[1] + y[0];
+
+  c[8] = W * H;
+
+  h.iCornerShift = iCornerShift;
+  h.iMaxVal = ( 1 << g_bitDepthY ) - 1;
+  h.bAffine = ( c[3] == 0 && c[7] == 0 );
+  h.bBilinear = true;
+}
+
+/** Tell whether the transform derived from the corners (x[k], y[k]) is affine, without deriving it
+ * \param x         horizontal corner positions (top-left, top-right, bottom-right, bottom-left)
+ * \param y         vertical corner positions
+ * \param bBilinear bAffine of calcParamBilinear instead of calcParamProjective
+ *
+ * The corners of an affine transform form a parallelogram. calcParamProjective also keeps the grid untouched for degenerated corners.
+ */
+Bool TComPrediction::isGTAffineCorners(const Int x[4], const Int y[4], Bool bBilinear)
+{
+  if ( x[0] - x[1] + x[2] - x[3] == 0 && y[0] - y[1] + y[2] - y[3] == 0 )
+  {
+    return true;
+  }
+  return !bBilinear && (Int64)( x[1] - x[2] ) * ( y[3] - y[2] ) == (Int64)( x[3] - x[2] ) * ( y[1] - y[2] );
+}
+
+/** Interpolate one warped sample
+ * \param piRefY     pointer to the top-left sample of the block in the (extended) reference
+ * \param iStrideCur stride of the reference
+ * \param iPosX      horizontal position on the transformed grid, in units of 1/(1<<IT_GT_WARP_POS_BITS) samples
+ * \param iPosY      vertical position on the transformed grid, in units of 1/(1<<IT_GT_WARP_POS_BITS) samples
+ * \param offsetX    horizontal position of the block inside the transformed grid
+ * \param offsetY    vertical position of the block inside the transformed grid
+ * \param iMinPos    first reference sample available around the block
+ * \param iMaxPosX   last reference column available around the block
+ * \param iMaxPosY   last reference row available around the block
+ * \param iMaxVal    largest value of the warped samples, (1<<bitDepth)-1
+ */
+template <Int iFilter>
+inline Pel TComPrediction::xGTInterpolate(Pel* piRefY, Int iStrideCur, Int iPosX, Int iPosY, Int offsetX, Int offsetY, Int iMinPos, Int iMaxPosX, Int iMaxPosY, Int iMaxVal, Int W, Int H, Int iNSSWindow)
+{
+  if ( iFilter == 0 )
+  {
+    return interpolateGTBilinear( piRefY, iStrideCur, iPosX, iPosY, offsetX, offsetY, iMinPos, iMaxPosX, iMaxPosY, iMaxVal );
+  }
+
+  const Int iOne = 1 << IT_GT_WARP_FRAC_BITS;
+  Int X = ( iPosX >> IT_GT_WARP_POS_BITS ) - offsetX;
+  Int Y = ( iPosY >> IT_GT_WARP_POS_BITS ) - offsetY;
+  Int p = ( iPosX >> ( IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ) ) & ( iOne - 1 );
+  Int q = ( iPosY >> ( IT_GT_WARP_POS_BITS - IT_GT_WARP_FRAC_BITS ) ) & ( iOne - 1 );
+
+  // the window clamps the integer position only, the interpolation weights are kept
+  if ( Y < iMinPos )
+    Y = iMinPos;
+  if ( X < iMinPos )
+    X = iMinPos;
+  if ( Y > iMaxPosY - 1 )
+    Y = iMaxPosY - 1;
+  if ( X > iMaxPosX - 1 )
+    X = iMaxPosX - 1;
+
+  if ( iFilter == 1 )
+  {
+    Pel* paux = piRefY + Y * iStrideCur;
+    if ( q >= ( iOne >> 1 ) )
+    {
+      paux += iStrideCur;
+    }
+    return ( p >= ( iOne >> 1 ) ) ? paux[X + 1] : paux[X];
+  }
+
+  // separable DCT-IF, the taps of the quantised phases are read from s_aiGTDCTIFTaps
+  const Int    M      = IT_GT_Interpolation_Filter_order / 2;
+  const Short* piTapX = s_aiGTDCTIFTaps[p >> ( IT_GT_WARP_FRAC_BITS - IT_GT_DCTIF_PHASE_BITS )];
+  const Short* piTapY = s_aiGTDCTIFTaps[q >> ( IT_GT_WARP_FRAC_BITS - IT_GT_DCTIF_PHASE_BITS )];
+  Int iSum = 0;
+  for ( Int m = 1 - M; m <= M; m++ )
+  {
+    const Pel* paux = piRefY + Clip3( iMinPos, iMaxPosY, Y + m ) * iStrideCur;
+    Int iRow = 0;
+    for ( Int k = 1 - M; k <= M; k++ )
+    {
+      iRow += piTapX[k - (1 - M)] * paux[Clip3( iMinPos, iMaxPosX, X + k )];
+    }
+    iSum += piTapY[m - (1 - M)] * iRow;
+  }
+  iSum = ( iSum + ( 1 << ( 2 * IT_GT_DCTIF_COEF_BITS - 1 ) ) ) >> ( 2 * IT_GT_DCTIF_COEF_BITS );
+  return (Pel)Clip3( 0, iMaxVal, iSum );
+}
+
+/** Derive the rows of a linear warp, i.e. of an affine projective transform or of a bilinear transform
+ * \param h          transform derived by calcParamProjective or calcParamBilinear
+ * \param piRefY     pointer to the top-left sample of the block in the (extended) reference
+ * \param W          width of the transformed grid
+ * \param H          height of the transformed grid
+ * \param iStrideCur stride of the reference
+ * \param iNSSWindow reference margin around the block on the transformed grid
+ * \param pcRows     derived rows of the block, indexed by the row of the block
+ * \param iRowBegin  first row to derive
+ * \param iRowEnd    row after the last one to derive, limited to the height of the block
+ * \returns false for a projective transform with perspective, whose rows are not linear
+ */
+Bool TComPrediction::xGTLinearRows(GTWarpParam& h, Pel* piRefY, Int W, Int H, Int iStrideCur, Int iNSSWindow, GTWarpRow* pcRows, Int iRowBegin, Int iRowEnd)
+{
+  if ( !h.bBilinear && !h.bAffine )
+  {
+    return false;
+  }
+
+  GTWarpRow    cRow;
+  const Int    iBlkH  = H / IT_GT_GRID_SIZE;
+  const Int64  iScale = (Int64)1 << ( IT_GT_WARP_POS_BITS - h.iCornerShift );
+  const Int64* c      = h.iCoef;
+
+  assert( iBlkH <= MAX_CU_SIZE );
+  cRow.piRefY     = piRefY;
+  cRow.iStrideCur = iStrideCur;
+  cRow.iWidth     = W / IT_GT_GRID_SIZE;
+  cRow.offsetX    = W/2 - (cRow.iWidth / 2);
+  cRow.offsetY    = H/2 - (iBlkH / 2);
+  cRow.iMinPos    = -iNSSWindow/IT_GT_GRID_SIZE;
+  cRow.iMaxPosX   = iNSSWindow/IT_GT_GRID_SIZE + cRow.iWidth - 1;
+  cRow.iMaxPosY   = iNSSWindow/IT_GT_GRID_SIZE + iBlkH - 1;
+  cRow.iMaxVal    = h.iMaxVal;
+  iRowEnd         = std::min( iRowEnd, iBlkH );
+
+  if ( h.bBilinear )
+  {
+    for ( Int y = iRowBegin; y < iRowEnd; y++ )
+    {
+      // the transform is linear along each row
+      Int64 iGridY = y + cRow.offsetY;
+      Int64 iSlopeX = c[1] + c[3] * iGridY;
+      Int64 iSlopeY = c[5] + c[7] * iGridY;
+      cRow.iPosX  = (Int)xGTRoundDiv( ( c[0] + c[2] * iGridY + iSlopeX * cRow.offsetX ) * iScale, c[8] );
+      cRow.iPosY  = (Int)xGTRoundDiv( ( c[4] + c[6] * iGridY + iSlopeY * cRow.offsetX ) * iScale, c[8] );
+      cRow.iStepX = (Int)xGTRoundDiv( iSlopeX * iScale, c[8] );
+      cRow.iStepY = (Int)xGTRoundDiv( iSlopeY * iScale, c[8] );
+      pcRows[y] = cRow;
+    }
+  }
+  else
+  {
+    Int iStepXy = (Int)xGTRoundDiv( c[3] * iScale, c[8] );
+    Int iStepYy = (Int)xGTRoundDiv( c[4] * iScale, c[8] );
+    cRow.iStepX = (Int)xGTRoundDiv( c[0] * iScale, c[8] );
+    cRow.iStepY = (Int)xGTRoundDiv( c[1] * iScale, c[8] );
+    cRow.iPosX  = (Int)xGTRoundDiv( ( c[0] * cRow.offsetX + c[3] * cRow.offsetY + c[6] ) * iScale, c[8] ) + iRowBegin * iStepXy;
+    cRow.iPosY  = (Int)xGTRoundDiv( ( c[1] * cRow.offsetX + c[4] * cRow.offsetY + c[7] ) * iScale, c[8] ) + iRowBegin * iStepYy;
+    for ( Int y = iRowBegin; y < iRowEnd; y++ )
+    {
+      pcRows[y] = cRow;
+      cRow.iPosX += iStepXy;
+      cRow.iPosY += iStepYy;
+    }
+  }
+  return true;
+}
+
+/** Warp one row of a linear warp
+ */
+template <Int iFilter>
+Void TComPrediction::xGTWarpRow(const GTWarpRow& rcRow, Pel* piDst, Int W, Int H, Int iNSSWindow)
+{
+  if ( iFilter == 0 )
+  {
+    m_fpGTWarpRow( rcRow, piDst );
+    return;
+  }
+
+  Int iPosX = rcRow.iPosX;
+  Int iPosY = rcRow.iPosY;
+  for ( Int x = 0; x < rcRow.iWidth; x++ )
+  {
+    piDst[x] = xGTInterpolate<iFilter>( rcRow.piRefY, rcRow.iStrideCur, iPosX, iPosY, rcRow.offsetX, rcRow.offsetY, rcRow.iMinPos, rcRow.iMaxPosX, rcRow.iMaxPosY, rcRow.iMaxVal, W, H, iNSSWindow );
+    iPosX += rcRow.iStepX;
+    iPosY += rcRow.iStepY;
+  }
 }
 
-Void TComPrediction::calcParamProjective(Int x[4], Int y[4], Double h[9], Int Width, Int Height)
+/** Warp a block with the projective transform h
+ * \param piRefY     pointer to the top-left sample of the block in the (extended) reference
+ * \param piAux      destination, the block is written contiguously (stride W/IT_GT_GRID_SIZE)
+ * \param h          transform derived by calcParamProjective
+ * \param W          width of the transformed grid
+ * \param H          height of the transformed grid
+ * \param iStrideCur stride of the reference
+ * \param iNSSWindow reference margin around the block on the transformed grid
+ * \param iRowBegin  first row of the block to warp
+ * \param iRowEnd    row after the last one to warp
+ *
+ * Affine transforms step the fixed-point positions along rows and columns, projective ones step the
+ * exact numerators and denominator and need one division per coordinate.
+ */
+template <Int iFilter>
+Void TComPrediction::xProjectiveTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, Int iRowBegin, Int iRowEnd)
 {
+  const Int    iBlkW    = W / IT_GT_GRID_SIZE;
+  const Int    iBlkH    = H / IT_GT_GRID_SIZE;
+  GTWarpRow    acRows[MAX_CU_SIZE];
+
+  piAux += iRowBegin * iBlkW;
+  if ( xGTLinearRows( h, piRefY, W, H, iStrideCur, iNSSWindow, acRows, iRowBegin, iRowEnd ) )
+  {
+    for ( Int y = iRowBegin; y < iRowEnd; y++ )
+    {
+      xGTWarpRow<iFilter>( acRows[y], piAux, W, H, iNSSWindow );
+      piAux += iBlkW;
+    }
+  }
+  else
+  {
+    const Int    offsetX  = W/2 - (iBlkW / 2);
+    const Int    offsetY  = H/2 - (iBlkH / 2);
+    const Int    iMinPos  = -iNSSWindow/IT_GT_GRID_SIZE;
+    const Int    iMaxPosX = iNSSWindow/IT_GT_GRID_SIZE + iBlkW - 1;
+    const Int    iMaxPosY = iNSSWindow/IT_GT_GRID_SIZE + iBlkH - 1;
+    const Int64  iScale   = (Int64)1 << ( IT_GT_WARP_POS_BITS - h.iCornerShift );
+    const Int64* c        = h.iCoef;
+    const Int64 iLowX  = (Int64)( offsetX + iMinPos - 1 ) << IT_GT_WARP_POS_BITS;
+    const Int64 iHighX = (Int64)( offsetX + iMaxPosX + 1 ) << IT_GT_WARP_POS_BITS;
+    const Int64 iLowY  = (Int64)( offsetY + iMinPos - 1 ) << IT_GT_WARP_POS_BITS;
+    const Int64 iHighY = (Int64)( offsetY + iMaxPosY + 1 ) << IT_GT_WARP_POS_BITS;
+    Int64 iRowNumX = c[0] * offsetX + c[3] * ( offsetY + iRowBegin ) + c[6];
+    Int64 iRowNumY = c[1] * offsetX + c[4] * ( offsetY + iRowBegin ) + c[7];
+    Int64 iRowDen  = c[2] * offsetX + c[5] * ( offsetY + iRowBegin ) + c[8];
+
+    for ( Int y = iRowBegin; y < iRowEnd; y++ )
+    {
+      Int64 iNumX = iRowNumX;
+      Int64 iNumY = iRowNumY;
+      Int64 iDen  = iRowDen;
+      for ( Int x = 0; x < iBlkW; x++ )
+      {
+        Int64 iPosX = iLowX;
+        Int64 iPosY = iLowY;
+        if ( iDen > 0 )
+        {
+          iPosX = Clip3( iLowX, iHighX, xGTFloorDiv( iNumX * iScale, iDen ) );
+          iPosY = Clip3( iLowY, iHighY, xGTFloorDiv( iNumY * iScale, iDen ) );
+        }
+        piAux[x] = xGTInterpolate<iFilter>( piRefY, iStrideCur, (Int)iPosX, (Int)iPosY, offsetX, offsetY, iMinPos, iMaxPosX, iMaxPosY, h.iMaxVal, W, H, iNSSWindow );
+        iNumX += c[0];
+        iNumY += c[1];
+        iDen  += c[2];
+      }
+      iRowNumX += c[3];
+      iRowNumY += c[4];
+      iRowDen  += c[5];
+      piAux += iBlkW;
+    }
+  }
+}
+
+/** Warp a block with the bilinear transform h
+ * \param piRefY     pointer to the top-left sample of the block in the (extended) reference
+ * \param piAux      destination, the block is written contiguously (stride W/IT_GT_GRID_SIZE)
+ * \param h          transform derived by calcParamBilinear
+ * \param W          width of the transformed grid
+ * \param H          height of the transformed grid
+ * \param iStrideCur stride of the reference
+ * \param iNSSWindow reference margin around the block on the transformed grid
+ * \param iRowBegin  first row of the block to warp
+ * \param iRowEnd    row after the last one to warp
+ */
+template <Int iFilter>
+Void TComPrediction::xBilinearTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, Int iRowBegin, Int iRowEnd)
+{
+  const Int    iBlkW    = W / IT_GT_GRID_SIZE;
+  GTWarpRow    acRows[MAX_CU_SIZE];
+
+  piAux += iRowBegin * iBlkW;
+  xGTLinearRows( h, piRefY, W, H, iStrideCur, iNSSWindow, acRows, iRowBegin, iRowEnd );
+  for ( Int y = iRowBegin; y < iRowEnd; y++ )
+  {
+    xGTWarpRow<iFilter>( acRows[y], piAux, W, H, iNSSWindow );
+    piAux += iBlkW;
+  }
+}
+
+#if IT_GT_UV
+/** Warp the Cb and Cr blocks of a PU with the same transform, straight into the prediction
+ * \param piRefCb    pointer to the top-left sample of the Cb block in the (extended) reference
+ * \param piRefCr    pointer to the top-left sample of the Cr block in the (extended) reference
+ * \param iStrideCur stride of both references
+ * \param h          transform derived by calcParamProjective or calcParamBilinear
+ * \param W          width of the transformed grid
+ * \param H          height of the transformed grid
+ * \param iNSSWindow reference margin around the block on the transformed grid
+ * \param piDstCb    destination of the Cb block
+ * \param piDstCr    destination of the Cr block
+ * \param iDstStride stride of both destinations
+ *
+ * The rows of a linear warp are derived once, the Cr rows only differ by their reference.
+ */
+template <Int iFilter>
+Void TComPrediction::xGTWarpChroma(Pel* piRefCb, Pel* piRefCr, Int iStrideCur, GTWarpParam& h, Int W, Int H, Int iNSSWindow, Pel* piDstCb, Pel* piDstCr, Int iDstStride)
+{
+  const Int    iBlkW    = W / IT_GT_GRID_SIZE;
+  const Int    iBlkH    = H / IT_GT_GRID_SIZE;
+  GTWarpRow    acRows[MAX_CU_SIZE];
+
+  if ( xGTLinearRows( h, piRefCb, W, H, iStrideCur, iNSSWindow, acRows ) )
+  {
+    for ( Int y = 0; y < iBlkH; y++ )
+    {
+      xGTWarpRow<iFilter>( acRows[y], piDstCb, W, H, iNSSWindow );
+      acRows[y].piRefY = piRefCr;
+      xGTWarpRow<iFilter>( acRows[y], piDstCr, W, H, iNSSWindow );
+      piDstCb += iDstStride;
+      piDstCr += iDstStride;
+    }
+    return;
+  }
+
+  // perspective: the samples are warped one by one into a contiguous block
+  UInt uiScratchMark = m_cGTScratch.getMark();
+  Pel* piAux = m_cGTScratch.alloc<Pel>( iBlkW * iBlkH );
+  Pel* apiRef[2] = { piRefCb, piRefCr };
+  Pel* apiDst[2] = { piDstCb, piDstCr };
+  for ( Int iComp = 0; iComp < 2; iComp++ )
+  {
+    xProjectiveTransform<iFilter>( apiRef[iComp], piAux, h, W, H, iStrideCur, iNSSWindow, 0, iBlkH );
+    for ( Int y = 0; y < iBlkH; y++ )
+    {
+      ::memcpy( apiDst[iComp] + y * iDstStride, piAux + y * iBlkW, iBlkW * sizeof(Pel) );
+    }
+  }
+  m_cGTScratch.release( uiScratchMark );
+}
+
+#endif
+/** Select the warp kernels specialised for the interpolation filter #m_iGTInterpFilter
+ */
+Void TComPrediction::xSelectGTKernels()
+{
+  switch ( m_iGTInterpFilter )
+  {
+  case 1:
+    m_pfGTProjective = &TComPrediction::xProjectiveTransform<1>;
+    m_pfGTBilinear   = &TComPrediction::xBilinearTransform<1>;
+#if IT_GT_UV
+    m_pfGTChroma     = &TComPrediction::xGTWarpChroma<1>;
+#endif
+    break;
+  case 2:
+    m_pfGTProjective = &TComPrediction::xProjectiveTransform<2>;
+    m_pfGTBilinear   = &TComPrediction::xBilinearTransform<2>;
+#if IT_GT_UV
+    m_pfGTChroma     = &TComPrediction::xGTWarpChroma<2>;
+#endif
+    break;
+  default:
+    m_pfGTProjective = &TComPrediction::xProjectiveTransform<0>;
+    m_pfGTBilinear   = &TComPrediction::xBilinearTransform<0>;
+#if IT_GT_UV
+    m_pfGTChroma     = &TComPrediction::xGTWarpChroma<0>;
+#endif
+    break;
+  }
+}
+
+Short TComPrediction::s_aiGTDCTIFTaps[1 << IT_GT_DCTIF_PHASE_BITS][IT_GT_Interpolation_Filter_order];
+Bool  TComPrediction::s_bGTDCTIFTapsInit = false;
+
+/** Design the DCT-IF of each quantised phase once and round its taps to IT_GT_DCTIF_COEF_BITS fractional bits
+ */
+Void TComPrediction::xInitGTDCTIFTaps()
+{
+  if ( s_bGTDCTIFTapsInit )
+  {
+    return;
+  }
+  const Int iPhases = 1 << IT_GT_DCTIF_PHASE_BITS;
+  const Int iUnit   = 1 << IT_GT_DCTIF_COEF_BITS;
+  Double DCTIF[IT_GT_Interpolation_Filter_order];
+  for ( Int iPhase = 0; iPhase < iPhases; iPhase++ )
+  {
+    designFilter( DCTIF, (Double)iPhase / iPhases );
+    Int iSum = 0;
+    Int iMax = 0;
+    for ( Int k = 0; k < IT_GT_Interpolation_Filter_order; k++ )
+    {
+      s_aiGTDCTIFTaps[iPhase][k] = (Short)floor( DCTIF[k] * iUnit + 0.5 );
+      iSum += s_aiGTDCTIFTaps[iPhase][k];
+      if ( s_aiGTDCTIFTaps[iPhase][k] > s_aiGTDCTIFTaps[iPhase][iMax] )
+      {
+        iMax = k;
+      }
+    }
+    // the rounding error goes to the largest tap, so that the taps sum to one
+    s_aiGTDCTIFTaps[iPhase][iMax] += iUnit - iSum;
+  }
+  s_bGTDCTIFTapsInit = true;
+}
+
+#else
+Void TComPrediction::calcParamProjective(Int x[4], Int y[4], GTWarpParam& rcParam, Int Width, Int Height)
+{
+  Double* h = rcParam.dCoef;
   Double H, W, deltax[4], deltay[4];
 
   W = (Double)Width - 1.0;
@@ -829,10 +1714,14 @@ Void TComPrediction::calcParamProjective(Int x[4], Int y[4], Double h[9], Int Wi
   h[7] = (Double)y[0];
 
   h[8] = 1.0;
+  rcParam.bAffine = (h[2] == 0.0 && h[5] == 0.0);
+  rcParam.iMaxVal = ( 1 << g_bitDepthY ) - 1;
+  rcParam.bBilinear = false;
 }
 #if IT_GT_UV
-Void TComPrediction::calcParamProjectiveC(Double x[4], Double y[4], Double h[9], Int Width, Int Height)
+Void TComPrediction::calcParamProjectiveC(Double x[4], Double y[4], GTWarpParam& rcParam, Int Width, Int Height)
 {
+  Double* h = rcParam.dCoef;
   Double H, W, deltax[4], deltay[4];
 
   W = (Double)Width - 1.0;
@@ -856,11 +1745,15 @@ Void TComPrediction::calcParamProjectiveC(Double x[4], Double y[4], Double h[9],
   h[7] = y[0];
 
   h[8] = 1.0;
+  rcParam.bAffine = (h[2] == 0.0 && h[5] == 0.0);
+  rcParam.iMaxVal = ( 1 << g_bitDepthC ) - 1;
+  rcParam.bBilinear = false;
 }
 #endif
 
-Void TComPrediction::calcParamBilinear(Int x[4], Int y[4], Double h[9], Int Width, Int Height)
+Void TComPrediction::calcParamBilinear(Int x[4], Int y[4], GTWarpParam& rcParam, Int Width, Int Height)
 {
+  Double* h = rcParam.dCoef;
   Double H, W;
 
   W = (Double)Width - 1.0;
@@ -877,11 +1770,14 @@ Void TComPrediction::calcParamBilinear(Int x[4], Int y[4], Double h[9], Int Widt
   h[7] = (y[2]-y[3]-y[1]+y[0])/(H*W);
 
   h[8] = 0.0; // unused
-
+  rcParam.bAffine = (h[3] == 0.0 && h[7] == 0.0);
+  rcParam.iMaxVal = ( 1 << g_bitDepthY ) - 1;
+  rcParam.bBilinear = true;
 }
 #if IT_GT_UV
-Void TComPrediction::calcParamBilinearC(Double x[4], Double y[4], Double h[9], Int Width, Int Height)
+Void TComPrediction::calcParamBilinearC(Double x[4], Double y[4], GTWarpParam& rcParam, Int Width, Int Height)
 {
+  Double* h = rcParam.dCoef;
   Double H, W;
 
   W = (Double)Width - 1.0;
@@ -898,11 +1794,14 @@ Void TComPrediction::calcParamBilinearC(Double x[4], Double y[4], Double h[9], I
   h[7] = (y[2]-y[3]-y[1]+y[0])/(H*W);
 
   h[8] = 0.0; // unused
-
+  rcParam.bAffine = (h[3] == 0.0 && h[7] == 0.0);
+  rcParam.iMaxVal = ( 1 << g_bitDepthC ) - 1;
+  rcParam.bBilinear = true;
 }
 #endif
-Void TComPrediction::ProjectiveTransform(Pel* piRefY, Pel* piAux, Double h[9], Int W, Int H, Int iStrideCur, Int iNSSWindow)
+Void TComPrediction::ProjectiveTransform(Pel* piRefY, Pel* piAux, GTWarpParam& rcParam, Int W, Int H, Int iStrideCur, Int iNSSWindow)
 {
+  Double* h = rcParam.dCoef;
   Int X = 0, Y = 0, pixels = 0;
   Double Fx = 0.0, Fy = 0.0, q = 0.0, p = 0.0, aux = 0.0;
   Pel *paux;
@@ -966,8 +1865,8 @@ Void TComPrediction::ProjectiveTransform(Pel* piRefY, Pel* piAux, Double h[9], I
       aux = (1.0 - q) * ((1.0 - p)* (Double)(paux[X]) + p* (Double)(paux[X + 1]));
       paux = piRefY + (Y + 1)* iStrideCur;
       aux += q  * ((1.0 - p)* (Double)(paux[X]) + p* (Double)(paux[X + 1]));
-      if (aux > 255)
-        aux = 255;
+      if (aux > rcParam.iMaxVal)
+        aux = rcParam.iMaxVal;
       if (aux < 0)
         aux = 0;
 #endif
@@ -1029,7 +1928,8 @@ Void TComPrediction::ProjectiveTransform(Pel* piRefY, Pel* piAux, Double h[9], I
   }
 }
 
-#if IT_GT_Interpolation_Filter == 2
+#endif
+
 Void TComPrediction::designFilter (Double DCTIF[IT_GT_Interpolation_Filter_order], Double alpha)
 {
 	Double nTaps = IT_GT_Interpolation_Filter_order;
@@ -1067,11 +1967,11 @@ Void TComPrediction::designFilter (Double DCTIF[IT_GT_Interpolation_Filter_order
 
 }
 
+#if !IT_GT_FIXED_POINT_WARP
 Double TComPrediction::applyFilterHor(Pel *piRefY, Int iStrideCur, Int X, Int Y, Double DCTIF[IT_GT_Interpolation_Filter_order], Int W, Int H, Int iNSSWindow)
 {
 	Int nTaps = IT_GT_Interpolation_Filter_order;
 	Int M = nTaps >> 1;
-	Int N = nTaps + 3;
 	Int xMinLimit = 0;
 	Int xMaxLimit = 0;
 	Int gridSize = IT_GT_GRID_SIZE;
@@ -1101,7 +2001,6 @@ Double TComPrediction::applyFilterVer(Pel *piRefY, Int iStrideCur, Int X, Int Y,
 {
 	Int nTaps = IT_GT_Interpolation_Filter_order;
 	Int M = nTaps >> 1;
-	Int N = nTaps + 3;
 	Int yMinLimit = 0;
 	Int yMaxLimit = 0;
 	Int gridSize = IT_GT_GRID_SIZE;
@@ -1129,11 +2028,6 @@ Double TComPrediction::applyFilterHor(Double *piRefY, Double DCTIF[IT_GT_Interpo
 {
 	Int nTaps = IT_GT_Interpolation_Filter_order;
 	Int M = nTaps >> 1;
-	Int N = nTaps + 3;
-	Int xMinLimit = 0;
-	Int xMaxLimit = 0;
-	Int gridSize = IT_GT_GRID_SIZE;
-	Int x = 0;
 	Double pixel = 0;
 
 	for(Int m = 1 - M; m <= M; m++)
@@ -1143,10 +2037,9 @@ Double TComPrediction::applyFilterHor(Double *piRefY, Double DCTIF[IT_GT_Interpo
 	return pixel;
 }
 
-#endif
-
-Void TComPrediction::BilinearTransform(Pel* piRefY, Pel* piAux, Double h[9], Int W, Int H, Int iStrideCur, Int iNSSWindow)
+Void TComPrediction::BilinearTransform(Pel* piRefY, Pel* piAux, GTWarpParam& rcParam, Int W, Int H, Int iStrideCur, Int iNSSWindow)
 {
+  Double* h = rcParam.dCoef;
   Int X = 0, Y = 0, pixels = 0;
   Double Fx = 0.0, Fy = 0.0, q = 0.0, p = 0.0, aux = 0.0;
   Pel *paux;
@@ -1205,8 +2098,8 @@ Void TComPrediction::BilinearTransform(Pel* piRefY, Pel* piAux, Double h[9], Int
       aux = (1.0 - q) * ((1.0 - p)* (Double)(paux[X]) + p* (Double)(paux[X + 1]));
       paux = piRefY + (Y + 1)* iStrideCur;
       aux += q  * ((1.0 - p)* (Double)(paux[X]) + p* (Double)(paux[X + 1]));
-      if (aux + 0.5 > 255)
-        aux = 255;
+      if (aux + 0.5 > rcParam.iMaxVal)
+        aux = rcParam.iMaxVal;
       if (aux + 0.5 < 0)
         aux = 0;
 #if IT_GT_GRID_SIZE < 2
@@ -1220,6 +2113,113 @@ Void TComPrediction::BilinearTransform(Pel* piRefY, Pel* piAux, Double h[9], Int
 }
 #endif
 
+/** Warp a block and measure its distortion against the original block
+ * \param piRefY      pointer to the top-left sample of the block in the (extended) reference
+ * \param piAux       scratch buffer of the size of the block
+ * \param h           transform derived by calcParamProjective or calcParamBilinear
+ * \param W           width of the transformed grid
+ * \param H           height of the transformed grid
+ * \param iStrideCur  stride of the reference
+ * \param iNSSWindow  reference margin around the block on the transformed grid
+ * \param rcDistParam distortion parameters of the original block, the warped block is compared with a stride of W/IT_GT_GRID_SIZE
+ * \param bHadamard   rcDistParam measures the Hadamard distortion
+ *
+ * With the fixed-point warp, the SAD of linear warps is computed while warping, without writing the warped block. The Hadamard distortion
+ * is measured on strips of rows as soon as they are warped, so that the strip is still in the cache.
+ * When rcDistParam.uiMaxCost is set, the block is warped and measured strip by strip, and both stop as soon as the partial distortion
+ * exceeds it; the partial distortion is returned then.
+ */
+UInt TComPrediction::GTWarpDistortion(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, DistParam& rcDistParam, Bool bHadamard)
+{
+  const Int    iBlkW    = W / IT_GT_GRID_SIZE;
+
+#if IT_GT_FIXED_POINT_WARP
+  const Int    iBlkH    = H / IT_GT_GRID_SIZE;
+  // strips follow the partitioning of TComRdCost::xGetHADs
+  const Int    iStripRows = ( iBlkH % 8 == 0 && iBlkW % 8 == 0 ) ? 8 : ( ( iBlkH % 4 == 0 && iBlkW % 4 == 0 ) ? 4 : 2 );
+  GTWarpRow    acRows[MAX_CU_SIZE];
+
+  if ( m_iGTInterpFilter == 0 && !rcDistParam.bApplyWeight && xGTLinearRows( h, piRefY, W, H, iStrideCur, iNSSWindow, acRows ) )
+  {
+    const Int  iShift    = DISTORTION_PRECISION_ADJUSTMENT( rcDistParam.bitDepth - 8 );
+    const UInt uiMaxCost = rcDistParam.uiMaxCost;
+    UInt uiSum = 0;
+    if ( !bHadamard )
+    {
+      Pel* piOrg = rcDistParam.pOrg;
+      for ( Int y = 0; y < iBlkH; y++ )
+      {
+        uiSum += m_fpGTWarpRowSAD( acRows[y], piOrg );
+        piOrg += rcDistParam.iStrideOrg;
+        if ( ( uiSum >> iShift ) > uiMaxCost )
+        {
+          break;
+        }
+      }
+    }
+    else
+    {
+      DistParam cStrip = rcDistParam;
+      cStrip.pCur       = piAux;
+      cStrip.iStrideCur = iBlkW;
+      cStrip.iRows      = iStripRows;
+      cStrip.bitDepth   = 8; // the precision adjustment is applied once to the whole block
+      for ( Int y = 0; y < iBlkH; y += iStripRows )
+      {
+        for ( Int k = 0; k < iStripRows; k++ )
+        {
+          m_fpGTWarpRow( acRows[y + k], piAux + k * iBlkW );
+        }
+        cStrip.pOrg = rcDistParam.pOrg + y * rcDistParam.iStrideOrg;
+        uiSum += cStrip.DistFunc( &cStrip );
+        if ( ( uiSum >> iShift ) > uiMaxCost )
+        {
+          break;
+        }
+      }
+    }
+    return uiSum >> iShift;
+  }
+
+  if ( rcDistParam.uiMaxCost != MAX_UINT && !rcDistParam.bApplyWeight )
+  {
+    // warp and measure strip by strip, the rows of the strips that are not reached are never warped
+    const Int  iShift = DISTORTION_PRECISION_ADJUSTMENT( rcDistParam.bitDepth - 8 );
+    Void (TComPrediction::*pfWarp)( Pel*, Pel*, GTWarpParam&, Int, Int, Int, Int, Int, Int ) = h.bBilinear ? m_pfGTBilinear : m_pfGTProjective;
+    DistParam cStrip = rcDistParam;
+    cStrip.iStrideCur = iBlkW;
+    cStrip.iRows      = iStripRows;
+    cStrip.bitDepth   = 8; // the precision adjustment is applied once to the whole block
+    UInt uiSum = 0;
+    for ( Int y = 0; y < iBlkH; y += iStripRows )
+    {
+      (this->*pfWarp)( piRefY, piAux, h, W, H, iStrideCur, iNSSWindow, y, y + iStripRows );
+      cStrip.pOrg = rcDistParam.pOrg + y * rcDistParam.iStrideOrg;
+      cStrip.pCur = piAux + y * iBlkW;
+      uiSum += cStrip.DistFunc( &cStrip );
+      if ( ( uiSum >> iShift ) > rcDistParam.uiMaxCost )
+      {
+        break;
+      }
+    }
+    return uiSum >> iShift;
+  }
+#endif
+
+  if ( h.bBilinear )
+  {
+    BilinearTransform( piRefY, piAux, h, W, H, iStrideCur, iNSSWindow );
+  }
+  else
+  {
+    ProjectiveTransform( piRefY, piAux, h, W, H, iStrideCur, iNSSWindow );
+  }
+  rcDistParam.pCur       = piAux;
+  rcDistParam.iStrideCur = iBlkW;
+  return rcDistParam.DistFunc( &rcDistParam );
+}
+#endif
+
 /**
  * \brief Generate motion-compensated chroma block
  *
@@ -1289,6 +2289,30 @@ Void TComPrediction::xPredInterChromaBlk( TComDataCU *cu, TComPicYuv *refPic, UI
   }
 #if IT_GT && IT_GT_UV
 	}else{
+#if IT_GT_WARP_CACHE
+		GTWarpCacheKey cCacheKey;
+		if ( m_cGTWarpCache.isActive() )
+		{
+			xGetGTWarpCacheKey( cu, refPic, partAddr, mv, width, height, bi, mGT0, mGT1, mGT2, mGT3, cCacheKey );
+			const Pel* piCachedCb = m_cGTWarpCache.find( cCacheKey, 1 );
+			const Pel* piCachedCr = m_cGTWarpCache.find( cCacheKey, 2 );
+			if ( piCachedCb && piCachedCr )
+			{
+				Pel* piDstCb = dstPic->getCbAddr( partAddr );
+				Pel* piDstCr = dstPic->getCrAddr( partAddr );
+				for ( Int y = 0; y < ( height >> 1 ); y++ )
+				{
+					::memcpy( piDstCb, piCachedCb, ( width >> 1 ) * sizeof(Pel) );
+					::memcpy( piDstCr, piCachedCr, ( width >> 1 ) * sizeof(Pel) );
+					piCachedCb += width >> 1;
+					piCachedCr += width >> 1;
+					piDstCb    += dstPic->getCStride();
+					piDstCr    += dstPic->getCStride();
+				}
+				return;
+			}
+		}
+#endif
 
 		Int     refStride  = refPic->getCStride();
 		Int     dstStride  = dstPic->getCStride();
@@ -1308,17 +2332,26 @@ Void TComPrediction::xPredInterChromaBlk( TComDataCU *cu, TComPicYuv *refPic, UI
 
 		Pel* piDstCborig = dstCb;
 		Pel* piRefCborig = refCb;
-		Pel *dst1CbOrg = (Pel*)xMalloc(Pel, (width * height));
-		Pel *dst1Cb = dst1CbOrg;
+		UInt uiScratchMark = m_cGTScratch.getMark();
+		Pel *dst1Cb = m_cGTScratch.alloc<Pel>( width * height );
 
 		Pel* piDstCrorig = dstCr;
 		Pel* piRefCrorig = refCr;
-		Pel *dst1CrOrg = (Pel*)xMalloc(Pel, (width * height));
-		Pel *dst1Cr = dst1CrOrg;
+		Pel *dst1Cr = m_cGTScratch.alloc<Pel>( width * height );
 
 		Int dst1Stride = width;
 
 
+#if IT_GT_FIXED_POINT_WARP
+		if ( xFrac == 0 && yFrac == 0 && !bi )
+		{
+			// integer vector: the interpolation would only copy the window, the warp reads the reference
+			dst1Cb     = refCb;
+			dst1Cr     = refCr;
+			dst1Stride = refStride;
+		}
+		else
+#endif
 		if ( yFrac == 0 )
 		{
 			m_if.filterHorChroma(refCb, refStride, dst1Cb,  dst1Stride, cxWidth*2, cxHeight*2, xFrac, !bi);
@@ -1338,35 +2371,71 @@ Void TComPrediction::xPredInterChromaBlk( TComDataCU *cu, TComPicYuv *refPic, UI
 			m_if.filterVerChroma(extY  + (halfFilterSize-1)*extStride, extStride, dst1Cr, dst1Stride, cxWidth*2, cxHeight*2  , yFrac, false, !bi);
 		}
 
-		xPredGTChroma(piDstCborig, dst1Cb, height/2, width/2, mGT0, mGT1, mGT2, mGT3, dstStride, dst1Stride);
-		xPredGTChroma(piDstCrorig, dst1Cr, height/2, width/2, mGT0, mGT1, mGT2, mGT3, dstStride, dst1Stride);
-		xFree(dst1CrOrg);
-		xFree(dst1CbOrg);
+		xPredGTChroma(piDstCborig, piDstCrorig, dst1Cb, dst1Cr, height/2, width/2, mGT0, mGT1, mGT2, mGT3, dstStride, dst1Stride);
+		m_cGTScratch.release( uiScratchMark );
+#if IT_GT_WARP_CACHE
+		if ( m_cGTWarpCache.isActive() )
+		{
+			Pel* piCacheCb = m_cGTWarpCache.store( cCacheKey, 1 );
+			Pel* piCacheCr = m_cGTWarpCache.store( cCacheKey, 2 );
+			for ( Int y = 0; y < ( height >> 1 ); y++ )
+			{
+				::memcpy( piCacheCb, piDstCborig, ( width >> 1 ) * sizeof(Pel) );
+				::memcpy( piCacheCr, piDstCrorig, ( width >> 1 ) * sizeof(Pel) );
+				piCacheCb   += width >> 1;
+				piCacheCr   += width >> 1;
+				piDstCborig += dstStride;
+				piDstCrorig += dstStride;
+			}
+		}
+#endif
   }
 #endif
 }
 
 #if IT_GT
 #if IT_GT_UV
-Void TComPrediction::xPredGTChroma(Pel* dst, Pel* dst1, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride)
+Void TComPrediction::xPredGTChroma(Pel* dstCb, Pel* dstCr, Pel* dst1Cb, Pel* dst1Cr, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride)
 {
+#if IT_GT_FIXED_POINT_WARP
+	// chroma corners are kept in half-sample units (luma corner offsets are halved for chroma)
+	Int iCurrCornerX[4], iCurrCornerY[4];
+#else
 	Double iCurrCornerX[4], iCurrCornerY[4];
-	Double dProjective[9];
-	Pel* piAuxOrg = (Pel*)xMalloc(Pel, (width * height));
-	Pel* piAux = piAuxOrg;;
+#endif
+	GTWarpParam dProjective;
 	Int iNSSWindow = ((height < width) ? (height) : (width)) >> 1;
 #if IT_GT_GRID_SIZE > 1
 	iNSSWindow *= IT_GT_GRID_SIZE;
 #endif
-	Int iMaxNSSIteration = IT_MAX_NSS_Iteration;
+	Int iMaxNSSIteration = m_iGTMaxIteration;
 #if IT_GT_Iteration_Limit
 	iMaxNSSIteration = log2((double)(iNSSWindow/IT_GT_GRID_SIZE));
 #endif
 
+#if IT_GT_FIXED_POINT_WARP
+	Int lastIterationStep = iNSSWindow >> iMaxNSSIteration;
+#else
 	 Double lastIterationStep = iNSSWindow >> iMaxNSSIteration;
+#endif
 	if(lastIterationStep == 0)
 		lastIterationStep = 1;
 
+#if IT_GT_FIXED_POINT_WARP
+#if IT_GT_SEARCH == 0 || IT_GT_SEARCH == 2 || IT_GT_SEARCH == 4
+	iCurrCornerX[0] = mGT0->getHor() * lastIterationStep;            							iCurrCornerY[0] = mGT0->getVer() * lastIterationStep;
+	iCurrCornerX[1] = (mGT1->getHor() * lastIterationStep) + 2*(width*IT_GT_GRID_SIZE -1);  	iCurrCornerY[1] = mGT1->getVer() * lastIterationStep;
+	iCurrCornerX[2] = (mGT2->getHor() * lastIterationStep) + 2*(width*IT_GT_GRID_SIZE -1);  	iCurrCornerY[2] = (mGT2->getVer() * lastIterationStep) + 2*(height*IT_GT_GRID_SIZE -1);
+	iCurrCornerX[3] = mGT3->getHor() * lastIterationStep;            							iCurrCornerY[3] = (mGT3->getVer() * lastIterationStep) + 2*(height*IT_GT_GRID_SIZE -1);
+#else
+#if IT_GT_SEARCH == 1
+	iCurrCornerX[0] = mGT0->getHor() ;            	 				iCurrCornerY[0] = mGT0->getVer() ;
+	iCurrCornerX[1] = mGT1->getHor() + 2*(width -1);  				iCurrCornerY[1] = mGT1->getVer() ;
+	iCurrCornerX[2] = mGT2->getHor() + 2*(width -1);  				iCurrCornerY[2] = mGT2->getVer() + 2*(height -1);
+	iCurrCornerX[3] = mGT3->getHor() ;            	 				iCurrCornerY[3] = mGT3->getVer() + 2*(height -1);
+#endif
+#endif
+#else
 #if IT_GT_SEARCH == 0 || IT_GT_SEARCH == 2 || IT_GT_SEARCH == 4
 #if IT_GT_GRID_SIZE < 2
 	iCurrCornerX[0] = ((Double)(mGT0->getHor())/2) * lastIterationStep;            	iCurrCornerY[0] = ((Double)(mGT0->getVer())/2) * lastIterationStep;
@@ -1386,37 +2455,68 @@ Void TComPrediction::xPredGTChroma(Pel* dst, Pel* dst1, Int height, Int width, T
 	iCurrCornerX[2] = (((Double)(mGT2->getHor())/2) ) + width -1;  iCurrCornerY[2] = (((Double)(mGT2->getVer())/2)) + height -1;
 	iCurrCornerX[3] = ((Double)(mGT3->getHor())/2) ;            	 iCurrCornerY[3] = (((Double)(mGT3->getVer())/2)) + height -1;
 #endif
+#endif
 #endif
 
-	dst1 += width / 2 + (height / 2) * dst1Stride;
+	dst1Cb += width / 2 + (height / 2) * dst1Stride;
+	dst1Cr += width / 2 + (height / 2) * dst1Stride;
+#if IT_GT_FIXED_POINT_WARP
+	// both components are warped with the same transform
 #if IT_GT_GRID_SIZE < 2
 #if !IT_GT_BILINEAR_TRANSFORMATION
-	calcParamProjectiveC(iCurrCornerX, iCurrCornerY, dProjective, width , height );
-	ProjectiveTransform(dst1, piAux, dProjective, width , height , dst1Stride, (((height < width) ? (height) : (width)) >> 1)); // 64x32 -> 32 -> Window 16x16);
+	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, width , height, 1 );
 #else
-	calcParamBilinearC(iCurrCornerX, iCurrCornerY, dProjective, width , height );
-	BilinearTransform(dst1, piAux, dProjective, width , height , dst1Stride, (((height < width) ? (height) : (width)) >> 1)); // 64x32 -> 32 -> Window 16x16);
+	calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, width , height, 1 );
 #endif
+	dProjective.iMaxVal = ( 1 << g_bitDepthC ) - 1;
+	(this->*m_pfGTChroma)(dst1Cb, dst1Cr, dst1Stride, dProjective, width , height , (((height < width) ? (height) : (width)) >> 1), dstCb, dstCr, dstStride);
 #else
 #if !IT_GT_BILINEAR_TRANSFORMATION
-	calcParamProjectiveC(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE);
-	ProjectiveTransform(dst1, piAux, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, dst1Stride, (((height < width) ? (height) : (width)) >> 1)* IT_GT_GRID_SIZE); // 64x32 -> 32 -> Window 16x16);
+	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, 1);
 #else
-	calcParamBilinearC(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE);
-	BilinearTransform(dst1, piAux, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, dst1Stride, (((height < width) ? (height) : (width)) >> 1)* IT_GT_GRID_SIZE); // 64x32 -> 32 -> Window 16x16);
+	calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, 1);
 #endif
+	dProjective.iMaxVal = ( 1 << g_bitDepthC ) - 1;
+	(this->*m_pfGTChroma)(dst1Cb, dst1Cr, dst1Stride, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, (((height < width) ? (height) : (width)) >> 1)* IT_GT_GRID_SIZE, dstCb, dstCr, dstStride);
 #endif
-
-	for(Int y = 0; y < height; y++)
+#else
+	UInt uiScratchMark = m_cGTScratch.getMark();
+	Pel* piAux = m_cGTScratch.alloc<Pel>( width * height );
+	Pel* apiDst[2]  = { dstCb, dstCr };
+	Pel* apiDst1[2] = { dst1Cb, dst1Cr };
+	for (Int iComp = 0; iComp < 2; iComp++)
 	{
-		for(Int x = 0; x < width; x++)
+		Pel* dst  = apiDst[iComp];
+		Pel* dst1 = apiDst1[iComp];
+#if IT_GT_GRID_SIZE < 2
+#if !IT_GT_BILINEAR_TRANSFORMATION
+		calcParamProjectiveC(iCurrCornerX, iCurrCornerY, dProjective, width , height );
+		ProjectiveTransform(dst1, piAux, dProjective, width , height , dst1Stride, (((height < width) ? (height) : (width)) >> 1)); // 64x32 -> 32 -> Window 16x16);
+#else
+		calcParamBilinearC(iCurrCornerX, iCurrCornerY, dProjective, width , height );
+		BilinearTransform(dst1, piAux, dProjective, width , height , dst1Stride, (((height < width) ? (height) : (width)) >> 1)); // 64x32 -> 32 -> Window 16x16);
+#endif
+#else
+#if !IT_GT_BILINEAR_TRANSFORMATION
+		calcParamProjectiveC(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE);
+		ProjectiveTransform(dst1, piAux, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, dst1Stride, (((height < width) ? (height) : (width)) >> 1)* IT_GT_GRID_SIZE); // 64x32 -> 32 -> Window 16x16);
+#else
+		calcParamBilinearC(iCurrCornerX, iCurrCornerY, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE);
+		BilinearTransform(dst1, piAux, dProjective, width * IT_GT_GRID_SIZE, height * IT_GT_GRID_SIZE, dst1Stride, (((height < width) ? (height) : (width)) >> 1)* IT_GT_GRID_SIZE); // 64x32 -> 32 -> Window 16x16);
+#endif
+#endif
+
+		for(Int y = 0; y < height; y++)
 		{
-			dst[x] = piAux[x];
+			for(Int x = 0; x < width; x++)
+			{
+				dst[x] = piAux[y * width + x];
+			}
+			dst += dstStride;
 		}
-		dst += dstStride;
-		piAux += width;
 	}
-	xFree(piAuxOrg);
+	m_cGTScratch.release( uiScratchMark );
+#endif
 }
 #endif
 #endif
@@ -1469,43 +2569,7 @@ Void TComPrediction::xPredIntraPlanar( Int* pSrc, Int srcStride, Pel* rpDst, Int
 {
   assert(width == height);
 
-  Int k, l, bottomLeft, topRight;
-  Int horPred;
-  Int leftColumn[MAX_CU_SIZE+1], topRow[MAX_CU_SIZE+1], bottomRow[MAX_CU_SIZE], rightColumn[MAX_CU_SIZE];
-  UInt blkSize = width;
-  UInt offset2D = width;
-  UInt shift1D = g_aucConvertToBit[ width ] + 2;
-  UInt shift2D = shift1D + 1;
-
-  // Get left and above reference column and row
-  for(k=0;k<blkSize+1;k++)
-  {
-    topRow[k] = pSrc[k-srcStride];
-    leftColumn[k] = pSrc[k*srcStride-1];
-  }
-
-  // Prepare intermediate variables used in interpolation
-  bottomLeft = leftColumn[blkSize];
-  topRight   = topRow[blkSize];
-  for (k=0;k<blkSize;k++)
-  {
-    bottomRow[k]   = bottomLeft - topRow[k];
-    rightColumn[k] = topRight   - leftColumn[k];
-    topRow[k]      <<= shift1D;
-    leftColumn[k]  <<= shift1D;
-  }
-
-  // Generate prediction signal
-  for (k=0;k<blkSize;k++)
-  {
-    horPred = leftColumn[k] + offset2D;
-    for (l=0;l<blkSize;l++)
-    {
-      horPred += rightColumn[k];
-      topRow[l] += bottomRow[l];
-      rpDst[k*dstStride+l] = ( (horPred + topRow[l]) >> shift2D );
-    }
-  }
+  m_fpPredIntraPlanar( pSrc, srcStride, rpDst, dstStride, width );
 }
 
 /** Function for filtering intra DC predictor.
@@ -46,11 +46,32 @@
 #include "TComTrQuant.h"
 #include "TComInterpolationFilter.h"
 #include "TComWeightPrediction.h"
+#include "TComRdCost.h"
+#if IT_GT
+#include "TComGTWarp.h"
+#include "TComScratchArena.h"
+#if IT_GT_WARP_CACHE
+#include "TComGTWarpCache.h"
+#endif
+#endif
 #include <cmath>
 
 //! \ingroup TLibCommon
 //! \{
 
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// angular intra prediction of the rows of a block from its main reference, for a non-zero angle
+typedef Void (*FpPredIntraAng)    ( const Pel* refMain, Pel* pDst, Int dstStride, Int blkSize, Int intraPredAngle );
+/// planar intra prediction of a block
+typedef Void (*FpPredIntraPlanar) ( const Int* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize );
+/// DC intra prediction of a block, the DC value is given
+typedef Void (*FpPredIntraDC)     ( Pel dcVal, Pel* pDst, Int dstStride, Int blkSize );
+/// transpose of a block, the horizontal modes are predicted as vertical ones
+typedef Void (*FpTransposePel)    ( const Pel* pSrc, Int srcStride, Pel* pDst, Int dstStride, Int blkSize );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -72,9 +93,35 @@ protected:
   
   Pel*   m_pLumaRecBuffer;       ///< array for downsampled reconstructed luma sample 
   Int    m_iLumaRecStride;       ///< stride of #m_pLumaRecBuffer array
+  FpPredIntraAng    m_fpPredIntraAng;    ///< angular rows, selected for the CPU
+  FpPredIntraPlanar m_fpPredIntraPlanar; ///< planar prediction, selected for the CPU
+  FpPredIntraDC     m_fpPredIntraDC;     ///< DC prediction, selected for the CPU
+  FpTransposePel    m_fpTransposePel;    ///< transpose of the horizontal modes, selected for the CPU
+#if IT_GT && IT_GT_FIXED_POINT_WARP
+  FpGTWarpRow    m_fpGTWarpRow;    ///< warp of one row, selected for the CPU
+  FpGTWarpRowSAD m_fpGTWarpRowSAD; ///< warp of one row fused with its SAD, selected for the CPU
+#endif
+#if IT_GT
+  TComScratchArena m_cGTScratch;    ///< temporaries of the GT prediction and search, taken and released in stack order
+  Int            m_iGTMaxIteration; ///< number of halvings of the GT corner step, from the slice
+  Int            m_iGTInterpFilter; ///< interpolation filter of the GT warp (0: bilinear, 1: nearest, 2: DCT-IF), from the slice
+#if IT_GT_WARP_CACHE
+  TComGTWarpCache m_cGTWarpCache;   ///< GT predictions of the current CU, only created by the encoder
+#endif
+#if IT_GT_FIXED_POINT_WARP
+  Void (TComPrediction::*m_pfGTProjective)( Pel*, Pel*, GTWarpParam&, Int, Int, Int, Int, Int, Int ); ///< ProjectiveTransform of a range of rows, specialised for #m_iGTInterpFilter
+  Void (TComPrediction::*m_pfGTBilinear)  ( Pel*, Pel*, GTWarpParam&, Int, Int, Int, Int, Int, Int ); ///< BilinearTransform of a range of rows, specialised for #m_iGTInterpFilter
+#if IT_GT_UV
+  Void (TComPrediction::*m_pfGTChroma)    ( Pel*, Pel*, Int, GTWarpParam&, Int, Int, Int, Pel*, Pel*, Int ); ///< xGTWarpChroma, specialised for #m_iGTInterpFilter
+#endif
+  static Short s_aiGTDCTIFTaps[1 << IT_GT_DCTIF_PHASE_BITS][IT_GT_Interpolation_Filter_order]; ///< integer DCT-IF taps of each quantised phase
+  static Bool  s_bGTDCTIFTapsInit;
+#endif
+#endif
 
   Void xPredIntraAng            (Int bitDepth, Int* pSrc, Int srcStride, Pel*& rpDst, Int dstStride, UInt width, UInt height, UInt dirMode, Bool blkAboveAvailable, Bool blkLeftAvailable, Bool bFilter );
   Void xPredIntraPlanar         ( Int* pSrc, Int srcStride, Pel* rpDst, Int dstStride, UInt width, UInt height );
+  Void xSelectIntraKernels      ();
   
   // motion compensation functions
   Void xPredInterUni            ( TComDataCU* pcCU,                          UInt uiPartAddr,               Int iWidth, Int iHeight, RefPicList eRefPicList, TComYuv*& rpcYuvPred,
@@ -99,22 +146,49 @@ protected:
 		  );
 
 #if IT_GT
+#if IT_GT_WARP_CACHE
+  Void xGetGTWarpCacheKey( TComDataCU* cu, TComPicYuv* refPic, UInt partAddr, TComMv* mv, Int width, Int height, Bool bi, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, GTWarpCacheKey& rcKey );
+#endif
   Void xPredGTLuma(Pel* dst, Pel* dst1, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride);
 #if IT_GT_UV
-  Void xPredGTChroma(Pel* dst, Pel* dst1, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride);
+  Void xPredGTChroma(Pel* dstCb, Pel* dstCr, Pel* dst1Cb, Pel* dst1Cr, Int height, Int width, TComMv* mGT0, TComMv* mGT1, TComMv* mGT2, TComMv* mGT3, Int dstStride, Int dst1Stride);
+#endif
+#if IT_GT_FIXED_POINT_WARP
+  Void calcParamProjective(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height, Int iCornerShift = 0);
+  Void ProjectiveTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow) { (this->*m_pfGTProjective)( piRefY, piAux, h, W, H, iStrideCur, iNSSWindow, 0, H / IT_GT_GRID_SIZE ); }
+  Void calcParamBilinear(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height, Int iCornerShift = 0);
+  Void BilinearTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow)   { (this->*m_pfGTBilinear)( piRefY, piAux, h, W, H, iStrideCur, iNSSWindow, 0, H / IT_GT_GRID_SIZE ); }
+  static Bool isGTAffineCorners(const Int x[4], const Int y[4], Bool bBilinear);
+  template <Int iFilter>
+  Void xProjectiveTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, Int iRowBegin, Int iRowEnd);
+  template <Int iFilter>
+  Void xBilinearTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, Int iRowBegin, Int iRowEnd);
+  template <Int iFilter>
+  Pel  xGTInterpolate(Pel* piRefY, Int iStrideCur, Int iPosX, Int iPosY, Int offsetX, Int offsetY, Int iMinPos, Int iMaxPosX, Int iMaxPosY, Int iMaxVal, Int W, Int H, Int iNSSWindow);
+  Bool xGTLinearRows(GTWarpParam& h, Pel* piRefY, Int W, Int H, Int iStrideCur, Int iNSSWindow, GTWarpRow* pcRows, Int iRowBegin = 0, Int iRowEnd = MAX_CU_SIZE);
+  template <Int iFilter>
+  Void xGTWarpRow(const GTWarpRow& rcRow, Pel* piDst, Int W, Int H, Int iNSSWindow);
+#if IT_GT_UV
+  template <Int iFilter>
+  Void xGTWarpChroma(Pel* piRefCb, Pel* piRefCr, Int iStrideCur, GTWarpParam& h, Int W, Int H, Int iNSSWindow, Pel* piDstCb, Pel* piDstCr, Int iDstStride);
 #endif
-  Void calcParamProjective(Int x[4], Int y[4], Double h[9], Int Width, Int Height);
+  Void xSelectGTKernels();
+  Void xInitGTDCTIFTaps();
+#else
+  Void calcParamProjective(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height);
 #if IT_GT_UV
-  Void calcParamProjectiveC(Double x[4], Double y[4], Double h[9], Int Width, Int Height);
+  Void calcParamProjectiveC(Double x[4], Double y[4], GTWarpParam& h, Int Width, Int Height);
 #endif
-  Void ProjectiveTransform(Pel* piRefY, Pel* piAux, Double h[9], Int W, Int H, Int iStrideCur, Int iNSSWindow);
-  Void calcParamBilinear(Int x[4], Int y[4], Double h[9], Int Width, Int Height);
+  Void ProjectiveTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow);
+  Void calcParamBilinear(Int x[4], Int y[4], GTWarpParam& h, Int Width, Int Height);
 #if IT_GT_UV
-  Void calcParamBilinearC(Double x[4], Double y[4], Double h[9], Int Width, Int Height);
+  Void calcParamBilinearC(Double x[4], Double y[4], GTWarpParam& h, Int Width, Int Height);
+#endif
+  Void BilinearTransform(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow);
 #endif
-  Void BilinearTransform(Pel* piRefY, Pel* piAux, Double h[9], Int W, Int H, Int iStrideCur, Int iNSSWindow);
-#if IT_GT_Interpolation_Filter == 2
+  UInt GTWarpDistortion(Pel* piRefY, Pel* piAux, GTWarpParam& h, Int W, Int H, Int iStrideCur, Int iNSSWindow, DistParam& rcDistParam, Bool bHadamard);
   Void designFilter (Double DCTIF[IT_GT_Interpolation_Filter_order], Double alpha);
+#if !IT_GT_FIXED_POINT_WARP
   Double applyFilterHor(Pel *piRefY, Int iStrideCur, Int X, Int Y, Double DCTIF[IT_GT_Interpolation_Filter_order], Int W, Int H, Int iNSSWindow);
   Double applyFilterVer(Pel *piRefY, Int iStrideCur, Int X, Int Y, Double DCTIF[IT_GT_Interpolation_Filter_order], Int W, Int H, Int iNSSWindow);
   Double applyFilterHor(Double *piRefY, Double DCTIF[IT_GT_Interpolation_Filter_order]);
@@ -145,6 +219,12 @@ public:
   virtual ~TComPrediction();
   
   Void    initTempBuff();
+#if IT_GT
+  Void    setGTTools( TComSlice* pcSlice );
+#if IT_GT_WARP_CACHE
+  Void    clearGTWarpCache()      { m_cGTWarpCache.clear(); }
+#endif
+#endif
   
   // inter
   Void motionCompensation         ( TComDataCU*  pcCU, TComYuv* pcYuvPred,
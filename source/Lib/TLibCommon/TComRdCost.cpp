@@ -219,6 +219,14 @@ Void TComRdCost::init()
   m_afpDistortFunc[27] = TComRdCost::xGetHADs;
   m_afpDistortFunc[28] = TComRdCost::xGetHADs;
   
+  m_pfCalcHADs4x4      = TComRdCost::xCalcHADs4x4;
+  m_pfCalcHADs8x8      = TComRdCost::xCalcHADs8x8;
+  m_pfDistFuncX4       = TComRdCost::xGetSADx4;
+  
+#if SIMD_X86
+  xInitSimdDistortFunc();
+#endif
+  
 #if !FIX203
   m_puiComponentCostOriginP = NULL;
   m_puiComponentCost        = NULL;
@@ -230,6 +238,10 @@ Void TComRdCost::init()
 #if !FIX203
   m_iSearchLimit            = 0xdeaddead;
 #endif
+#if IT_GT
+  m_bGTAffine               = IT_GT_AFFINE;
+  m_iGTMaxIteration         = IT_MAX_NSS_Iteration;
+#endif
 }
 
 #if !FIX203
@@ -289,6 +301,7 @@ Void TComRdCost::setDistParam( UInt uiBlkWidth, UInt uiBlkHeight, DFunc eDFunc,
   rcDistParam.iCols    = uiBlkWidth;
   rcDistParam.iRows    = uiBlkHeight;
   rcDistParam.DistFunc = m_afpDistortFunc[eDFunc + g_aucConvertToBit[ rcDistParam.iCols ] + 1 ];
+  rcDistParam.DistFuncX4 = NULL;
   
   // initialize
   rcDistParam.iSubShift  = 0;
@@ -323,6 +336,7 @@ Void TComRdCost::setDistParam( TComPattern* pcPatternKey, Pel* piRefY, Int iRefS
     rcDistParam.DistFunc = m_afpDistortFunc[45 ];
   }
 #endif
+  rcDistParam.DistFuncX4 = m_pfDistFuncX4;
 
   // initialize
   rcDistParam.iSubShift  = 0;
@@ -368,6 +382,7 @@ Void TComRdCost::setDistParam( TComPattern* pcPatternKey, Pel* piRefY, Int iRefS
   {
     rcDistParam.DistFunc = m_afpDistortFunc[DF_HADS + g_aucConvertToBit[ rcDistParam.iCols ] + 1 ];
   }
+  rcDistParam.DistFuncX4 = NULL;
   
   // initialize
   rcDistParam.iSubShift  = 0;
@@ -386,6 +401,7 @@ TComRdCost::setDistParam( DistParam& rcDP, Int bitDepth, Pel* p1, Int iStride1,
   rcDP.iSubShift  = 0;
   rcDP.bitDepth   = bitDepth;
   rcDP.DistFunc   = m_afpDistortFunc[ ( bHadamard ? DF_HADS : DF_SADS ) + g_aucConvertToBit[ iWidth ] + 1 ];
+  rcDP.DistFuncX4 = NULL;
 }
 
 UInt TComRdCost::calcHAD(Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iStride1, Int iWidth, Int iHeight )
@@ -399,7 +415,7 @@ UInt TComRdCost::calcHAD(Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iSt
     {
       for ( x=0; x<iWidth; x+= 8 )
       {
-        uiSum += xCalcHADs8x8( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
+        uiSum += m_pfCalcHADs8x8( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
       }
       pi0 += iStride0*8;
       pi1 += iStride1*8;
@@ -413,7 +429,7 @@ UInt TComRdCost::calcHAD(Int bitDepth, Pel* pi0, Int iStride0, Pel* pi1, Int iSt
     {
       for ( x=0; x<iWidth; x+= 4 )
       {
-        uiSum += xCalcHADs4x4( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
+        uiSum += m_pfCalcHADs4x4( &pi0[x], &pi1[x], iStride0, iStride1, 1 );
       }
       pi0 += iStride0*4;
       pi1 += iStride1*4;
@@ -1011,6 +1027,21 @@ UInt TComRdCost::xGetSAD48( DistParam* pcDtParam )
 }
 #endif
 
+/** SADs of the original block at four reference positions
+ * \param ppiCur  reference blocks, pcDtParam->pCur is not used
+ * \param puiSum  DistFunc of each position
+ */
+Void TComRdCost::xGetSADx4( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum )
+{
+  Pel* piCur = pcDtParam->pCur;
+  for ( Int k = 0; k < 4; k++ )
+  {
+    pcDtParam->pCur = ppiCur[k];
+    puiSum[k] = pcDtParam->DistFunc( pcDtParam );
+  }
+  pcDtParam->pCur = piCur;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 // SSE
 // --------------------------------------------------------------------------------------------------------------------
@@ -1707,4 +1738,594 @@ UInt TComRdCost::xGetHADs( DistParam* pcDtParam )
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
 }
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD distortion functions
+// ====================================================================================================================
+
+// The sums are kept in 32-bit lanes and wrap like the UInt sums of the C kernels, the results are identical.
+
+SIMD_TARGET_SSE41 static inline UInt xHorizontalSumSSE41( __m128i vSum )
+{
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  vSum = _mm_add_epi32( vSum, _mm_shuffle_epi32( vSum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  return (UInt)_mm_cvtsi128_si32( vSum );
+}
+
+SIMD_TARGET_AVX2 static inline UInt xHorizontalSumAVX2( __m256i vSum )
+{
+  __m128i vHalf = _mm_add_epi32( _mm256_castsi256_si128( vSum ), _mm256_extracti128_si256( vSum, 1 ) );
+  vHalf = _mm_add_epi32( vHalf, _mm_shuffle_epi32( vHalf, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  vHalf = _mm_add_epi32( vHalf, _mm_shuffle_epi32( vHalf, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  return (UInt)_mm_cvtsi128_si32( vHalf );
+}
+
+/// absolute differences of eight samples, summed pairwise into 32-bit lanes
+SIMD_TARGET_SSE41 static inline __m128i xSAD8SSE41( const Pel* piOrg, const Pel* piCur )
+{
+  __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)piOrg ), _mm_loadu_si128( (const __m128i*)piCur ) );
+  return _mm_madd_epi16( _mm_abs_epi16( vDiff ), _mm_set1_epi16( 1 ) );
+}
+
+SIMD_TARGET_SSE41 static inline __m128i xSAD4SSE41( const Pel* piOrg, const Pel* piCur )
+{
+  __m128i vDiff = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) );
+  return _mm_madd_epi16( _mm_abs_epi16( vDiff ), _mm_set1_epi16( 1 ) );
+}
+
+/** squared differences of the samples in vDiff, each one shifted right before they are summed pairwise
+ * \param uiShift distortion precision adjustment of the C kernels, the squares are only added pairwise when it is 0
+ */
+SIMD_TARGET_SSE41 static inline __m128i xSquareSSE41( __m128i vDiff, UInt uiShift )
+{
+  if ( uiShift == 0 )
+  {
+    return _mm_madd_epi16( vDiff, vDiff );
+  }
+  __m128i vLo = _mm_mullo_epi16( vDiff, vDiff );
+  __m128i vHi = _mm_mulhi_epi16( vDiff, vDiff );
+  return _mm_add_epi32( _mm_srli_epi32( _mm_unpacklo_epi16( vLo, vHi ), uiShift ), _mm_srli_epi32( _mm_unpackhi_epi16( vLo, vHi ), uiShift ) );
+}
+
+SIMD_TARGET_AVX2 static inline __m256i xSquareAVX2( __m256i vDiff, UInt uiShift )
+{
+  if ( uiShift == 0 )
+  {
+    return _mm256_madd_epi16( vDiff, vDiff );
+  }
+  __m256i vLo = _mm256_mullo_epi16( vDiff, vDiff );
+  __m256i vHi = _mm256_mulhi_epi16( vDiff, vDiff );
+  return _mm256_add_epi32( _mm256_srli_epi32( _mm256_unpacklo_epi16( vLo, vHi ), uiShift ), _mm256_srli_epi32( _mm256_unpackhi_epi16( vLo, vHi ), uiShift ) );
+}
+
+template <Int iWidth>
+SIMD_TARGET_SSE41 UInt TComRdCost::xGetSADSSE41( DistParam* pcDtParam )
+{
+  // xGetSAD16N has no weighted variant
+  if ( iWidth != 0 && pcDtParam->bApplyWeight )
+  {
+    return xGetSADw( pcDtParam );
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Pel* piCur      = pcDtParam->pCur;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int  iSubShift  = pcDtParam->iSubShift;
+  Int  iSubStep   = ( 1 << iSubShift );
+  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+
+  __m128i vSum = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for ( ; n + 8 <= iCols; n += 8 )
+    {
+      vSum = _mm_add_epi32( vSum, xSAD8SSE41( piOrg + n, piCur + n ) );
+    }
+    if ( iCols & 4 )
+    {
+      vSum = _mm_add_epi32( vSum, xSAD4SSE41( piOrg + n, piCur + n ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  UInt uiSum = xHorizontalSumSSE41( vSum );
+  uiSum <<= iSubShift;
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+template <Int iWidth>
+SIMD_TARGET_AVX2 UInt TComRdCost::xGetSADAVX2( DistParam* pcDtParam )
+{
+  if ( iWidth != 0 && pcDtParam->bApplyWeight )
+  {
+    return xGetSADw( pcDtParam );
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Pel* piCur      = pcDtParam->pCur;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int  iSubShift  = pcDtParam->iSubShift;
+  Int  iSubStep   = ( 1 << iSubShift );
+  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+
+  const __m256i vOne = _mm256_set1_epi16( 1 );
+  __m256i vSum  = _mm256_setzero_si256();
+  __m128i vTail = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for ( ; n + 16 <= iCols; n += 16 )
+    {
+      __m256i vDiff = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)( piOrg + n ) ), _mm256_loadu_si256( (const __m256i*)( piCur + n ) ) );
+      vSum = _mm256_add_epi32( vSum, _mm256_madd_epi16( _mm256_abs_epi16( vDiff ), vOne ) );
+    }
+    if ( iCols & 8 )
+    {
+      vTail = _mm_add_epi32( vTail, xSAD8SSE41( piOrg + n, piCur + n ) );
+      n += 8;
+    }
+    if ( iCols & 4 )
+    {
+      vTail = _mm_add_epi32( vTail, xSAD4SSE41( piOrg + n, piCur + n ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  UInt uiSum = xHorizontalSumAVX2( vSum ) + xHorizontalSumSSE41( vTail );
+  uiSum <<= iSubShift;
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+template <Int iWidth>
+SIMD_TARGET_SSE41 UInt TComRdCost::xGetSSESSE41( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return xGetSSEw( pcDtParam );
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Pel* piCur      = pcDtParam->pCur;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int  iStrideOrg = pcDtParam->iStrideOrg;
+  Int  iStrideCur = pcDtParam->iStrideCur;
+  UInt uiShift    = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  __m128i vSum = _mm_setzero_si128();
+
+  for( ; iRows != 0; iRows-- )
+  {
+    if ( iCols == 4 )
+    {
+      __m128i vDiff = _mm_sub_epi16( _mm_loadl_epi64( (const __m128i*)piOrg ), _mm_loadl_epi64( (const __m128i*)piCur ) );
+      vSum = _mm_add_epi32( vSum, xSquareSSE41( vDiff, uiShift ) );
+    }
+    for ( Int n = 0; n + 8 <= iCols; n += 8 )
+    {
+      __m128i vDiff = _mm_sub_epi16( _mm_loadu_si128( (const __m128i*)( piOrg + n ) ), _mm_loadu_si128( (const __m128i*)( piCur + n ) ) );
+      vSum = _mm_add_epi32( vSum, xSquareSSE41( vDiff, uiShift ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumSSE41( vSum );
+}
+
+template <Int iWidth>
+SIMD_TARGET_AVX2 UInt TComRdCost::xGetSSEAVX2( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return xGetSSEw( pcDtParam );
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Pel* piCur      = pcDtParam->pCur;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  Int  iStrideOrg = pcDtParam->iStrideOrg;
+  Int  iStrideCur = pcDtParam->iStrideCur;
+  UInt uiShift    = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+  __m256i vSum = _mm256_setzero_si256();
+
+  for( ; iRows != 0; iRows-- )
+  {
+    for ( Int n = 0; n < iCols; n += 16 )
+    {
+      __m256i vDiff = _mm256_sub_epi16( _mm256_loadu_si256( (const __m256i*)( piOrg + n ) ), _mm256_loadu_si256( (const __m256i*)( piCur + n ) ) );
+      vSum = _mm256_add_epi32( vSum, xSquareAVX2( vDiff, uiShift ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return xHorizontalSumAVX2( vSum );
+}
+
+/// xGetSADx4 loading each original row once for the four positions
+SIMD_TARGET_SSE41 Void TComRdCost::xGetSADx4SSE41( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum )
+{
+  // weighted and odd width blocks, the generic SAD does not subsample the rows
+  if ( pcDtParam->bApplyWeight || ( pcDtParam->iCols & 3 ) || pcDtParam->DistFunc == TComRdCost::xGetSAD )
+  {
+    xGetSADx4( pcDtParam, ppiCur, puiSum );
+    return;
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = pcDtParam->iCols;
+  Int  iSubShift  = pcDtParam->iSubShift;
+  Int  iSubStep   = ( 1 << iSubShift );
+  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+  Int  iOffset    = 0;
+
+  const __m128i vOne = _mm_set1_epi16( 1 );
+  __m128i avSum[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    Int n = 0;
+    for ( ; n + 8 <= iCols; n += 8 )
+    {
+      __m128i vOrg = _mm_loadu_si128( (const __m128i*)( piOrg + n ) );
+      for ( Int k = 0; k < 4; k++ )
+      {
+        __m128i vDiff = _mm_sub_epi16( vOrg, _mm_loadu_si128( (const __m128i*)( ppiCur[k] + iOffset + n ) ) );
+        avSum[k] = _mm_add_epi32( avSum[k], _mm_madd_epi16( _mm_abs_epi16( vDiff ), vOne ) );
+      }
+    }
+    if ( iCols & 4 )
+    {
+      __m128i vOrg = _mm_loadl_epi64( (const __m128i*)( piOrg + n ) );
+      for ( Int k = 0; k < 4; k++ )
+      {
+        __m128i vDiff = _mm_sub_epi16( vOrg, _mm_loadl_epi64( (const __m128i*)( ppiCur[k] + iOffset + n ) ) );
+        avSum[k] = _mm_add_epi32( avSum[k], _mm_madd_epi16( _mm_abs_epi16( vDiff ), vOne ) );
+      }
+    }
+    piOrg   += iStrideOrg;
+    iOffset += iStrideCur;
+  }
+
+  // one lane per position
+  __m128i vSum = _mm_hadd_epi32( _mm_hadd_epi32( avSum[0], avSum[1] ), _mm_hadd_epi32( avSum[2], avSum[3] ) );
+  vSum = _mm_sll_epi32( vSum, _mm_cvtsi32_si128( iSubShift ) );
+  vSum = _mm_srl_epi32( vSum, _mm_cvtsi32_si128( DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) ) );
+  _mm_storeu_si128( (__m128i*)puiSum, vSum );
+}
+
+SIMD_TARGET_AVX2 Void TComRdCost::xGetSADx4AVX2( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum )
+{
+  if ( ( pcDtParam->iCols & 15 ) != 0 )
+  {
+    xGetSADx4SSE41( pcDtParam, ppiCur, puiSum );
+    return;
+  }
+  if ( pcDtParam->bApplyWeight || pcDtParam->DistFunc == TComRdCost::xGetSAD )
+  {
+    xGetSADx4( pcDtParam, ppiCur, puiSum );
+    return;
+  }
+  Pel* piOrg      = pcDtParam->pOrg;
+  Int  iRows      = pcDtParam->iRows;
+  Int  iCols      = pcDtParam->iCols;
+  Int  iSubShift  = pcDtParam->iSubShift;
+  Int  iSubStep   = ( 1 << iSubShift );
+  Int  iStrideCur = pcDtParam->iStrideCur*iSubStep;
+  Int  iStrideOrg = pcDtParam->iStrideOrg*iSubStep;
+  Int  iOffset    = 0;
+
+  const __m256i vOne = _mm256_set1_epi16( 1 );
+  __m256i avSum[4] = { _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256() };
+
+  for( ; iRows != 0; iRows-=iSubStep )
+  {
+    for ( Int n = 0; n < iCols; n += 16 )
+    {
+      __m256i vOrg = _mm256_loadu_si256( (const __m256i*)( piOrg + n ) );
+      for ( Int k = 0; k < 4; k++ )
+      {
+        __m256i vDiff = _mm256_sub_epi16( vOrg, _mm256_loadu_si256( (const __m256i*)( ppiCur[k] + iOffset + n ) ) );
+        avSum[k] = _mm256_add_epi32( avSum[k], _mm256_madd_epi16( _mm256_abs_epi16( vDiff ), vOne ) );
+      }
+    }
+    piOrg   += iStrideOrg;
+    iOffset += iStrideCur;
+  }
+
+  // one lane per position
+  __m256i vSum256 = _mm256_hadd_epi32( _mm256_hadd_epi32( avSum[0], avSum[1] ), _mm256_hadd_epi32( avSum[2], avSum[3] ) );
+  __m128i vSum    = _mm_add_epi32( _mm256_castsi256_si128( vSum256 ), _mm256_extracti128_si256( vSum256, 1 ) );
+  vSum = _mm_sll_epi32( vSum, _mm_cvtsi32_si128( iSubShift ) );
+  vSum = _mm_srl_epi32( vSum, _mm_cvtsi32_si128( DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8) ) );
+  _mm_storeu_si128( (__m128i*)puiSum, vSum );
+}
+
+/// four-point Hadamard transform across four registers, the outputs are in a different order than in the C kernels
+SIMD_TARGET_SSE41 static inline Void xHadamard4SSE41( __m128i* pv )
+{
+  __m128i v0 = _mm_add_epi32( pv[0], pv[1] );
+  __m128i v1 = _mm_sub_epi32( pv[0], pv[1] );
+  __m128i v2 = _mm_add_epi32( pv[2], pv[3] );
+  __m128i v3 = _mm_sub_epi32( pv[2], pv[3] );
+  pv[0] = _mm_add_epi32( v0, v2 );
+  pv[1] = _mm_add_epi32( v1, v3 );
+  pv[2] = _mm_sub_epi32( v0, v2 );
+  pv[3] = _mm_sub_epi32( v1, v3 );
+}
+
+SIMD_TARGET_SSE41 static inline Void xHadamard8SSE41( __m128i* pv )
+{
+  xHadamard4SSE41( pv );
+  xHadamard4SSE41( pv + 4 );
+  for ( Int k = 0; k < 4; k++ )
+  {
+    __m128i v = pv[k];
+    pv[k  ] = _mm_add_epi32( v, pv[k+4] );
+    pv[k+4] = _mm_sub_epi32( v, pv[k+4] );
+  }
+}
+
+SIMD_TARGET_SSE41 static inline Void xTranspose4x4SSE41( const __m128i* pvSrc, __m128i* pvDst )
+{
+  __m128i v0 = _mm_unpacklo_epi32( pvSrc[0], pvSrc[1] );
+  __m128i v1 = _mm_unpacklo_epi32( pvSrc[2], pvSrc[3] );
+  __m128i v2 = _mm_unpackhi_epi32( pvSrc[0], pvSrc[1] );
+  __m128i v3 = _mm_unpackhi_epi32( pvSrc[2], pvSrc[3] );
+  pvDst[0] = _mm_unpacklo_epi64( v0, v1 );
+  pvDst[1] = _mm_unpackhi_epi64( v0, v1 );
+  pvDst[2] = _mm_unpacklo_epi64( v2, v3 );
+  pvDst[3] = _mm_unpackhi_epi64( v2, v3 );
+}
+
+/// differences of four samples in 32-bit lanes
+SIMD_TARGET_SSE41 static inline __m128i xDiff4SSE41( const Pel* piOrg, const Pel* piCur )
+{
+  return _mm_sub_epi32( _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)piOrg ) ), _mm_cvtepi16_epi32( _mm_loadl_epi64( (const __m128i*)piCur ) ) );
+}
+
+// The absolute sum of a Hadamard transform does not depend on the order of its outputs, the SIMD kernels transform the
+// columns first and then the rows of the transposed block.
+
+SIMD_TARGET_SSE41 UInt TComRdCost::xCalcHADs4x4SSE41( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+{
+  __m128i av[4];
+
+  assert( iStep == 1 );
+  for ( Int k = 0; k < 4; k++ )
+  {
+    av[k] = xDiff4SSE41( piOrg + k*iStrideOrg, piCur + k*iStrideCur );
+  }
+  xHadamard4SSE41( av );
+  xTranspose4x4SSE41( av, av );
+  xHadamard4SSE41( av );
+
+  __m128i vSum = _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( av[0] ), _mm_abs_epi32( av[1] ) ), _mm_add_epi32( _mm_abs_epi32( av[2] ), _mm_abs_epi32( av[3] ) ) );
+  UInt satd = xHorizontalSumSSE41( vSum );
+
+  return ( satd + 1 ) >> 1;
+}
+
+SIMD_TARGET_SSE41 UInt TComRdCost::xCalcHADs8x8SSE41( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+{
+  __m128i avLeft[8], avRight[8], avColLeft[8], avColRight[8];
+
+  assert( iStep == 1 );
+  for ( Int k = 0; k < 8; k++ )
+  {
+    avLeft [k] = xDiff4SSE41( piOrg + k*iStrideOrg,     piCur + k*iStrideCur     );
+    avRight[k] = xDiff4SSE41( piOrg + k*iStrideOrg + 4, piCur + k*iStrideCur + 4 );
+  }
+  xHadamard8SSE41( avLeft  );
+  xHadamard8SSE41( avRight );
+
+  // rows 0..3 of the transposed block come from the left half, rows 4..7 from the right half
+  xTranspose4x4SSE41( avLeft,      avColLeft      );
+  xTranspose4x4SSE41( avRight,     avColLeft  + 4 );
+  xTranspose4x4SSE41( avLeft  + 4, avColRight     );
+  xTranspose4x4SSE41( avRight + 4, avColRight + 4 );
+  xHadamard8SSE41( avColLeft  );
+  xHadamard8SSE41( avColRight );
+
+  __m128i vSum = _mm_setzero_si128();
+  for ( Int k = 0; k < 8; k++ )
+  {
+    vSum = _mm_add_epi32( vSum, _mm_add_epi32( _mm_abs_epi32( avColLeft[k] ), _mm_abs_epi32( avColRight[k] ) ) );
+  }
+  UInt sad = xHorizontalSumSSE41( vSum );
+
+  return ( sad + 2 ) >> 2;
+}
+
+SIMD_TARGET_AVX2 static inline Void xHadamard8AVX2( __m256i* pv )
+{
+  for ( Int iHalf = 1; iHalf < 8; iHalf <<= 1 )
+  {
+    for ( Int k = 0; k < 8; k++ )
+    {
+      if ( ( k & iHalf ) == 0 )
+      {
+        __m256i v = pv[k];
+        pv[k        ] = _mm256_add_epi32( v, pv[k+iHalf] );
+        pv[k+iHalf  ] = _mm256_sub_epi32( v, pv[k+iHalf] );
+      }
+    }
+  }
+}
+
+SIMD_TARGET_AVX2 UInt TComRdCost::xCalcHADs8x8AVX2( Pel *piOrg, Pel *piCur, Int iStrideOrg, Int iStrideCur, Int iStep )
+{
+  __m256i av[8], avLo[8], avHi[8];
+
+  assert( iStep == 1 );
+  for ( Int k = 0; k < 8; k++ )
+  {
+    av[k] = _mm256_sub_epi32( _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)( piOrg + k*iStrideOrg ) ) ),
+                              _mm256_cvtepi16_epi32( _mm_loadu_si128( (const __m128i*)( piCur + k*iStrideCur ) ) ) );
+  }
+  xHadamard8AVX2( av );
+
+  // transpose the 8x8 block of 32-bit lanes
+  for ( Int k = 0; k < 8; k += 2 )
+  {
+    avLo[k  ] = _mm256_unpacklo_epi32( av[k], av[k+1] );
+    avLo[k+1] = _mm256_unpackhi_epi32( av[k], av[k+1] );
+  }
+  for ( Int k = 0; k < 8; k += 4 )
+  {
+    avHi[k  ] = _mm256_unpacklo_epi64( avLo[k  ], avLo[k+2] );
+    avHi[k+1] = _mm256_unpackhi_epi64( avLo[k  ], avLo[k+2] );
+    avHi[k+2] = _mm256_unpacklo_epi64( avLo[k+1], avLo[k+3] );
+    avHi[k+3] = _mm256_unpackhi_epi64( avLo[k+1], avLo[k+3] );
+  }
+  for ( Int k = 0; k < 4; k++ )
+  {
+    av[k  ] = _mm256_permute2x128_si256( avHi[k], avHi[k+4], 0x20 );
+    av[k+4] = _mm256_permute2x128_si256( avHi[k], avHi[k+4], 0x31 );
+  }
+  xHadamard8AVX2( av );
+
+  __m256i vSum = _mm256_setzero_si256();
+  for ( Int k = 0; k < 8; k++ )
+  {
+    vSum = _mm256_add_epi32( vSum, _mm256_abs_epi32( av[k] ) );
+  }
+  UInt sad = xHorizontalSumAVX2( vSum );
+
+  return ( sad + 2 ) >> 2;
+}
+
+template <Int iSimdLevel>
+UInt TComRdCost::xGetHADsSIMD( DistParam* pcDtParam )
+{
+  Int  iRows   = pcDtParam->iRows;
+  Int  iCols   = pcDtParam->iCols;
+  if ( pcDtParam->bApplyWeight || ( iRows % 4 != 0 ) || ( iCols % 4 != 0 ) )
+  {
+    return xGetHADs( pcDtParam );
+  }
+  Pel* piOrg   = pcDtParam->pOrg;
+  Pel* piCur   = pcDtParam->pCur;
+  Int  iStrideCur = pcDtParam->iStrideCur;
+  Int  iStrideOrg = pcDtParam->iStrideOrg;
+  Int  iStep  = pcDtParam->iStep;
+
+  Int  x, y;
+
+  UInt uiSum = 0;
+
+  if( ( iRows % 8 == 0) && (iCols % 8 == 0) )
+  {
+    Int  iOffsetOrg = iStrideOrg<<3;
+    Int  iOffsetCur = iStrideCur<<3;
+    for ( y=0; y<iRows; y+= 8 )
+    {
+      for ( x=0; x<iCols; x+= 8 )
+      {
+        uiSum += iSimdLevel == SIMD_AVX2 ? xCalcHADs8x8AVX2 ( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep )
+                                         : xCalcHADs8x8SSE41( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+  else
+  {
+    Int  iOffsetOrg = iStrideOrg<<2;
+    Int  iOffsetCur = iStrideCur<<2;
+
+    for ( y=0; y<iRows; y+= 4 )
+    {
+      for ( x=0; x<iCols; x+= 4 )
+      {
+        uiSum += xCalcHADs4x4SSE41( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur, iStep );
+      }
+      piOrg += iOffsetOrg;
+      piCur += iOffsetCur;
+    }
+  }
+
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(pcDtParam->bitDepth-8);
+}
+
+/** Replace the C distortion functions by the SIMD kernels of the CPU
+ * The generic SAD/SSE (odd widths) and the 2x2 Hadamard blocks keep their C kernels.
+ */
+Void TComRdCost::xInitSimdDistortFunc()
+{
+  SimdLevel eLevel = getSimdLevel();
+  if ( eLevel == SIMD_NONE )
+  {
+    return;
+  }
+
+  m_afpDistortFunc[2]  = TComRdCost::xGetSSESSE41<4>;
+  m_afpDistortFunc[3]  = TComRdCost::xGetSSESSE41<8>;
+  m_afpDistortFunc[9]  = TComRdCost::xGetSADSSE41<4>;
+  m_afpDistortFunc[10] = TComRdCost::xGetSADSSE41<8>;
+#if AMP_SAD
+  m_afpDistortFunc[43] = TComRdCost::xGetSADSSE41<12>;
+#endif
+  m_pfCalcHADs4x4      = TComRdCost::xCalcHADs4x4SSE41;
+  m_pfDistFuncX4       = TComRdCost::xGetSADx4SSE41;
+
+  if ( eLevel == SIMD_AVX2 )
+  {
+    m_afpDistortFunc[4]  = TComRdCost::xGetSSEAVX2<16>;
+    m_afpDistortFunc[5]  = TComRdCost::xGetSSEAVX2<32>;
+    m_afpDistortFunc[6]  = TComRdCost::xGetSSEAVX2<64>;
+    m_afpDistortFunc[7]  = TComRdCost::xGetSSEAVX2<0>;
+    m_afpDistortFunc[11] = TComRdCost::xGetSADAVX2<16>;
+    m_afpDistortFunc[12] = TComRdCost::xGetSADAVX2<32>;
+    m_afpDistortFunc[13] = TComRdCost::xGetSADAVX2<64>;
+    m_afpDistortFunc[14] = TComRdCost::xGetSADAVX2<0>;
+#if AMP_SAD
+    m_afpDistortFunc[44] = TComRdCost::xGetSADAVX2<24>;
+    m_afpDistortFunc[45] = TComRdCost::xGetSADAVX2<48>;
+#endif
+    m_pfCalcHADs8x8      = TComRdCost::xCalcHADs8x8AVX2;
+    m_pfDistFuncX4       = TComRdCost::xGetSADx4AVX2;
+    m_afpDistortFunc[22] = TComRdCost::xGetHADsSIMD<SIMD_AVX2>;
+  }
+  else
+  {
+    m_afpDistortFunc[4]  = TComRdCost::xGetSSESSE41<16>;
+    m_afpDistortFunc[5]  = TComRdCost::xGetSSESSE41<32>;
+    m_afpDistortFunc[6]  = TComRdCost::xGetSSESSE41<64>;
+    m_afpDistortFunc[7]  = TComRdCost::xGetSSESSE41<0>;
+    m_afpDistortFunc[11] = TComRdCost::xGetSADSSE41<16>;
+    m_afpDistortFunc[12] = TComRdCost::xGetSADSSE41<32>;
+    m_afpDistortFunc[13] = TComRdCost::xGetSADSSE41<64>;
+    m_afpDistortFunc[14] = TComRdCost::xGetSADSSE41<0>;
+#if AMP_SAD
+    m_afpDistortFunc[44] = TComRdCost::xGetSADSSE41<24>;
+    m_afpDistortFunc[45] = TComRdCost::xGetSADSSE41<48>;
+#endif
+    m_pfCalcHADs8x8      = TComRdCost::xCalcHADs8x8SSE41;
+    m_afpDistortFunc[22] = TComRdCost::xGetHADsSIMD<SIMD_SSE41>;
+  }
+
+  // the SADS and the Hadamard entries share the kernels of DF_SAD and DF_HADS
+  for ( Int i = 1; i < 7; i++ )
+  {
+    m_afpDistortFunc[15+i] = m_afpDistortFunc[8+i];
+    m_afpDistortFunc[22+i] = m_afpDistortFunc[22];
+  }
+#if AMP_SAD
+  m_afpDistortFunc[46] = m_afpDistortFunc[43];
+  m_afpDistortFunc[47] = m_afpDistortFunc[44];
+  m_afpDistortFunc[48] = m_afpDistortFunc[45];
+#endif
+}
+#endif
+
 //! \}
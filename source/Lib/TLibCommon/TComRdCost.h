@@ -45,6 +45,7 @@
 
 #include "TComSlice.h"
 #include "TComRdCostWeightPrediction.h"
+#include "TComSimd.h"
 
 //! \ingroup TLibCommon
 //! \{
@@ -60,6 +61,8 @@ class TComPattern;
 
 // for function pointer
 typedef UInt (*FpDistFunc) (DistParam*);
+typedef UInt (*FpCalcHADs) (Pel*, Pel*, Int, Int, Int);
+typedef Void (*FpDistFuncX4) (DistParam*, Pel* const*, UInt*);
 
 // ====================================================================================================================
 // Class definition
@@ -77,6 +80,7 @@ public:
   Int   iCols;
   Int   iStep;
   FpDistFunc DistFunc;
+  FpDistFuncX4 DistFuncX4;          ///< DistFunc at four reference positions, set for the integer ME only
   Int   bitDepth;
 
   Bool            bApplyWeight;     // whether weithed prediction is used or not
@@ -86,6 +90,12 @@ public:
   // (vertical) subsampling shift (for reducing complexity)
   // - 0 = no subsampling, 1 = even rows, 2 = every 4th, etc.
   Int   iSubShift;
+
+#if IT_GT
+  // distortion above which the caller discards the block (MAX_UINT = no bound)
+  // only TComPrediction::GTWarpDistortion stops early once it is exceeded, the DistFunc of TComRdCost ignore it
+  UInt  uiMaxCost;
+#endif
   
   DistParam()
   {
@@ -97,8 +107,12 @@ public:
     iCols = 0;
     iStep = 1;
     DistFunc = NULL;
+    DistFuncX4 = NULL;
     iSubShift = 0;
     bitDepth = 0;
+#if IT_GT
+    uiMaxCost = MAX_UINT;
+#endif
   }
 };
 
@@ -114,6 +128,9 @@ private:
 #else  
   FpDistFunc              m_afpDistortFunc[33]; // [eDFunc]
 #endif  
+  FpCalcHADs              m_pfCalcHADs4x4;      ///< Hadamard kernels of calcHAD
+  FpCalcHADs              m_pfCalcHADs8x8;
+  FpDistFuncX4            m_pfDistFuncX4;       ///< batched SAD of the integer ME
   
   Double                  m_cbDistortionWeight;
   Double                  m_crDistortionWeight; 
@@ -137,6 +154,10 @@ private:
 #if !FIX203
   Int                     m_iSearchLimit;
 #endif
+#if IT_GT
+  Bool                    m_bGTAffine;        ///< the fourth GT corner is derived from the other three
+  Int                     m_iGTMaxIteration;  ///< number of halvings of the GT corner step
+#endif
   
 public:
   TComRdCost();
@@ -182,6 +203,10 @@ public:
 #endif
   }
   Void    setCostScale( Int iCostScale )    { m_iCostScale = iCostScale; }
+#if IT_GT
+  Void    setGTAffine ( Bool bGTAffine )    { m_bGTAffine = bGTAffine; }
+  Void    setGTMaxIteration( Int i )        { m_iGTMaxIteration = i; }
+#endif
   __inline UInt getCost( Int x, Int y )
   {
 #if FIX203
@@ -205,21 +230,18 @@ public:
   UInt    getBitsGT( Int xGT0, Int yGT0, Int xGT1, Int yGT1, Int xGT2, Int yGT2, Int xGT3, Int yGT3 )
 #if IT_GT_CODING == 0
   {
-  	  return W_GT*(xGetComponentBits(xGT0) + xGetComponentBits(yGT0)
-  		   + xGetComponentBits(xGT1) + xGetComponentBits(yGT1)
-		   + xGetComponentBits(xGT2) + xGetComponentBits(yGT2)
-#if !IT_GT_AFFINE
-		   + xGetComponentBits(xGT3) + xGetComponentBits(yGT3)
-#endif
-		   );
+  	  UInt uiBits = xGetComponentBits(xGT0) + xGetComponentBits(yGT0)
+  		          + xGetComponentBits(xGT1) + xGetComponentBits(yGT1)
+		          + xGetComponentBits(xGT2) + xGetComponentBits(yGT2);
+	  if ( !m_bGTAffine )
+	  {
+		  uiBits += xGetComponentBits(xGT3) + xGetComponentBits(yGT3);
+	  }
+	  return W_GT*uiBits;
 #endif
 #if IT_GT_CODING == 1
     {
-#if !IT_GT_AFFINE
-	  UInt numBits = 4; // index C = (0,0) * 4
-#else
-	  UInt numBits = 3; // index C = (0,0) * 3
-#endif
+	  UInt numBits = m_bGTAffine ? 3 : 4; // index C = (0,0) of each coded corner
 
 	  if(xGT0 != 0 || yGT0 != 0)
 	  {
@@ -227,18 +249,20 @@ public:
 		  if(xGT0 != 0)
 		  {
 			  numBits++; // C0x signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(xGT0);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(xGT0);
+				  numBits --;
+			  }
 		  }
 		  if(yGT0 != 0)
 		  {
 			  numBits++; // C0y signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(yGT0);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(yGT0);
+				  numBits --;
+			  }
 		  }
 	  }
 	  if(xGT1 != 0 || yGT1 != 0)
@@ -247,18 +271,20 @@ public:
 		  if(xGT1 != 0)
 		  {
 			  numBits++; // C1x signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(xGT1);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(xGT1);
+				  numBits --;
+			  }
 		  }
 		  if(yGT1 != 0)
 		  {
 			  numBits++; // C1y signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(yGT1);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(yGT1);
+				  numBits --;
+			  }
 		  }
 	  }
 	  if(xGT2 != 0 || yGT2 != 0)
@@ -267,48 +293,48 @@ public:
 		  if(xGT2 != 0)
 		  {
 			  numBits++; // C2x signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(xGT2);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(xGT2);
+				  numBits --;
+			  }
 		  }
 		  if(yGT2 != 0)
 		  {
 			  numBits++; // C2y signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(yGT2);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(yGT2);
+				  numBits --;
+			  }
 		  }
 	  }
-#if !IT_GT_AFFINE
-	  if(xGT3 != 0 || yGT3 != 0)
+	  if(!m_bGTAffine && (xGT3 != 0 || yGT3 != 0))
 	  {
 		  numBits+=2; // index C3x & C3y
 		  if(xGT3 != 0)
 		  {
 			  numBits++; // C3x signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(xGT3);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(xGT3);
+				  numBits --;
+			  }
 		  }
 		  if(yGT3 != 0)
 		  {
 			  numBits++; // C3y signal
-#if IT_MAX_NSS_Iteration > 1
-			  numBits += xGetComponentBits(yGT3);
-			  numBits --;
-#endif
+			  if(m_iGTMaxIteration > 1)
+			  {
+				  numBits += xGetComponentBits(yGT3);
+				  numBits --;
+			  }
 		  }
-#endif
 	  }
 
-#endif
-
 #if IT_DEBUG
 	 // cout << xGT0 << " " << yGT0 << " / " << xGT1 << " " << yGT1 << " / " << xGT2 << " " << yGT2 << " / " << xGT3 << " " << yGT3 << " / " << numBits << endl;
-
+#endif
 
 	  return numBits*W_GT;
 #endif
@@ -339,6 +365,7 @@ private:
   static UInt xGetSAD48         ( DistParam* pcDtParam );
 
 #endif
+  static Void xGetSADx4         ( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum );
 
   static UInt xGetHADs4         ( DistParam* pcDtParam );
   static UInt xGetHADs8         ( DistParam* pcDtParam );
@@ -347,6 +374,27 @@ private:
   static UInt xCalcHADs4x4      ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   static UInt xCalcHADs8x8      ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
   
+#if SIMD_X86
+  // SIMD kernels, iWidth == 0 stands for any multiple of 16 (16N)
+  template <Int iWidth>
+  static UInt xGetSADSSE41      ( DistParam* pcDtParam );
+  template <Int iWidth>
+  static UInt xGetSADAVX2       ( DistParam* pcDtParam );
+  template <Int iWidth>
+  static UInt xGetSSESSE41      ( DistParam* pcDtParam );
+  template <Int iWidth>
+  static UInt xGetSSEAVX2       ( DistParam* pcDtParam );
+  template <Int iSimdLevel>
+  static UInt xGetHADsSIMD      ( DistParam* pcDtParam );
+  static UInt xCalcHADs4x4SSE41 ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
+  static UInt xCalcHADs8x8SSE41 ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
+  static UInt xCalcHADs8x8AVX2  ( Pel *piOrg, Pel *piCurr, Int iStrideOrg, Int iStrideCur, Int iStep );
+  static Void xGetSADx4SSE41    ( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum );
+  static Void xGetSADx4AVX2     ( DistParam* pcDtParam, Pel* const* ppiCur, UInt* puiSum );
+  
+  Void        xInitSimdDistortFunc();
+#endif
+  
 public:
   UInt   getDistPart(Int bitDepth, Pel* piCur, Int iCurStride,  Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, TextType eText = TEXT_LUMA, DFunc eDFunc = DF_SSE );
 
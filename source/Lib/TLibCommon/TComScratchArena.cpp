@@ -0,0 +1,81 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComScratchArena.cpp
+    \brief    scratch memory arena for short-lived buffers
+*/
+
+#include <stdlib.h>
+#include "TComScratchArena.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+TComScratchArena::TComScratchArena()
+: m_pucMem( NULL )
+, m_pucBuf( NULL )
+, m_uiSize( 0 )
+, m_uiUsed( 0 )
+{
+}
+
+TComScratchArena::~TComScratchArena()
+{
+  destroy();
+}
+
+/** Allocate the arena
+ * \param uiSize size in bytes, the alignment of the buffers taken from the arena must be included
+ */
+Void TComScratchArena::create( UInt uiSize )
+{
+  destroy();
+  m_pucMem = (UChar*)malloc( uiSize + ALIGNMENT );
+  m_pucBuf = (UChar*)( ( (size_t)m_pucMem + ALIGNMENT - 1 ) & ~(size_t)( ALIGNMENT - 1 ) );
+  m_uiSize = m_pucMem ? uiSize : 0;
+  m_uiUsed = 0;
+}
+
+Void TComScratchArena::destroy()
+{
+  if ( m_pucMem )
+  {
+    free( m_pucMem );
+    m_pucMem = NULL;
+    m_pucBuf = NULL;
+  }
+  m_uiSize = 0;
+  m_uiUsed = 0;
+}
+
+//! \}
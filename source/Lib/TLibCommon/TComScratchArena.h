@@ -0,0 +1,100 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComScratchArena.h
+    \brief    scratch memory arena for short-lived buffers (header)
+*/
+
+#ifndef __TCOMSCRATCHARENA__
+#define __TCOMSCRATCHARENA__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "CommonDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// memory arena allocated once, its buffers are taken in stack order and returned with release()
+class TComScratchArena
+{
+private:
+  UChar* m_pucMem;      ///< allocated memory
+  UChar* m_pucBuf;      ///< first aligned byte of m_pucMem
+  UInt   m_uiSize;      ///< usable size in bytes
+  UInt   m_uiUsed;      ///< bytes in use
+
+public:
+  static const UInt ALIGNMENT = 32; ///< alignment of every buffer, in bytes
+
+  TComScratchArena();
+  ~TComScratchArena();
+
+  Void create ( UInt uiSize );
+  Void destroy();
+
+  /// mark to be passed to release() to return every buffer taken after this call
+  UInt getMark() const           { return m_uiUsed; }
+  Void release( UInt uiMark )
+  {
+    if ( uiMark > m_uiUsed )
+    {
+      FATAL_ERROR_0( "TComScratchArena: release() past the buffers in use\n", EXIT_FAILURE );
+    }
+    m_uiUsed = uiMark;
+  }
+
+  /** Take an aligned buffer from the arena, exits when the arena is too small
+   * \param uiNum number of elements of the buffer
+   */
+  template <typename T>
+  T*   alloc( UInt uiNum )
+  {
+    size_t uiStart = ( (size_t)m_uiUsed + ALIGNMENT - 1 ) & ~(size_t)( ALIGNMENT - 1 );
+    size_t uiEnd   = uiStart + (size_t)uiNum * sizeof(T);
+    if ( uiEnd > m_uiSize )
+    {
+      FATAL_ERROR_0( "TComScratchArena: arena too small\n", EXIT_FAILURE );
+    }
+    m_uiUsed = (UInt)uiEnd;
+    return (T*)( m_pucBuf + uiStart );
+  }
+};
+
+//! \}
+
+#endif // __TCOMSCRATCHARENA__
@@ -0,0 +1,126 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    run-time detection of the SIMD instruction set extensions
+*/
+
+#include "TComSimd.h"
+
+#if SIMD_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_X86
+/** Execute CPUID
+ * \param uiLeaf    function (EAX)
+ * \param uiSubLeaf sub-function (ECX)
+ * \param auiReg    returned EAX, EBX, ECX and EDX
+ */
+static Void xCpuId( UInt uiLeaf, UInt uiSubLeaf, UInt auiReg[4] )
+{
+#if defined(_MSC_VER)
+  Int aiReg[4];
+  __cpuidex( aiReg, (Int)uiLeaf, (Int)uiSubLeaf );
+  for ( Int k = 0; k < 4; k++ )
+  {
+    auiReg[k] = (UInt)aiReg[k];
+  }
+#else
+  __cpuid_count( uiLeaf, uiSubLeaf, auiReg[0], auiReg[1], auiReg[2], auiReg[3] );
+#endif
+}
+
+/** Read the extended control register XCR0, i.e. the register states saved by the operating system
+ */
+static UInt64 xGetXCR0()
+{
+#if defined(_MSC_VER)
+  return _xgetbv( 0 );
+#else
+  UInt uiLo, uiHi;
+  __asm__ __volatile__ ( "xgetbv" : "=a" (uiLo), "=d" (uiHi) : "c" (0) );
+  return ( (UInt64)uiHi << 32 ) | uiLo;
+#endif
+}
+
+static SimdLevel xDetectSimdLevel()
+{
+  UInt auiReg[4];
+
+  xCpuId( 0, 0, auiReg );
+  UInt uiMaxLeaf = auiReg[0];
+  if ( uiMaxLeaf < 1 )
+  {
+    return SIMD_NONE;
+  }
+
+  xCpuId( 1, 0, auiReg );
+  Bool bSSE41   = ( auiReg[2] & ( 1 << 19 ) ) != 0;
+  Bool bOSXSAVE = ( auiReg[2] & ( 1 << 27 ) ) != 0;
+  Bool bAVX     = ( auiReg[2] & ( 1 << 28 ) ) != 0;
+  if ( !bSSE41 )
+  {
+    return SIMD_NONE;
+  }
+
+  // AVX2 also needs the operating system to save the XMM and YMM registers
+  if ( uiMaxLeaf < 7 || !bOSXSAVE || !bAVX || ( xGetXCR0() & 6 ) != 6 )
+  {
+    return SIMD_SSE41;
+  }
+
+  xCpuId( 7, 0, auiReg );
+  Bool bAVX2 = ( auiReg[1] & ( 1 << 5 ) ) != 0;
+  return bAVX2 ? SIMD_AVX2 : SIMD_SSE41;
+}
+#endif
+
+SimdLevel getSimdLevel()
+{
+#if SIMD_X86
+  static const SimdLevel s_eSimdLevel = xDetectSimdLevel();
+  return s_eSimdLevel;
+#else
+  return SIMD_NONE;
+#endif
+}
+
+//! \}
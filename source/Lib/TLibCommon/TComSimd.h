@@ -0,0 +1,85 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.h
+    \brief    run-time detection of the SIMD instruction set extensions (header)
+*/
+
+#ifndef __TCOMSIMD__
+#define __TCOMSIMD__
+
+#include "TypeDef.h"
+
+//! \ingroup TLibCommon
+//! \{
+
+#if SIMD_KERNELS && ( defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86) )
+#define SIMD_X86                1
+#else
+#define SIMD_X86                0
+#endif
+
+#if SIMD_X86
+#include <immintrin.h>
+// the kernels are compiled for their own target, the rest of the code keeps the default instruction set
+#if defined(__GNUC__)
+#define SIMD_TARGET_SSE41       __attribute__((target("sse4.1")))
+#define SIMD_TARGET_AVX2        __attribute__((target("avx2")))
+#else
+#define SIMD_TARGET_SSE41
+#define SIMD_TARGET_AVX2
+#endif
+#endif
+
+// ====================================================================================================================
+// Type definition
+// ====================================================================================================================
+
+/// instruction set extensions used by the SIMD kernels, in increasing order
+enum SimdLevel
+{
+  SIMD_NONE  = 0,   ///< C kernels only
+  SIMD_SSE41 = 1,   ///< SSE2 to SSE4.1
+  SIMD_AVX2  = 2    ///< AVX2 (256-bit integer vectors and gathers)
+};
+
+// ====================================================================================================================
+// Function definition
+// ====================================================================================================================
+
+/// highest extension supported by both the CPU and the operating system, detected once
+SimdLevel getSimdLevel();
+
+//! \}
+
+#endif // __TCOMSIMD__
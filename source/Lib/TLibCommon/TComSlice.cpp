@@ -150,6 +150,11 @@ Void TComSlice::initSlice()
   m_bUseMIMergeCand = false;
   m_iMicroImSize = 0;
 #endif
+#if IT_GT
+  m_bGTAffineFlag   = IT_GT_AFFINE;
+  m_iGTMaxIteration = IT_MAX_NSS_Iteration;
+  m_iGTInterpFilter = IT_GT_Interpolation_Filter;
+#endif
 
   m_bFinalized=false;
 
@@ -248,9 +253,10 @@ TComPic* TComSlice::xGetRefPic (  TComList<TComPic*>& rcListPic,
     if ( !pcPic->getSlice(pcPic->getCurrSliceIdx())->isScalableSlice() )
 #endif // IT_SCALABLE_V1
     {
-      // Using the Self-Similarity Reference
-      pcPic->getPicYuvRec()->copyToPic(rcSSRef->getPicYuvRec()); // URGENTE: Acho que no preciso fazer essa copia!!
+      // Using the Self-Similarity Reference: nothing is reconstructed yet. The whole picture is
+      // overwritten, so the current picture does not need to be copied first.
       rcSSRef->getPicYuvRec()->setPicPel( NOT_VALID );
+      rcSSRef->getPicYuvRec()->resetSSValid();
     }
     return  rcSSRef;
   }
@@ -840,6 +846,11 @@ Void TComSlice::copySliceInfo(TComSlice *pSrc)
   m_bUseMIMergeCand               = pSrc->m_bUseMIMergeCand;
   m_iMicroImSize                  = pSrc->m_iMicroImSize;
 #endif
+#if IT_GT
+  m_bGTAffineFlag                 = pSrc->m_bGTAffineFlag;
+  m_iGTMaxIteration               = pSrc->m_iGTMaxIteration;
+  m_iGTInterpFilter               = pSrc->m_iGTInterpFilter;
+#endif
 }
 
 Int TComSlice::m_prevTid0POC = 0;
@@ -1592,6 +1603,12 @@ TComVPS::TComVPS()
 #if IT_HOLOSS
 , m_vpsHoloExtensionFlag      (false)
 , m_vpsHoloMIsize             (  0)
+#if IT_GT
+, m_vpsHoloGTAffineFlag       (IT_GT_AFFINE)
+, m_vpsHoloGTMaxIteration     (IT_MAX_NSS_Iteration)
+, m_vpsHoloGTInterpFilter     (IT_GT_Interpolation_Filter)
+, m_vpsHoloGTFixedPointWarpFlag (IT_GT_FIXED_POINT_WARP == 1)
+#endif
 #endif
 {
   for( Int i = 0; i < MAX_TLAYER; i++)
@@ -417,6 +417,12 @@ private:
 #if IT_HOLOSS
   Bool        m_vpsHoloExtensionFlag;                ///< vps_holo_extension_flag
   UInt        m_vpsHoloMIsize;                    ///< vps_holo_microimage_size (quarter-pel precision)
+#if IT_GT
+  Bool        m_vpsHoloGTAffineFlag;              ///< vps_holo_gt_affine_flag, the fourth GT corner is derived from the other three
+  UInt        m_vpsHoloGTMaxIteration;            ///< vps_holo_gt_max_iteration, number of halvings of the GT corner step
+  UInt        m_vpsHoloGTInterpFilter;            ///< vps_holo_gt_interp_filter (0: bilinear, 1: nearest, 2: DCT-IF)
+  Bool        m_vpsHoloGTFixedPointWarpFlag;      ///< vps_holo_gt_fixed_point_warp_flag, GT samples of the fixed-point warp (IT_GT_FIXED_POINT_WARP)
+#endif
 #endif
 public:
   TComVPS();
@@ -474,6 +480,16 @@ public:
   Void        setVpsHoloExtensionFlag( Bool b ) { m_vpsHoloExtensionFlag = b; }
   UInt        getVpsHoloMIsize()  { return m_vpsHoloMIsize; }
   Void        setVpsHoloMIsize( UInt ui)  { m_vpsHoloMIsize = ui; }
+#if IT_GT
+  Bool        getVpsHoloGTAffineFlag()  { return m_vpsHoloGTAffineFlag; }
+  Void        setVpsHoloGTAffineFlag( Bool b )  { m_vpsHoloGTAffineFlag = b; }
+  UInt        getVpsHoloGTMaxIteration()  { return m_vpsHoloGTMaxIteration; }
+  Void        setVpsHoloGTMaxIteration( UInt ui )  { m_vpsHoloGTMaxIteration = ui; }
+  UInt        getVpsHoloGTInterpFilter()  { return m_vpsHoloGTInterpFilter; }
+  Void        setVpsHoloGTInterpFilter( UInt ui )  { m_vpsHoloGTInterpFilter = ui; }
+  Bool        getVpsHoloGTFixedPointWarpFlag()  { return m_vpsHoloGTFixedPointWarpFlag; }
+  Void        setVpsHoloGTFixedPointWarpFlag( Bool b )  { m_vpsHoloGTFixedPointWarpFlag = b; }
+#endif
 #endif
 };
 
@@ -1167,6 +1183,11 @@ private:
   Bool        m_bUseMIMergeCand;
   Int         m_iMicroImSize;
 #endif
+#if IT_GT
+  Bool        m_bGTAffineFlag;
+  Int         m_iGTMaxIteration;
+  Int         m_iGTInterpFilter;
+#endif
 
   Double      m_lambdas[3];
 
@@ -1379,6 +1400,14 @@ public:
   Void setMicroImSize                    ( Int u )          { m_iMicroImSize = u;         }
   Int  getMicroImSize                    ()                 { return  m_iMicroImSize; }
 #endif // IT_MI_MERGE_CANDIDATE
+#if IT_GT
+  Void setGTAffineFlag                   ( Bool b )         { m_bGTAffineFlag = b;        }
+  Bool getGTAffineFlag                   ()                 { return m_bGTAffineFlag;     }
+  Void setGTMaxIteration                 ( Int i )          { m_iGTMaxIteration = i;      }
+  Int  getGTMaxIteration                 ()                 { return m_iGTMaxIteration;   }
+  Void setGTInterpFilter                 ( Int i )          { m_iGTInterpFilter = i;      }
+  Int  getGTInterpFilter                 ()                 { return m_iGTInterpFilter;   }
+#endif
 #if SETTING_NO_OUT_PIC_PRIOR
   Void setNoOutputPriorPicsFlag              ( Bool val )         { m_noOutputPriorPicsFlag = val;                    }
   Bool getNoOutputPriorPicsFlag              ()                   { return m_noOutputPriorPicsFlag;                   }
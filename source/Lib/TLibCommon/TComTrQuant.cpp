@@ -41,6 +41,7 @@
 #include "TComTrQuant.h"
 #include "TComPic.h"
 #include "ContextTables.h"
+#include "TComSimd.h"
 
 typedef struct
 {
@@ -88,6 +89,7 @@ TComTrQuant::TComTrQuant()
   // allocate bit estimation class  (for RDOQ)
   m_pcEstBitsSbac = new estBitsSbacStruct;
   initScalingList();
+  xInitKernels();
 }
 
 TComTrQuant::~TComTrQuant()
@@ -862,6 +864,255 @@ void xITrMxN(Int bitDepth, Short *coeff,Short *block, Int iWidth, Int iHeight, U
   }
 }
 
+#if SIMD_X86
+// ====================================================================================================================
+// SIMD transforms
+// ====================================================================================================================
+
+// A partial butterfly gives the same integers as the multiplication by the full matrix, which the SIMD kernels compute
+// with 16-bit coefficients and 32-bit sums. The forward passes store the low 16 bits as the C assignment to Short does,
+// the inverse passes saturate as Clip3 does.
+
+/// transpose of an iSize x iSize block of Shorts
+template <Int iSize>
+SIMD_TARGET_SSE41 static inline Void xTransposeSSE41( const Short* piSrc, Short* piDst )
+{
+  if ( iSize == 4 )
+  {
+    __m128i v01 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( piSrc     ) ), _mm_loadl_epi64( (const __m128i*)( piSrc + 4 ) ) );
+    __m128i v23 = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)( piSrc + 8 ) ), _mm_loadl_epi64( (const __m128i*)( piSrc + 12 ) ) );
+    _mm_storeu_si128( (__m128i*)( piDst     ), _mm_unpacklo_epi32( v01, v23 ) );
+    _mm_storeu_si128( (__m128i*)( piDst + 8 ), _mm_unpackhi_epi32( v01, v23 ) );
+    return;
+  }
+  for ( Int y = 0; y < iSize; y += 8 )
+  {
+    for ( Int x = 0; x < iSize; x += 8 )
+    {
+      const Short* piIn = piSrc + y * iSize + x;
+      __m128i av[8], avTmp[8];
+      for ( Int k = 0; k < 8; k++ )
+      {
+        av[k] = _mm_loadu_si128( (const __m128i*)( piIn + k * iSize ) );
+      }
+      for ( Int k = 0; k < 4; k++ )
+      {
+        avTmp[k  ] = _mm_unpacklo_epi16( av[2*k], av[2*k+1] );
+        avTmp[k+4] = _mm_unpackhi_epi16( av[2*k], av[2*k+1] );
+      }
+      for ( Int k = 0; k < 8; k += 4 )
+      {
+        av[k  ] = _mm_unpacklo_epi32( avTmp[k  ], avTmp[k+1] );
+        av[k+1] = _mm_unpackhi_epi32( avTmp[k  ], avTmp[k+1] );
+        av[k+2] = _mm_unpacklo_epi32( avTmp[k+2], avTmp[k+3] );
+        av[k+3] = _mm_unpackhi_epi32( avTmp[k+2], avTmp[k+3] );
+      }
+      // columns 0,1 of rows 0..3 in av[0] and of rows 4..7 in av[2], columns 2,3 in av[1] and av[3], 4..7 in av[4..7]
+      Short* piOut = piDst + x * iSize + y;
+      for ( Int k = 0; k < 4; k++ )
+      {
+        Int b = k < 2 ? k : k + 2;
+        _mm_storeu_si128( (__m128i*)( piOut + ( 2*k   ) * iSize ), _mm_unpacklo_epi64( av[b], av[b+2] ) );
+        _mm_storeu_si128( (__m128i*)( piOut + ( 2*k+1 ) * iSize ), _mm_unpackhi_epi64( av[b], av[b+2] ) );
+      }
+    }
+  }
+}
+
+/// rounded results of eight 32-bit sums as Shorts
+template <Bool bClip>
+SIMD_TARGET_SSE41 static inline __m128i xTrPackSSE41( __m128i v0, __m128i v1, Int iShift )
+{
+  v0 = _mm_srai_epi32( v0, iShift );
+  v1 = _mm_srai_epi32( v1, iShift );
+  if ( bClip )
+  {
+    return _mm_packs_epi32( v0, v1 );
+  }
+  const __m128i vMask = _mm_set1_epi32( 0xffff );
+  return _mm_packus_epi32( _mm_and_si128( v0, vMask ), _mm_and_si128( v1, vMask ) );
+}
+
+/** One pass of a transform: piDst[k][j] = ( sum_n M[k][n] * piSrc[n][j] + rounding ) >> iShift
+ * \param piMat    matrix, M[k][n] = piMat[k*iStrideK + n*iStrideN]
+ * \param piSrc    iSize rows of iSize samples
+ * \param piDst    iSize rows of iSize results
+ * \param bClip    saturate (inverse) instead of keeping the low 16 bits (forward)
+ */
+template <Int iSize, Bool bClip>
+SIMD_TARGET_SSE41 static Void xTrPassSSE41( const Short* piMat, Int iStrideK, Int iStrideN, const Short* piSrc, Short* piDst, Int iShift )
+{
+  const Int iNumVec = ( iSize + 3 ) >> 2;
+  __m128i avPair[ iSize / 2 ][ iNumVec ];   // rows n and n+1 interleaved sample by sample
+
+  for ( Int n = 0; n < iSize; n += 2 )
+  {
+    const Short* piRow = piSrc + n * iSize;
+    if ( iSize == 4 )
+    {
+      avPair[n/2][0] = _mm_unpacklo_epi16( _mm_loadl_epi64( (const __m128i*)piRow ), _mm_loadl_epi64( (const __m128i*)( piRow + 4 ) ) );
+      continue;
+    }
+    for ( Int j = 0; j < iSize; j += 8 )
+    {
+      __m128i v0 = _mm_loadu_si128( (const __m128i*)( piRow + j ) );
+      __m128i v1 = _mm_loadu_si128( (const __m128i*)( piRow + iSize + j ) );
+      avPair[n/2][j/4  ] = _mm_unpacklo_epi16( v0, v1 );
+      avPair[n/2][j/4+1] = _mm_unpackhi_epi16( v0, v1 );
+    }
+  }
+
+  const __m128i vAdd = _mm_set1_epi32( 1 << ( iShift - 1 ) );
+  for ( Int k = 0; k < iSize; k++ )
+  {
+    __m128i avSum[ iNumVec ];
+    for ( Int v = 0; v < iNumVec; v++ )
+    {
+      avSum[v] = vAdd;
+    }
+    for ( Int n = 0; n < iSize; n += 2 )
+    {
+      UInt    uiCoef = (UShort)piMat[k*iStrideK + n*iStrideN] | ( (UInt)(UShort)piMat[k*iStrideK + (n+1)*iStrideN] << 16 );
+      __m128i vCoef  = _mm_set1_epi32( (Int)uiCoef );
+      for ( Int v = 0; v < iNumVec; v++ )
+      {
+        avSum[v] = _mm_add_epi32( avSum[v], _mm_madd_epi16( avPair[n/2][v], vCoef ) );
+      }
+    }
+    if ( iSize == 4 )
+    {
+      _mm_storel_epi64( (__m128i*)( piDst + k * iSize ), xTrPackSSE41<bClip>( avSum[0], avSum[0], iShift ) );
+      continue;
+    }
+    for ( Int v = 0; v < iNumVec; v += 2 )
+    {
+      _mm_storeu_si128( (__m128i*)( piDst + k * iSize + 4*v ), xTrPackSSE41<bClip>( avSum[v], avSum[v+1], iShift ) );
+    }
+  }
+}
+
+template <Int iSize, Bool bClip>
+SIMD_TARGET_AVX2 static Void xTrPassAVX2( const Short* piMat, Int iStrideK, Int iStrideN, const Short* piSrc, Short* piDst, Int iShift )
+{
+  const Int iNumVec = iSize >> 3;
+  Short aiPair[ iSize * iSize ];   // rows n and n+1 interleaved sample by sample
+
+  for ( Int n = 0; n < iSize; n += 2 )
+  {
+    const Short* piRow  = piSrc + n * iSize;
+    Short*       piPair = aiPair + n * iSize;
+    for ( Int j = 0; j < iSize; j += 8 )
+    {
+      __m128i v0 = _mm_loadu_si128( (const __m128i*)( piRow + j ) );
+      __m128i v1 = _mm_loadu_si128( (const __m128i*)( piRow + iSize + j ) );
+      _mm_storeu_si128( (__m128i*)( piPair + 2*j     ), _mm_unpacklo_epi16( v0, v1 ) );
+      _mm_storeu_si128( (__m128i*)( piPair + 2*j + 8 ), _mm_unpackhi_epi16( v0, v1 ) );
+    }
+  }
+
+  const __m256i vAdd  = _mm256_set1_epi32( 1 << ( iShift - 1 ) );
+  const __m256i vMask = _mm256_set1_epi32( 0xffff );
+  for ( Int k = 0; k < iSize; k++ )
+  {
+    __m256i avSum[ iNumVec ];
+    for ( Int v = 0; v < iNumVec; v++ )
+    {
+      avSum[v] = vAdd;
+    }
+    for ( Int n = 0; n < iSize; n += 2 )
+    {
+      UInt    uiCoef = (UShort)piMat[k*iStrideK + n*iStrideN] | ( (UInt)(UShort)piMat[k*iStrideK + (n+1)*iStrideN] << 16 );
+      __m256i vCoef  = _mm256_set1_epi32( (Int)uiCoef );
+      const __m256i* pvPair = (const __m256i*)( aiPair + n * iSize );
+      for ( Int v = 0; v < iNumVec; v++ )
+      {
+        avSum[v] = _mm256_add_epi32( avSum[v], _mm256_madd_epi16( _mm256_loadu_si256( pvPair + v ), vCoef ) );
+      }
+    }
+    for ( Int v = 0; v < iNumVec; v += 2 )
+    {
+      __m256i v0 = _mm256_srai_epi32( avSum[v  ], iShift );
+      __m256i v1 = _mm256_srai_epi32( avSum[v+1], iShift );
+      __m256i vOut = bClip ? _mm256_packs_epi32( v0, v1 ) : _mm256_packus_epi32( _mm256_and_si256( v0, vMask ), _mm256_and_si256( v1, vMask ) );
+      // the packs work on 128-bit lanes
+      _mm256_storeu_si256( (__m256i*)( piDst + k * iSize + 8*v ), _mm256_permute4x64_epi64( vOut, _MM_SHUFFLE( 3, 1, 2, 0 ) ) );
+    }
+  }
+}
+
+/// one transform pass, on 256-bit vectors for the blocks of 16 and 32 samples
+template <Int iSimdLevel, Int iSize, Bool bClip>
+static inline Void xTrPass( const Short* piMat, Int iStrideK, Int iStrideN, const Short* piSrc, Short* piDst, Int iShift )
+{
+  if ( iSimdLevel == SIMD_AVX2 && iSize >= 16 )
+  {
+    xTrPassAVX2<( iSize >= 16 ? iSize : 16 ), bClip>( piMat, iStrideK, iStrideN, piSrc, piDst, iShift );
+  }
+  else
+  {
+    xTrPassSSE41<iSize, bClip>( piMat, iStrideK, iStrideN, piSrc, piDst, iShift );
+  }
+}
+
+/// xTrMxN with the SIMD passes, each pass works on the transposed block
+template <Int iSimdLevel, Int iSize>
+static Void xTrSIMD( const Short* piMat, Short *block, Short *coeff, Int shift_1st, Int shift_2nd )
+{
+  Short tmp [ iSize * iSize ];
+  Short tmpT[ iSize * iSize ];
+
+  xTransposeSSE41<iSize>( block, tmpT );
+  xTrPass<iSimdLevel, iSize, false>( piMat, iSize, 1, tmpT, tmp, shift_1st );
+  xTransposeSSE41<iSize>( tmp, tmpT );
+  xTrPass<iSimdLevel, iSize, false>( piMat, iSize, 1, tmpT, coeff, shift_2nd );
+}
+
+/// xITrMxN with the SIMD passes, the results of each pass are transposed
+template <Int iSimdLevel, Int iSize>
+static Void xITrSIMD( const Short* piMat, Short *coeff, Short *block, Int shift_1st, Int shift_2nd )
+{
+  Short tmp [ iSize * iSize ];
+  Short tmpT[ iSize * iSize ];
+
+  xTrPass<iSimdLevel, iSize, true>( piMat, 1, iSize, coeff, tmpT, shift_1st );
+  xTransposeSSE41<iSize>( tmpT, tmp );
+  xTrPass<iSimdLevel, iSize, true>( piMat, 1, iSize, tmp, tmpT, shift_2nd );
+  xTransposeSSE41<iSize>( tmpT, block );
+}
+
+template <Int iSimdLevel>
+static Void xTrMxNSIMD( Int bitDepth, Short *block, Short *coeff, Int iWidth, Int iHeight, UInt uiMode )
+{
+  Int shift_1st = g_aucConvertToBit[iWidth]  + 1 + bitDepth-8; // log2(iWidth) - 1 + g_bitDepth - 8
+  Int shift_2nd = g_aucConvertToBit[iHeight]  + 8;                   // log2(iHeight) + 6
+
+  switch ( iWidth )
+  {
+    case 4:  xTrSIMD<iSimdLevel,  4>( uiMode != REG_DCT ? g_as_DST_MAT_4[0] : g_aiT4[0], block, coeff, shift_1st, shift_2nd ); break;
+    case 8:  xTrSIMD<iSimdLevel,  8>( g_aiT8 [0], block, coeff, shift_1st, shift_2nd ); break;
+    case 16: xTrSIMD<iSimdLevel, 16>( g_aiT16[0], block, coeff, shift_1st, shift_2nd ); break;
+    case 32: xTrSIMD<iSimdLevel, 32>( g_aiT32[0], block, coeff, shift_1st, shift_2nd ); break;
+    default: break;
+  }
+}
+
+template <Int iSimdLevel>
+static Void xITrMxNSIMD( Int bitDepth, Short *coeff, Short *block, Int iWidth, Int iHeight, UInt uiMode )
+{
+  Int shift_1st = SHIFT_INV_1ST;
+  Int shift_2nd = SHIFT_INV_2ND - (bitDepth-8);
+
+  switch ( iWidth )
+  {
+    case 4:  xITrSIMD<iSimdLevel,  4>( uiMode != REG_DCT ? g_as_DST_MAT_4[0] : g_aiT4[0], coeff, block, shift_1st, shift_2nd ); break;
+    case 8:  xITrSIMD<iSimdLevel,  8>( g_aiT8 [0], coeff, block, shift_1st, shift_2nd ); break;
+    case 16: xITrSIMD<iSimdLevel, 16>( g_aiT16[0], coeff, block, shift_1st, shift_2nd ); break;
+    case 32: xITrSIMD<iSimdLevel, 32>( g_aiT32[0], coeff, block, shift_1st, shift_2nd ); break;
+    default: break;
+  }
+}
+#endif
+
 #endif //MATRIX_MULT
 
 // To minimize the distortion only. No rate is considered. 
@@ -1242,6 +1493,17 @@ Void TComTrQuant::transformNxN( TComDataCU* pcCU,
   uiAbsSum = 0;
   assert( (pcCU->getSlice()->getSPS()->getMaxTrSize() >= uiWidth) );
   Int bitDepth = eTType == TEXT_LUMA ? g_bitDepthY : g_bitDepthC;
+#if RDOQ_ZERO_BLOCK_SKIP
+  if( !useTransformSkip && xIsZeroBlockRDOQ( pcCU, pcResidual, uiStride, uiWidth, bitDepth, eTType, uiAbsPartIdx ) )
+  {
+    // what RDOQ gives for a block without non-zero levels
+    ::memset( rpcCoeff, 0, sizeof(TCoeff) * uiWidth * uiHeight );
+#if ADAPTIVE_QP_SELECTION
+    ::memset( rpcArlCoeff, 0, sizeof(Int) * uiWidth * uiHeight );
+#endif
+    return;
+  }
+#endif
   if(useTransformSkip)
   {
     xTransformSkip(bitDepth, pcResidual, uiStride, m_plTempCoeff, uiWidth, uiHeight );
@@ -1257,6 +1519,58 @@ Void TComTrQuant::transformNxN( TComDataCU* pcCU,
        uiWidth, uiHeight, uiAbsSum, eTType, uiAbsPartIdx );
 }
 
+#if RDOQ_ZERO_BLOCK_SKIP
+/** Test whether RDOQ would quantize all the coefficients of a transformed block to zero
+ * \param pcCU         pointer to coding unit structure
+ * \param pcResidual   residual block
+ * \param uiStride     stride of the residual
+ * \param iSize        block size
+ * \param bitDepth     bit depth of the component
+ * \param eTType       plane type / luminance or chrominance
+ * \param uiAbsPartIdx absolute partition index
+ * \returns true when none of the levels can be non-zero
+ *
+ * No entry of the DCT and DST matrices exceeds 90, which bounds the coefficients of each pass of xT by the sum of the
+ * magnitudes of its input, rounding included. A block whose bound stays below half a quantization step has no level.
+ */
+Bool TComTrQuant::xIsZeroBlockRDOQ( TComDataCU* pcCU, Pel* pcResidual, UInt uiStride, Int iSize, Int bitDepth, TextType eTType, UInt uiAbsPartIdx )
+{
+  Bool useRDOQ = pcCU->getTransformSkip(uiAbsPartIdx,eTType) ? m_useRDOQTS:m_useRDOQ;
+  if ( !useRDOQ || !(eTType == TEXT_LUMA || RDOQ_CHROMA) )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_bUseAdaptQpSelect )
+  {
+    return false;
+  }
+#endif
+
+  Int64 iAbsSum = 0;
+  for ( Int y = 0; y < iSize; y++ )
+  {
+    for ( Int x = 0; x < iSize; x++ )
+    {
+      iAbsSum += abs( pcResidual[x] );
+    }
+    pcResidual += uiStride;
+  }
+
+  const Int iMaxMatCoef     = 90;
+  UInt  uiLog2TrSize        = g_aucConvertToBit[ iSize ] + 2;
+  Int   shift_1st           = uiLog2TrSize - 1 + bitDepth - 8;
+  Int   shift_2nd           = uiLog2TrSize + 6;
+  Int64 iBound1st           = ( iMaxMatCoef * iAbsSum + iSize * ( 1 << ( shift_1st - 1 ) ) ) >> shift_1st;
+  Int64 iBound              = ( iMaxMatCoef * iBound1st + ( 1 << ( shift_2nd - 1 ) ) ) >> shift_2nd;
+
+  Int   iTransformShift     = MAX_TR_DYNAMIC_RANGE - bitDepth - uiLog2TrSize;
+  Int   iQBits              = QUANT_SHIFT + m_cQP.m_iPer + iTransformShift;
+  Int64 iQ                  = g_quantScales[ m_cQP.m_iRem ] << ( m_scalingListEnabledFlag ? 4 : 0 ); // largest scale of the lists
+  return iBound * iQ < ( (Int64)1 << ( iQBits - 1 ) );
+}
+#endif
+
 Void TComTrQuant::invtransformNxN( Bool transQuantBypass, TextType eText, UInt uiMode,Pel* rpcResidual, UInt uiStride, TCoeff*   pcCoeff, UInt uiWidth, UInt uiHeight,  Int scalingListType, Bool useTransformSkip )
 {
   if(transQuantBypass)
@@ -1351,7 +1665,7 @@ Void TComTrQuant::xT(Int bitDepth, UInt uiMode, Pel* piBlkResi, UInt uiStride, I
   {    
     memcpy( block + j * iWidth, piBlkResi + j * uiStride, iWidth * sizeof( Short ) );
   }
-  xTrMxN(bitDepth, block, coeff, iWidth, iHeight, uiMode );
+  m_pfTrMxN(bitDepth, block, coeff, iWidth, iHeight, uiMode );
   for ( j = 0; j < iHeight * iWidth; j++ )
   {    
     psCoeff[ j ] = coeff[ j ];
@@ -1381,7 +1695,7 @@ Void TComTrQuant::xIT(Int bitDepth, UInt uiMode, Int* plCoef, Pel* pResidual, UI
     {    
       coeff[j] = (Short)plCoef[j];
     }
-    xITrMxN(bitDepth, coeff, block, iWidth, iHeight, uiMode );
+    m_pfITrMxN(bitDepth, coeff, block, iWidth, iHeight, uiMode );
     {
       for ( j = 0; j < iHeight; j++ )
       {    
@@ -1473,6 +1787,129 @@ Void TComTrQuant::xITransformSkip(Int bitDepth, Int* plCoef, Pel* pResidual, UIn
   }
 }
 
+/** Quantization of the coefficients for RDOQ, the levels are refined in scan order afterwards
+ * \param piSrc          transform coefficients
+ * \param piQCoef        quantization scales
+ * \param pdErrScale     error scales
+ * \param iNumCoeff      number of coefficients
+ * \param iQBits         quantization shift
+ * \param piLevelDouble  scaled magnitudes of the coefficients
+ * \param puiMaxAbsLevel rounded levels
+ * \param pdCostCoeff0   distortion costs of the zero levels
+ * \returns largest level of the block
+ */
+static UInt xQuantRDOQ( const Int* piSrc, const Int* piQCoef, const Double* pdErrScale, Int iNumCoeff, Int iQBits,
+                        Int* piLevelDouble, UInt* puiMaxAbsLevel, Double* pdCostCoeff0 )
+{
+  UInt uiMaxLevel = 0;
+  for ( Int n = 0; n < iNumCoeff; n++ )
+  {
+    Int lLevelDouble    = (Int)min<Int64>((Int64)abs(piSrc[n]) * piQCoef[n], MAX_INT - (1 << (iQBits - 1)));
+    UInt uiMaxAbsLevel  = (lLevelDouble + (1 << (iQBits - 1))) >> iQBits;
+    Double dErr         = Double( lLevelDouble );
+    piLevelDouble[n]    = lLevelDouble;
+    puiMaxAbsLevel[n]   = uiMaxAbsLevel;
+    pdCostCoeff0[n]     = dErr * dErr * pdErrScale[n];
+    uiMaxLevel          = max( uiMaxLevel, uiMaxAbsLevel );
+  }
+  return uiMaxLevel;
+}
+
+#if SIMD_X86
+// The products of the coefficients and the scales need more than 32 bits, they are computed on doubles, on which they
+// are exact, as the costs are.
+
+SIMD_TARGET_SSE41 static UInt xQuantRDOQSSE41( const Int* piSrc, const Int* piQCoef, const Double* pdErrScale, Int iNumCoeff, Int iQBits,
+                                               Int* piLevelDouble, UInt* puiMaxAbsLevel, Double* pdCostCoeff0 )
+{
+  const Int     iAdd   = 1 << (iQBits - 1);
+  const __m128d vLimit = _mm_set1_pd( (Double)( MAX_INT - iAdd ) );
+  const __m128i vAdd   = _mm_set1_epi32( iAdd );
+  __m128i vMax = _mm_setzero_si128();
+
+  for ( Int n = 0; n < iNumCoeff; n += 4 )
+  {
+    __m128i vSrc = _mm_abs_epi32( _mm_loadu_si128( (const __m128i*)( piSrc + n ) ) );
+    __m128i vQ   = _mm_loadu_si128( (const __m128i*)( piQCoef + n ) );
+    __m128d vLo  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( vSrc ), _mm_cvtepi32_pd( vQ ) ), vLimit );
+    __m128d vHi  = _mm_min_pd( _mm_mul_pd( _mm_cvtepi32_pd( _mm_srli_si128( vSrc, 8 ) ), _mm_cvtepi32_pd( _mm_srli_si128( vQ, 8 ) ) ), vLimit );
+    __m128i vLevel = _mm_unpacklo_epi64( _mm_cvttpd_epi32( vLo ), _mm_cvttpd_epi32( vHi ) );
+    __m128i vMaxAbsLevel = _mm_srli_epi32( _mm_add_epi32( vLevel, vAdd ), iQBits );
+
+    _mm_storeu_si128( (__m128i*)( piLevelDouble + n ), vLevel );
+    _mm_storeu_si128( (__m128i*)( puiMaxAbsLevel + n ), vMaxAbsLevel );
+    _mm_storeu_pd( pdCostCoeff0 + n,     _mm_mul_pd( _mm_mul_pd( vLo, vLo ), _mm_loadu_pd( pdErrScale + n ) ) );
+    _mm_storeu_pd( pdCostCoeff0 + n + 2, _mm_mul_pd( _mm_mul_pd( vHi, vHi ), _mm_loadu_pd( pdErrScale + n + 2 ) ) );
+    vMax = _mm_max_epu32( vMax, vMaxAbsLevel );
+  }
+  vMax = _mm_max_epu32( vMax, _mm_srli_si128( vMax, 8 ) );
+  vMax = _mm_max_epu32( vMax, _mm_srli_si128( vMax, 4 ) );
+  return (UInt)_mm_cvtsi128_si32( vMax );
+}
+
+SIMD_TARGET_AVX2 static UInt xQuantRDOQAVX2( const Int* piSrc, const Int* piQCoef, const Double* pdErrScale, Int iNumCoeff, Int iQBits,
+                                             Int* piLevelDouble, UInt* puiMaxAbsLevel, Double* pdCostCoeff0 )
+{
+  const Int     iAdd   = 1 << (iQBits - 1);
+  const __m256d vLimit = _mm256_set1_pd( (Double)( MAX_INT - iAdd ) );
+  const __m256i vAdd   = _mm256_set1_epi32( iAdd );
+  const __m128i vShift = _mm_cvtsi32_si128( iQBits );
+  __m256i vMax = _mm256_setzero_si256();
+
+  for ( Int n = 0; n < iNumCoeff; n += 8 )
+  {
+    __m256i vSrc = _mm256_abs_epi32( _mm256_loadu_si256( (const __m256i*)( piSrc + n ) ) );
+    __m256i vQ   = _mm256_loadu_si256( (const __m256i*)( piQCoef + n ) );
+    __m256d vLo  = _mm256_min_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( _mm256_castsi256_si128( vSrc ) ), _mm256_cvtepi32_pd( _mm256_castsi256_si128( vQ ) ) ), vLimit );
+    __m256d vHi  = _mm256_min_pd( _mm256_mul_pd( _mm256_cvtepi32_pd( _mm256_extracti128_si256( vSrc, 1 ) ), _mm256_cvtepi32_pd( _mm256_extracti128_si256( vQ, 1 ) ) ), vLimit );
+    __m256i vLevel = _mm256_setr_m128i( _mm256_cvttpd_epi32( vLo ), _mm256_cvttpd_epi32( vHi ) );
+    __m256i vMaxAbsLevel = _mm256_srl_epi32( _mm256_add_epi32( vLevel, vAdd ), vShift );
+
+    _mm256_storeu_si256( (__m256i*)( piLevelDouble + n ), vLevel );
+    _mm256_storeu_si256( (__m256i*)( puiMaxAbsLevel + n ), vMaxAbsLevel );
+    _mm256_storeu_pd( pdCostCoeff0 + n,     _mm256_mul_pd( _mm256_mul_pd( vLo, vLo ), _mm256_loadu_pd( pdErrScale + n ) ) );
+    _mm256_storeu_pd( pdCostCoeff0 + n + 4, _mm256_mul_pd( _mm256_mul_pd( vHi, vHi ), _mm256_loadu_pd( pdErrScale + n + 4 ) ) );
+    vMax = _mm256_max_epu32( vMax, vMaxAbsLevel );
+  }
+  __m128i vMax128 = _mm_max_epu32( _mm256_castsi256_si128( vMax ), _mm256_extracti128_si256( vMax, 1 ) );
+  vMax128 = _mm_max_epu32( vMax128, _mm_srli_si128( vMax128, 8 ) );
+  vMax128 = _mm_max_epu32( vMax128, _mm_srli_si128( vMax128, 4 ) );
+  return (UInt)_mm_cvtsi128_si32( vMax128 );
+}
+#endif
+
+/** Select the transform and quantization kernels of the CPU
+ */
+Void TComTrQuant::xInitKernels()
+{
+#if !MATRIX_MULT
+  m_pfTrMxN  = xTrMxN;
+  m_pfITrMxN = xITrMxN;
+#endif
+  m_pfQuantRDOQ = xQuantRDOQ;
+#if SIMD_X86
+  switch ( getSimdLevel() )
+  {
+    case SIMD_AVX2:
+#if !MATRIX_MULT
+      m_pfTrMxN  = xTrMxNSIMD<SIMD_AVX2>;
+      m_pfITrMxN = xITrMxNSIMD<SIMD_AVX2>;
+#endif
+      m_pfQuantRDOQ = xQuantRDOQAVX2;
+      break;
+    case SIMD_SSE41:
+#if !MATRIX_MULT
+      m_pfTrMxN  = xTrMxNSIMD<SIMD_SSE41>;
+      m_pfITrMxN = xITrMxNSIMD<SIMD_SSE41>;
+#endif
+      m_pfQuantRDOQ = xQuantRDOQSSE41;
+      break;
+    default:
+      break;
+  }
+#endif
+}
+
 /** RDOQ with CABAC
  * \param pcCU pointer to coding unit structure
  * \param plSrcCoeff pointer to input buffer
@@ -1524,6 +1961,26 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
   memset(piArlDstCoeff, 0, sizeof(Int) *  uiMaxNumCoeff);
 #endif
   
+  //===== quantization =====
+  Int    aiLevelDouble  [ 32 * 32 ];
+  UInt   auiMaxAbsLevel [ 32 * 32 ];
+  Double adCostCoeff0   [ 32 * 32 ];
+  UInt uiMaxLevel = m_pfQuantRDOQ( plSrcCoeff, piQCoef, pdErrScale, uiMaxNumCoeff, iQBits, aiLevelDouble, auiMaxAbsLevel, adCostCoeff0 );
+#if ADAPTIVE_QP_SELECTION
+  if( m_bUseAdaptQpSelect )
+  {
+    for ( UInt n = 0; n < uiMaxNumCoeff; n++ )
+    {
+      piArlDstCoeff[n] = (Int)(( aiLevelDouble[n] + iAddC) >> iQBitsC );
+    }
+  }
+#endif
+  if ( uiMaxLevel == 0 )
+  {
+    ::memset( piDstCoeff, 0, sizeof(TCoeff) * uiMaxNumCoeff );
+    return;
+  }
+  
   Double pdCostCoeff [ 32 * 32 ];
   Double pdCostSig   [ 32 * 32 ];
   Double pdCostCoeff0[ 32 * 32 ];
@@ -1571,11 +2028,23 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
   ::memset( pdCostCoeffGroupSig,   0, sizeof(Double) * MLS_GRP_NUM );
   ::memset( uiSigCoeffGroupFlag,   0, sizeof(UInt) * MLS_GRP_NUM );
   
-  UInt uiCGNum = uiWidth * uiHeight >> MLS_CG_SIZE;
   Int iScanPos;
   coeffGroupRDStats rdStats;     
   
-  for (Int iCGScanPos = uiCGNum-1; iCGScanPos >= 0; iCGScanPos--)
+  // the coefficients after the last non-zero level only add the costs of their zero levels
+  for ( iScanPos = uiMaxNumCoeff-1; auiMaxAbsLevel[ scan[ iScanPos ] ] == 0; iScanPos-- )
+  {
+    UInt uiBlkPos             = scan[iScanPos];
+    pdCostCoeff0[ iScanPos ]  = adCostCoeff0[ uiBlkPos ];
+    d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
+    piDstCoeff[ uiBlkPos ]    = 0;
+  }
+  d64BaseCost    = d64BlockUncodedCost;
+  iLastScanPos   = iScanPos;
+  uiCtxSet       = (iScanPos < SCAN_SET_SIZE || eTType!=TEXT_LUMA) ? 0 : 2;
+  iCGLastScanPos = iScanPos / uiCGSize;
+  
+  for (Int iCGScanPos = iCGLastScanPos; iCGScanPos >= 0; iCGScanPos--)
   {
     UInt uiCGBlkPos = scanCG[ iCGScanPos ];
     UInt uiCGPosY   = uiCGBlkPos / uiNumBlkSide;
@@ -1583,118 +2052,94 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
     ::memset( &rdStats, 0, sizeof (coeffGroupRDStats));
     
     const Int patternSigCtx = TComTrQuant::calcPatternSigCtx(uiSigCoeffGroupFlag, uiCGPosX, uiCGPosY, uiWidth, uiHeight);
-    for (Int iScanPosinCG = uiCGSize-1; iScanPosinCG >= 0; iScanPosinCG--)
+    Int iFirstPosinCG = iCGScanPos == iCGLastScanPos ? iLastScanPos - iCGScanPos*uiCGSize : uiCGSize-1;
+    for (Int iScanPosinCG = iFirstPosinCG; iScanPosinCG >= 0; iScanPosinCG--)
     {
       iScanPos = iCGScanPos*uiCGSize + iScanPosinCG;
-      //===== quantization =====
       UInt    uiBlkPos          = scan[iScanPos];
       // set coeff
-      Int uiQ  = piQCoef[uiBlkPos];
       Double dTemp = pdErrScale[uiBlkPos];
-      Int lLevelDouble          = plSrcCoeff[ uiBlkPos ];
-      lLevelDouble              = (Int)min<Int64>((Int64)abs((Int)lLevelDouble) * uiQ , MAX_INT - (1 << (iQBits - 1)));
-#if ADAPTIVE_QP_SELECTION
-      if( m_bUseAdaptQpSelect )
-      {
-        piArlDstCoeff[uiBlkPos]   = (Int)(( lLevelDouble + iAddC) >> iQBitsC );
-      }
-#endif
-      UInt uiMaxAbsLevel        = (lLevelDouble + (1 << (iQBits - 1))) >> iQBits;
+      Int lLevelDouble          = aiLevelDouble[ uiBlkPos ];
+      UInt uiMaxAbsLevel        = auiMaxAbsLevel[ uiBlkPos ];
       
-      Double dErr               = Double( lLevelDouble );
-      pdCostCoeff0[ iScanPos ]  = dErr * dErr * dTemp;
+      pdCostCoeff0[ iScanPos ]  = adCostCoeff0[ uiBlkPos ];
       d64BlockUncodedCost      += pdCostCoeff0[ iScanPos ];
-      piDstCoeff[ uiBlkPos ]    = uiMaxAbsLevel;
       
-      if ( uiMaxAbsLevel > 0 && iLastScanPos < 0 )
+      //===== coefficient level estimation =====
+      UInt  uiLevel;
+      UInt  uiOneCtx         = 4 * uiCtxSet + c1;
+      UInt  uiAbsCtx         = uiCtxSet + c2;
+      
+      if( iScanPos == iLastScanPos )
+      {
+        uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], 
+                                              lLevelDouble, uiMaxAbsLevel, 0, uiOneCtx, uiAbsCtx, uiGoRiceParam, 
+                                              c1Idx, c2Idx, iQBits, dTemp, 1 );
+      }
+      else
+      {
+        UInt   uiPosY        = uiBlkPos >> uiLog2BlkSize;
+        UInt   uiPosX        = uiBlkPos - ( uiPosY << uiLog2BlkSize );
+        UShort uiCtxSig      = getSigCtxInc( patternSigCtx, uiScanIdx, uiPosX, uiPosY, uiLog2BlkSize, eTType );
+        uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
+                                              lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam, 
+                                              c1Idx, c2Idx, iQBits, dTemp, 0 );
+        sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
+      }
+      deltaU[ uiBlkPos ]        = (lLevelDouble - ((Int)uiLevel << iQBits)) >> (iQBits-8);
+      if( uiLevel > 0 )
       {
-        iLastScanPos            = iScanPos;
-        uiCtxSet                = (iScanPos < SCAN_SET_SIZE || eTType!=TEXT_LUMA) ? 0 : 2;
-        iCGLastScanPos          = iCGScanPos;
+        Int rateNow = xGetICRate( uiLevel, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx );
+        rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
+        rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
       }
+      else // uiLevel == 0
+      {
+        rateIncUp   [ uiBlkPos ] = m_pcEstBitsSbac->m_greaterOneBits[ uiOneCtx ][ 0 ];
+      }
+      piDstCoeff[ uiBlkPos ] = uiLevel;
+      d64BaseCost           += pdCostCoeff [ iScanPos ];
+      
       
-      if ( iLastScanPos >= 0 )
+      baseLevel = (c1Idx < C1FLAG_NUMBER) ? (2 + (c2Idx < C2FLAG_NUMBER)) : 1;
+      if( uiLevel >= baseLevel )
       {
-        //===== coefficient level estimation =====
-        UInt  uiLevel;
-        UInt  uiOneCtx         = 4 * uiCtxSet + c1;
-        UInt  uiAbsCtx         = uiCtxSet + c2;
-        
-        if( iScanPos == iLastScanPos )
-        {
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ], 
-                                                lLevelDouble, uiMaxAbsLevel, 0, uiOneCtx, uiAbsCtx, uiGoRiceParam, 
-                                                c1Idx, c2Idx, iQBits, dTemp, 1 );
-        }
-        else
-        {
-          UInt   uiPosY        = uiBlkPos >> uiLog2BlkSize;
-          UInt   uiPosX        = uiBlkPos - ( uiPosY << uiLog2BlkSize );
-          UShort uiCtxSig      = getSigCtxInc( patternSigCtx, uiScanIdx, uiPosX, uiPosY, uiLog2BlkSize, eTType );
-          uiLevel              = xGetCodedLevel( pdCostCoeff[ iScanPos ], pdCostCoeff0[ iScanPos ], pdCostSig[ iScanPos ],
-                                                lLevelDouble, uiMaxAbsLevel, uiCtxSig, uiOneCtx, uiAbsCtx, uiGoRiceParam, 
-                                                c1Idx, c2Idx, iQBits, dTemp, 0 );
-          sigRateDelta[ uiBlkPos ] = m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 1 ] - m_pcEstBitsSbac->significantBits[ uiCtxSig ][ 0 ];
-        }
-        deltaU[ uiBlkPos ]        = (lLevelDouble - ((Int)uiLevel << iQBits)) >> (iQBits-8);
-        if( uiLevel > 0 )
-        {
-          Int rateNow = xGetICRate( uiLevel, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx );
-          rateIncUp   [ uiBlkPos ] = xGetICRate( uiLevel+1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
-          rateIncDown [ uiBlkPos ] = xGetICRate( uiLevel-1, uiOneCtx, uiAbsCtx, uiGoRiceParam, c1Idx, c2Idx ) - rateNow;
-        }
-        else // uiLevel == 0
-        {
-          rateIncUp   [ uiBlkPos ] = m_pcEstBitsSbac->m_greaterOneBits[ uiOneCtx ][ 0 ];
-        }
-        piDstCoeff[ uiBlkPos ] = uiLevel;
-        d64BaseCost           += pdCostCoeff [ iScanPos ];
-        
-        
-        baseLevel = (c1Idx < C1FLAG_NUMBER) ? (2 + (c2Idx < C2FLAG_NUMBER)) : 1;
-        if( uiLevel >= baseLevel )
-        {
-          if(uiLevel  > 3*(1<<uiGoRiceParam))
-          {
-            uiGoRiceParam = min<UInt>(uiGoRiceParam+ 1, 4);
-          }
-        }
-        if ( uiLevel >= 1)
-        {
-          c1Idx ++;
-        }
-        
-        //===== update bin model =====
-        if( uiLevel > 1 )
-        {
-          c1 = 0; 
-          c2 += (c2 < 2);
-          c2Idx ++;
-        }
-        else if( (c1 < 3) && (c1 > 0) && uiLevel)
+        if(uiLevel  > 3*(1<<uiGoRiceParam))
         {
-          c1++;
+          uiGoRiceParam = min<UInt>(uiGoRiceParam+ 1, 4);
         }
+      }
+      if ( uiLevel >= 1)
+      {
+        c1Idx ++;
+      }
+      
+      //===== update bin model =====
+      if( uiLevel > 1 )
+      {
+        c1 = 0; 
+        c2 += (c2 < 2);
+        c2Idx ++;
+      }
+      else if( (c1 < 3) && (c1 > 0) && uiLevel)
+      {
+        c1++;
+      }
+      
+      //===== context set update =====
+      if( ( iScanPos % SCAN_SET_SIZE == 0 ) && ( iScanPos > 0 ) )
+      {
+        c2                = 0;
+        uiGoRiceParam     = 0;
         
-        //===== context set update =====
-        if( ( iScanPos % SCAN_SET_SIZE == 0 ) && ( iScanPos > 0 ) )
+        c1Idx   = 0;
+        c2Idx   = 0; 
+        uiCtxSet          = (iScanPos == SCAN_SET_SIZE || eTType!=TEXT_LUMA) ? 0 : 2;
+        if( c1 == 0 )
         {
-          c2                = 0;
-          uiGoRiceParam     = 0;
-          
-          c1Idx   = 0;
-          c2Idx   = 0; 
-          uiCtxSet          = (iScanPos == SCAN_SET_SIZE || eTType!=TEXT_LUMA) ? 0 : 2;
-          if( c1 == 0 )
-          {
-            uiCtxSet++;
-          }
-          c1 = 1;
+          uiCtxSet++;
         }
-      }
-      else
-      {
-        d64BaseCost    += pdCostCoeff0[ iScanPos ];
+        c1 = 1;
       }
       rdStats.d64SigCost += pdCostSig[ iScanPos ];
       if (iScanPosinCG == 0 )
@@ -1783,11 +2228,6 @@ Void TComTrQuant::xRateDistOptQuant                 ( TComDataCU*
   } //end for (iCGScanPos)
   
   //===== estimate last position =====
-  if ( iLastScanPos < 0 )
-  {
-    return;
-  }
-  
   Double  d64BestCost         = 0;
   Int     ui16CtxCbf          = 0;
   Int     iBestLastIdxP1      = 0;
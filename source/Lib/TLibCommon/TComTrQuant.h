@@ -69,6 +69,13 @@ typedef struct
   Int blockRootCbpBits[4][2];
 } estBitsSbacStruct;
 
+/// 2D transform of a square block of Shorts
+typedef void (*FpTrMxN) ( Int bitDepth, Short* piSrc, Short* piDst, Int iWidth, Int iHeight, UInt uiMode );
+
+/// RDOQ quantization of a block in raster order, returns the largest level
+typedef UInt (*FpQuantRDOQ) ( const Int* piSrc, const Int* piQCoef, const Double* pdErrScale, Int iNumCoeff, Int iQBits,
+                              Int* piLevelDouble, UInt* puiMaxAbsLevel, Double* pdCostCoeff0 );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -222,13 +229,23 @@ protected:
   Int      *m_quantCoef      [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
   Int      *m_dequantCoef    [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of dequantization matrix coefficient 4x4
   Double   *m_errScale       [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
+#if !MATRIX_MULT
+  FpTrMxN  m_pfTrMxN;                 ///< forward transform kernel, C or SIMD
+  FpTrMxN  m_pfITrMxN;                ///< inverse transform kernel, C or SIMD
+#endif
+  FpQuantRDOQ m_pfQuantRDOQ;          ///< RDOQ quantization kernel, C or SIMD
 private:
+  Void xInitKernels();
   // forward Transform
   Void xT   (Int bitDepth, UInt uiMode,Pel* pResidual, UInt uiStride, Int* plCoeff, Int iWidth, Int iHeight );
   
   // skipping Transform
   Void xTransformSkip (Int bitDepth, Pel* piBlkResi, UInt uiStride, Int* psCoeff, Int width, Int height );
 
+#if RDOQ_ZERO_BLOCK_SKIP
+  Bool xIsZeroBlockRDOQ( TComDataCU* pcCU, Pel* pcResidual, UInt uiStride, Int iSize, Int bitDepth, TextType eTType, UInt uiAbsPartIdx );
+#endif
+
   Void signBitHidingHDQ( TCoeff* pQCoef, TCoeff* pCoef, UInt const *scan, Int* deltaU, Int width, Int height );
 
   // quantization
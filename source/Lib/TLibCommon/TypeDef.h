@@ -106,6 +106,8 @@
 
 #define FAST_BIT_EST                1   ///< G763: Table-based bit estimation for CABAC
 
+#define RDOQ_ZERO_BLOCK_SKIP        1   ///< encoder only: skip the transform and RDOQ of TUs whose residual cannot give a non-zero level (results unchanged)
+
 #define MLS_GRP_NUM                         64     ///< G644 : Max number of coefficient groups, max(16, 64)
 #define MLS_CG_SIZE                         4      ///< G644 : Coefficient group size of 4x4
 
@@ -122,6 +124,8 @@
 #error
 #endif
 
+#define FAST_INTRA_REF_CACHE              1           ///< encoder only: reference samples of the first TU of an intra PU are built once per PU and reused by all tested modes (results unchanged)
+
 #define VERBOSE_RATE 0 ///< Print additional rate information in encoder
 
 #define AMVP_DECIMATION_FACTOR            4
@@ -181,6 +185,8 @@
 #define AMP_MRG                               1           ///< encoder only force merge for AMP partition (no motion search for AMP)
 #endif
 
+#define SIMD_KERNELS                          1           ///< SSE4.1/AVX2 kernels, selected at run time from the CPU features (x86 only, results are identical to the C kernels)
+
 
 #define CU_ENC_DEC_TRAC 1
 // ====================================================================================================================
@@ -203,19 +209,36 @@
 #define IT_MI_MERGE_CANDIDATE               1            ///< If enabled, it includes co-located MI candidates to AMVP and MERGE.
 #endif
 
+#if IT_HOLOSS && IT_MI_MERGE_CANDIDATE
+#define IT_SS_MI_LATTICE_SEARCH             1            ///< If enabled, the SS integer search can be restricted to offsets near multiples of the MI size (MILatticeSearch)
+#endif
+
+#if IT_HOLOSS
+#define IT_SS_SEA                           1            ///< If enabled, the full integer search can skip candidates with successive elimination (SEASearch)
+#endif
+
+#if IT_HOLOSS
+#define IT_SS_HASH_SEARCH                   1            ///< If enabled, close matches of the SS block can be found in a hash table of the coded CTUs (SSHashSearch)
+#define IT_SS_HASH_MAX_CAND                 64           ///< maximum number of hash hits verified per search
+#endif
+
+#if IT_HOLOSS
+#define IT_SS_SAD_CACHE                     1            ///< If enabled, the 8x8 SADs of the SS integer searches are kept per CTU and reused across CU depths (SSSadCache)
+#endif
+
 #if IT_HOLOSS
 #define IT_GT								1	                      ///< If enabled, it includes enhancement mode for SS with GT.
 #define IT_GT_UV							1
 #define IT_DEBUG            				0
 //#define MERGE_GT							0
-#define IT_MAX_NSS_Iteration				6
-#define IT_GT_AFFINE 						1
+#define IT_MAX_NSS_Iteration				6  ///< default number of halvings of the GT corner step (GTMaxIteration)
+#define IT_GT_AFFINE 						1  ///< default GT model (GTAffine), 1: the fourth corner is derived from the other three
 #define IT_GT_BILINEAR_TRANSFORMATION		0
 #define IT_GT_COUNT_BITS					1
 #define W_GT								1
 #define IT_GT_SEARCH						2  					///< 0 -> STD NSS (N ITE) / 1 -> SQUARE UNIT SEARCH (X ITE) / 2 -> DIAMOND (N ITE) / -> 3 OSA (N ITE) / -> 4 BEST 16 (1 ITE)
 
-#define IT_SS_NUMBER_OF_BEST_CAND			1
+#define IT_SS_NUMBER_OF_BEST_CAND			1  ///< default number of best SS vectors seeding the GT search (SSBestCand), 0 disables the list
 #define IT_SS_USE_PREDICTORS				1
 #define IT_SS_QUARTER_PEL					0
 #if IT_SS_NUMBER_OF_BEST_CAND >= 2048
@@ -230,14 +253,26 @@
 
 #define IT_Independent_Iterations			1
 
-#define IT_GT_Interpolation_Filter			0 // 0 - Bilin / 1 - NN / 2 - DCTIF
+#define IT_GT_Interpolation_Filter			0 // default GT interpolation filter (GTInterpFilter): 0 - Bilin / 1 - NN / 2 - DCTIF
 #define IT_GT_Interpolation_Filter_order    2 // DCTIF6 - 1/2 pel Int Filter H.264 // DCTIF8 - 1/2 pel Int Filter H.265
 #define PI 3.14159265359
 
+#define IT_GT_FIXED_POINT_WARP				1 // 0 - legacy double precision warp / 1 - fixed-point warp (GT samples differ from the double warp, signalled by vps_holo_gt_fixed_point_warp_flag, a decoder built with the other warp rejects the stream)
+#if IT_GT_FIXED_POINT_WARP
+#define IT_GT_WARP_POS_BITS					14 // fractional bits of the warped sample positions
+#define IT_GT_WARP_FRAC_BITS				8  // fractional bits of the bilinear interpolation weights
+#define IT_GT_DCTIF_PHASE_BITS				6  // the DCT-IF phase is quantised to 1/(1<<IT_GT_DCTIF_PHASE_BITS) sample
+#define IT_GT_DCTIF_COEF_BITS				6  // fractional bits of the integer DCT-IF taps
+#endif
+
 #define IT_GT_CODING						0 // 0 - HEVC like / 1 - HEVC like extended
 // possible options to reduce the overhead produced by the GT Flag
 #define IT_GT_ENCODE_FLAG_AS_WRONG_MVP 		0
 #define IT_GT_CU_SIZE_LIMIT					0
+#define IT_GT_WARP_CACHE					1 // encoder: reuse the GT prediction of a PU predicted again with the same vector and corners during the decision of a CU
+#define IT_GT_WARP_CACHE_SIZE				8 // number of PU predictions kept by the cache
+#define IT_GT_PARALLEL_SEEDS				1 // encoder: the SS seeds of the GT diamond search can be refined independently on several threads (GTSearchThreads, OpenMP)
+#define IT_GT_MAX_SEARCH_THREADS			16 // largest GTSearchThreads, also the number of seeds refined per batch
 
 
 #endif
@@ -402,6 +437,22 @@ private:
 
 };
 
+#if IT_GT
+/// parameters of the geometric transform (GT) applied to an SS prediction block
+struct GTWarpParam
+{
+#if IT_GT_FIXED_POINT_WARP
+  Int64 iCoef[9];                         ///< transform coefficients, scaled so that all of them share the integer denominator iCoef[8]
+  Int   iCornerShift;                     ///< corners were given in units of 1/(1<<iCornerShift) samples
+#else
+  Double dCoef[9];                        ///< transform coefficients
+#endif
+  Int   iMaxVal;                          ///< largest value of the warped samples, (1<<bitDepth)-1 of the luma unless set for the chroma
+  Bool  bAffine;                          ///< transform has no perspective (projective) or cross (bilinear) term
+  Bool  bBilinear;                        ///< coefficients describe a bilinear transform instead of a projective one
+};
+#endif
+
 /// parameters for deblocking filter
 typedef struct _LFCUParam
 {
@@ -740,6 +740,28 @@ Void TDecCavlc::parseVPS(TComVPS* pcVPS)
     m_pcBitstream->readOutTrailingBits();
     READ_UVLC( uiCode, "vps_holo_microimage_size" ); // ue(v)
     pcVPS->setVpsHoloMIsize( uiCode ); 
+#if IT_GT
+    READ_FLAG( uiCode, "vps_holo_gt_affine_flag" );       pcVPS->setVpsHoloGTAffineFlag( uiCode == 1 );
+    READ_UVLC( uiCode, "vps_holo_gt_max_iteration" );     pcVPS->setVpsHoloGTMaxIteration( uiCode );
+    if ( uiCode < 1 || uiCode > 8 )
+    {
+      printf( "vps_holo_gt_max_iteration shall be in the range of 1 to 8\n" );
+      exit( EXIT_FAILURE );
+    }
+    READ_UVLC( uiCode, "vps_holo_gt_interp_filter" );     pcVPS->setVpsHoloGTInterpFilter( uiCode );
+    if ( uiCode > 2 )
+    {
+      printf( "vps_holo_gt_interp_filter shall be in the range of 0 to 2\n" );
+      exit( EXIT_FAILURE );
+    }
+    READ_FLAG( uiCode, "vps_holo_gt_fixed_point_warp_flag" ); pcVPS->setVpsHoloGTFixedPointWarpFlag( uiCode == 1 );
+    // the GT samples of the two warps differ, only the warp the decoder is built with can be decoded
+    if ( pcVPS->getVpsHoloGTFixedPointWarpFlag() != ( IT_GT_FIXED_POINT_WARP == 1 ) )
+    {
+      printf( "vps_holo_gt_fixed_point_warp_flag = %d is not supported by this decoder, build it with IT_GT_FIXED_POINT_WARP %d\n", uiCode, uiCode );
+      exit( EXIT_FAILURE );
+    }
+#endif
     READ_FLAG( uiCode,  "vps_extension2_flag" );
     if (uiCode)
     {
@@ -905,6 +905,10 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
   UInt uiSymbol;
 
   const Bool bGTFlag = pcCU->getGTFlag(uiAbsPartIdx);
+  const Bool bGTAffine = pcCU->getSlice()->getGTAffineFlag();
+#if IT_GT_CODING == 1
+  const Int  iGTMaxIteration = pcCU->getSlice()->getGTMaxIteration();
+#endif
 
   UInt uiHorGT0Abs = 0;
   UInt uiVerGT0Abs = 0;
@@ -969,12 +973,13 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 		  m_pcTDecBinIf->decodeBin( uiVerGT2Abs, *pCtx );
 		  C2_Hor_NULL = uiHorGT2Abs == 0;
 		  C2_Ver_NULL = uiVerGT2Abs == 0;
-#if !IT_GT_AFFINE
-		  m_pcTDecBinIf->decodeBin( uiHorGT3Abs, *pCtx );
-		  m_pcTDecBinIf->decodeBin( uiVerGT3Abs, *pCtx );
-		  C3_Hor_NULL = uiHorGT3Abs == 0;
-		  C3_Ver_NULL = uiVerGT3Abs == 0;
-#endif
+		  if ( !bGTAffine )
+		  {
+			  m_pcTDecBinIf->decodeBin( uiHorGT3Abs, *pCtx );
+			  m_pcTDecBinIf->decodeBin( uiVerGT3Abs, *pCtx );
+			  C3_Hor_NULL = uiHorGT3Abs == 0;
+			  C3_Ver_NULL = uiVerGT3Abs == 0;
+		  }
 		  pCtx++;
 		  if( !C0_Hor_NULL )
 		  {
@@ -1006,18 +1011,19 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
 			  uiVerGT2Abs += uiSymbol;
 		  }
-#if !IT_GT_AFFINE
-		  if( !C3_Hor_NULL )
+		  if ( !bGTAffine )
 		  {
-			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
-			  uiHorGT3Abs += uiSymbol;
-		  }
-		  if( !C3_Ver_NULL )
-		  {
-			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
-			  uiVerGT3Abs += uiSymbol;
+			  if( !C3_Hor_NULL )
+			  {
+				  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
+				  uiHorGT3Abs += uiSymbol;
+			  }
+			  if( !C3_Ver_NULL )
+			  {
+				  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
+				  uiVerGT3Abs += uiSymbol;
+			  }
 		  }
-#endif
 		  if( !C0_Hor_NULL )
 		  {
 			  if( 2 == uiHorGT0Abs )
@@ -1078,29 +1084,30 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 
 			  m_pcTDecBinIf->decodeBinEP( uiVerGT2Sign );
 		  }
-#if !IT_GT_AFFINE
-		  if( !C3_Hor_NULL )
+		  if ( !bGTAffine )
 		  {
-			  if( 2 == uiHorGT3Abs )
+			  if( !C3_Hor_NULL )
 			  {
-				  xReadEpExGolomb( uiSymbol, 1 );
-				  uiHorGT3Abs += uiSymbol;
-			  }
+				  if( 2 == uiHorGT3Abs )
+				  {
+					  xReadEpExGolomb( uiSymbol, 1 );
+					  uiHorGT3Abs += uiSymbol;
+				  }
 
-			  m_pcTDecBinIf->decodeBinEP( uiHorGT3Sign );
-		  }
-		  if( !C3_Ver_NULL )
-		  {
-			  if( 2 == uiVerGT3Abs )
-			  {
-				  xReadEpExGolomb( uiSymbol, 1 );
-				  uiVerGT3Abs += uiSymbol;
+				  m_pcTDecBinIf->decodeBinEP( uiHorGT3Sign );
 			  }
+			  if( !C3_Ver_NULL )
+			  {
+				  if( 2 == uiVerGT3Abs )
+				  {
+					  xReadEpExGolomb( uiSymbol, 1 );
+					  uiVerGT3Abs += uiSymbol;
+				  }
 
-			  m_pcTDecBinIf->decodeBinEP( uiVerGT3Sign );
+				  m_pcTDecBinIf->decodeBinEP( uiVerGT3Sign );
+			  }
 		  }
 #endif
-#endif
 #if IT_GT_CODING == 1
 		  // corner == (0,0)
 		  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
@@ -1130,17 +1137,18 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 		  }
 		  else
 			  C2_NULL = false;
-#if !IT_GT_AFFINE
-		  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
-		  if(!uiSymbol)
+		  if ( !bGTAffine )
 		  {
-			  C3_NULL = true;
-			  uiHorGT3Abs = 0;
-			  uiVerGT3Abs = 0;
+			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
+			  if(!uiSymbol)
+			  {
+				  C3_NULL = true;
+				  uiHorGT3Abs = 0;
+				  uiVerGT3Abs = 0;
+			  }
+			  else
+				  C3_NULL = false;
 		  }
-		  else
-			  C3_NULL = false;
-#endif
 		  //x or y == 0
 		  pCtx++;
 		  if(!C0_NULL)
@@ -1200,47 +1208,54 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 			  else
 				  C2_Ver_NULL = false;
 		  }
-#if !IT_GT_AFFINE
-		  if(!C3_NULL)
+		  if ( !bGTAffine )
 		  {
-			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
-			  if(!uiSymbol)
+			  if(!C3_NULL)
 			  {
-				  C3_Hor_NULL = true;
-				  uiHorGT3Abs = 0;
+				  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
+				  if(!uiSymbol)
+				  {
+					  C3_Hor_NULL = true;
+					  uiHorGT3Abs = 0;
+				  }
+				  else
+					  C3_Hor_NULL = false;
+				  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
+				  if(!uiSymbol)
+				  {
+					  C3_Ver_NULL = true;
+					  uiVerGT3Abs = 0;
+				  }
+				  else
+					  C3_Ver_NULL = false;
 			  }
-			  else
-				  C3_Hor_NULL = false;
-			  m_pcTDecBinIf->decodeBin( uiSymbol, *pCtx );
-			  if(!uiSymbol)
-			  {
-				  C3_Ver_NULL = true;
-				  uiVerGT3Abs = 0;
-			  }
-			  else
-				  C3_Ver_NULL = false;
 		  }
-#endif
 		  // signal and abs
 		  if(!C0_NULL)
 		  {
 			  if(!C0_Hor_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiHorGT0Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiHorGT0Abs, 1 );
-#else
-				  uiHorGT0Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiHorGT0Abs, 1 );
+				  }
+				  else
+				  {
+					  uiHorGT0Abs = 1;
+				  }
 			  }
 			  if(!C0_Ver_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiVerGT0Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiVerGT0Abs, 1 );
-#else
-				  uiVerGT0Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiVerGT0Abs, 1 );
+				  }
+				  else
+				  {
+					  uiVerGT0Abs = 1;
+				  }
 			  }
 		  }
 		  if(!C1_NULL)
@@ -1248,20 +1263,26 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 			  if(!C1_Hor_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiHorGT1Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiHorGT1Abs, 1 );
-#else
-				  uiHorGT1Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiHorGT1Abs, 1 );
+				  }
+				  else
+				  {
+					  uiHorGT1Abs = 1;
+				  }
 			  }
 			  if(!C1_Ver_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiVerGT1Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiVerGT1Abs, 1 );
-#else
-				  uiVerGT1Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiVerGT1Abs, 1 );
+				  }
+				  else
+				  {
+					  uiVerGT1Abs = 1;
+				  }
 			  }
 		  }
 		  if(!C2_NULL)
@@ -1269,45 +1290,58 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
 			  if(!C2_Hor_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiHorGT2Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiHorGT2Abs, 1 );
-#else
-				  uiHorGT2Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiHorGT2Abs, 1 );
+				  }
+				  else
+				  {
+					  uiHorGT2Abs = 1;
+				  }
 			  }
 			  if(!C2_Ver_NULL)
 			  {
 				  m_pcTDecBinIf->decodeBinEP( uiVerGT2Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiVerGT2Abs, 1 );
-#else
-				  uiVerGT2Abs = 1;
-#endif
+				  if(iGTMaxIteration > 1)
+				  {
+					  xReadEpExGolomb( uiVerGT2Abs, 1 );
+				  }
+				  else
+				  {
+					  uiVerGT2Abs = 1;
+				  }
 			  }
 		  }
-#if !IT_GT_AFFINE
-		  if(!C3_NULL)
+		  if ( !bGTAffine )
 		  {
-			  if(!C3_Hor_NULL)
-			  {
-				  m_pcTDecBinIf->decodeBinEP( uiHorGT3Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiHorGT3Abs, 1 );
-#else
-				  uiHorGT3Abs = 1;
-#endif
-			  }
-			  if(!C3_Ver_NULL)
+			  if(!C3_NULL)
 			  {
-				  m_pcTDecBinIf->decodeBinEP( uiVerGT3Sign );
-#if IT_MAX_NSS_Iteration > 1
-				  xReadEpExGolomb( uiVerGT3Abs, 1 );
-#else
-				  uiVerGT3Abs = 1;
-#endif
+				  if(!C3_Hor_NULL)
+				  {
+					  m_pcTDecBinIf->decodeBinEP( uiHorGT3Sign );
+					  if(iGTMaxIteration > 1)
+					  {
+						  xReadEpExGolomb( uiHorGT3Abs, 1 );
+					  }
+					  else
+					  {
+						  uiHorGT3Abs = 1;
+					  }
+				  }
+				  if(!C3_Ver_NULL)
+				  {
+					  m_pcTDecBinIf->decodeBinEP( uiVerGT3Sign );
+					  if(iGTMaxIteration > 1)
+					  {
+						  xReadEpExGolomb( uiVerGT3Abs, 1 );
+					  }
+					  else
+					  {
+						  uiVerGT3Abs = 1;
+					  }
+				  }
 			  }
 		  }
-#endif
 #endif
 	  }
 	  else
@@ -1326,11 +1360,8 @@ Void TDecSbac::parseGT( TComDataCU* pcCU, UInt uiAbsPartIdx, UInt uiPartIdx, UIn
   const TComMv cGT0( uiHorGT0Sign ? -Int( uiHorGT0Abs ): uiHorGT0Abs, uiVerGT0Sign ? -Int( uiVerGT0Abs ) : uiVerGT0Abs );
   const TComMv cGT1( uiHorGT1Sign ? -Int( uiHorGT1Abs ): uiHorGT1Abs, uiVerGT1Sign ? -Int( uiVerGT1Abs ) : uiVerGT1Abs );
   const TComMv cGT2( uiHorGT2Sign ? -Int( uiHorGT2Abs ): uiHorGT2Abs, uiVerGT2Sign ? -Int( uiVerGT2Abs ) : uiVerGT2Abs );
-#if IT_GT_AFFINE
-  const TComMv cGT3( cGT0.getHor() - cGT1.getHor() + cGT2.getHor(), cGT0.getVer() - cGT1.getVer() + cGT2.getVer() );
-#else
-  const TComMv cGT3( uiHorGT3Sign ? -Int( uiHorGT3Abs ): uiHorGT3Abs, uiVerGT3Sign ? -Int( uiVerGT3Abs ) : uiVerGT3Abs );
-#endif
+  const TComMv cGT3 = bGTAffine ? TComMv( cGT0.getHor() - cGT1.getHor() + cGT2.getHor(), cGT0.getVer() - cGT1.getVer() + cGT2.getVer() )
+                                 : TComMv( uiHorGT3Sign ? -Int( uiHorGT3Abs ): uiHorGT3Abs, uiVerGT3Sign ? -Int( uiVerGT3Abs ) : uiVerGT3Abs );
   pcCU->getCUGT0Field( eRefList )->setAllMv( cGT0, pcCU->getPartitionSize( uiAbsPartIdx ), uiAbsPartIdx, uiDepth, uiPartIdx );
   pcCU->getCUGT1Field( eRefList )->setAllMv( cGT1, pcCU->getPartitionSize( uiAbsPartIdx ), uiAbsPartIdx, uiDepth, uiPartIdx );
   pcCU->getCUGT2Field( eRefList )->setAllMv( cGT2, pcCU->getPartitionSize( uiAbsPartIdx ), uiAbsPartIdx, uiDepth, uiPartIdx );
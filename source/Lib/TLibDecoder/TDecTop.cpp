@@ -319,6 +319,11 @@ Void TDecTop::xActivateParameterSets()
   assert (vps != 0);
   m_apcSlicePilot->setMicroImSize( vps->getVpsHoloMIsize() );
   m_apcSlicePilot->setMIMergeCandFlag( vps->getVpsHoloMIsize() > 0 );
+#if IT_GT
+  m_apcSlicePilot->setGTAffineFlag( vps->getVpsHoloGTAffineFlag() );
+  m_apcSlicePilot->setGTMaxIteration( vps->getVpsHoloGTMaxIteration() );
+  m_apcSlicePilot->setGTInterpFilter( vps->getVpsHoloGTInterpFilter() );
+#endif
 #endif
 
   if (false == m_parameterSetManagerDecoder.activatePPS(m_apcSlicePilot->getPPSId(),m_apcSlicePilot->isIRAP()))
@@ -780,6 +785,10 @@ Bool TDecTop::xDecodeSlice(InputNALUnit &nalu, Int &iSkipFrame, Int iPOCLastDisp
     m_cTrQuant.setUseScalingList(false);
   }
 
+#if IT_GT
+  m_cPrediction.setGTTools( pcSlice );
+#endif
+
   //  Decode a picture
   m_cGopDecoder.decompressSlice(nalu.m_Bitstream, pcPic);
 
@@ -573,6 +573,12 @@ Void TEncCavlc::codeVPS( TComVPS* pcVPS )
   WRITE_FLAG( pcVPS->getVpsHoloExtensionFlag(),               "vps_holo_extension_flag" ); // u(1)
   m_pcBitIf->writeAlignOne();
   WRITE_UVLC( pcVPS->getVpsHoloMIsize() , "vps_holo_microimage_size" );  // ue(v)
+#if IT_GT
+  WRITE_FLAG( pcVPS->getVpsHoloGTAffineFlag() ? 1 : 0, "vps_holo_gt_affine_flag" );  // u(1)
+  WRITE_UVLC( pcVPS->getVpsHoloGTMaxIteration(), "vps_holo_gt_max_iteration" );  // ue(v)
+  WRITE_UVLC( pcVPS->getVpsHoloGTInterpFilter(), "vps_holo_gt_interp_filter" );  // ue(v)
+  WRITE_FLAG( pcVPS->getVpsHoloGTFixedPointWarpFlag() ? 1 : 0, "vps_holo_gt_fixed_point_warp_flag" );  // u(1)
+#endif
   WRITE_FLAG( 0,                     "vps_extension2_flag" );
 #else
   WRITE_FLAG( 0,                     "vps_extension_flag" );
@@ -336,6 +336,31 @@ protected:
 #if IT_MI_MERGE_CANDIDATE
   Bool      m_bUseMIMergeCand;
   Int       m_iMicroImSize;
+#endif
+#if IT_SS_MI_LATTICE_SEARCH
+  Bool      m_bUseMILatticeSearch;
+  Int       m_iMILatticeRange;
+#endif
+#if IT_SS_SEA
+  Int       m_iSEASearch;
+#endif
+#if IT_SS_HASH_SEARCH
+  Bool      m_bUseSSHashSearch;
+  Int       m_iSSHashThreshold;
+#endif
+#if IT_SS_SAD_CACHE
+  Bool      m_bUseSSSadCache;
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  Int       m_iSSBestCandNum;
+  Int       m_iSSBestCandDist;
+#endif
+#if IT_GT
+  Bool      m_bGTAffine;
+  Int       m_iGTMaxIteration;
+  Int       m_iGTInterpFilter;
+  Int       m_iGTGradientSearch;
+  Int       m_iGTSearchThreads;
 #endif
   Int       m_useScalingListId;            ///< Using quantization matrix i.e. 0=off, 1=default, 2=file.
   Char*     m_scalingListFile;          ///< quantization matrix file name
@@ -707,6 +732,44 @@ public:
   Bool      getMIMergeCandFlag                ()            { return m_bUseMIMergeCand;   }
   Void      setMicroImSize                    ( Int u )     { m_iMicroImSize = u;         }
   Int       getMicroImSize                    ()      { return  m_iMicroImSize; }
+#endif
+#if IT_SS_MI_LATTICE_SEARCH
+  Void      setUseMILatticeSearch             ( Bool b )    { m_bUseMILatticeSearch = b;  }
+  Bool      getUseMILatticeSearch             ()            { return m_bUseMILatticeSearch; }
+  Void      setMILatticeRange                 ( Int i )     { m_iMILatticeRange = i;      }
+  Int       getMILatticeRange                 ()            { return m_iMILatticeRange;   }
+#endif
+#if IT_SS_SEA
+  Void      setSEASearch                      ( Int i )     { m_iSEASearch = i;           }
+  Int       getSEASearch                      ()            { return m_iSEASearch;        }
+#endif
+#if IT_SS_HASH_SEARCH
+  Void      setUseSSHashSearch                ( Bool b )    { m_bUseSSHashSearch = b;     }
+  Bool      getUseSSHashSearch                ()            { return m_bUseSSHashSearch;  }
+  Void      setSSHashThreshold                ( Int i )     { m_iSSHashThreshold = i;     }
+  Int       getSSHashThreshold                ()            { return m_iSSHashThreshold;  }
+#endif
+#if IT_SS_SAD_CACHE
+  Void      setUseSSSadCache                  ( Bool b )    { m_bUseSSSadCache = b;       }
+  Bool      getUseSSSadCache                  ()            { return m_bUseSSSadCache;    }
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND
+  Void      setSSBestCandNum                  ( Int i )     { m_iSSBestCandNum = i;       }
+  Int       getSSBestCandNum                  ()            { return m_iSSBestCandNum;    }
+  Void      setSSBestCandDist                 ( Int i )     { m_iSSBestCandDist = i;      }
+  Int       getSSBestCandDist                 ()            { return m_iSSBestCandDist;   }
+#endif
+#if IT_GT
+  Void      setGTAffine                       ( Bool b )    { m_bGTAffine = b;            }
+  Bool      getGTAffine                       ()            { return m_bGTAffine;         }
+  Void      setGTMaxIteration                 ( Int i )     { m_iGTMaxIteration = i;      }
+  Int       getGTMaxIteration                 ()            { return m_iGTMaxIteration;   }
+  Void      setGTInterpFilter                 ( Int i )     { m_iGTInterpFilter = i;      }
+  Int       getGTInterpFilter                 ()            { return m_iGTInterpFilter;   }
+  Void      setGTGradientSearch               ( Int i )     { m_iGTGradientSearch = i;    }
+  Int       getGTGradientSearch               ()            { return m_iGTGradientSearch; }
+  Void      setGTSearchThreads                ( Int i )     { m_iGTSearchThreads = i;     }
+  Int       getGTSearchThreads                ()            { return m_iGTSearchThreads;  }
 #endif
   Void      setUseScalingListId    ( Int  u )    { m_useScalingListId       = u;   }
   Int       getUseScalingListId    ()            { return m_useScalingListId;      }
@@ -249,6 +249,13 @@ Void TEncCu::compressCU( TComDataCU*& rpcCU )
   m_ppcBestCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
   m_ppcTempCU[0]->initCU( rpcCU->getPic(), rpcCU->getAddr() );
 
+#if IT_SS_SAD_CACHE
+  if ( m_pcEncCfg->getUseSSSadCache() && ( rpcCU->getSlice()->isIntraSS() || rpcCU->getSlice()->isInterPSS() ) )
+  {
+    m_pcPredSearch->initSSSadCache( rpcCU );
+  }
+#endif
+
   // analysis of CU
   xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 );
 
@@ -377,6 +384,10 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, UInt u
 
   // get Original YUV data from picture
   m_ppcOrigYuv[uiDepth]->copyFromPicYuv( pcPic->getPicYuvOrg(), rpcBestCU->getAddr(), rpcBestCU->getZorderIdxInCU() );
+#if IT_GT && IT_GT_WARP_CACHE
+  // the reconstruction around the CU may have changed since the GT predictions kept for the previous CU
+  m_pcPredSearch->clearGTWarpCache();
+#endif
 
   // variable for Early CU determination
   Bool    bSubBranch = true;
@@ -1316,7 +1327,7 @@ Void TEncCu::xCheckRDCostMerge2Nx2N( TComDataCU*& rpcBestCU, TComDataCU*& rpcTem
                 TComMv cSSMv   = rpcTempCU->getCUMvField( REF_PIC_LIST_0 )->getMv(0); // uiAbsPartIdx = 0
                 rpcTempCU->clipMv(cSSMv); // correcting value if it is not inside the picture.
                 TComPicYuv* pcPicYuvRef = rpcTempCU->getSlice()->getRefPic( REF_PIC_LIST_0, iRefIdx )->getPicYuvRec();
-                if ( !m_pcRdCost->isValidPattern( pcPicYuvRef->getLumaAddr( rpcTempCU->getAddr(), rpcTempCU->getZorderIdxInCU() ), pcPicYuvRef->getStride(), cSSMv, iWidth, iHeight) ) // uiAbsPartIdx = 0
+                if ( !pcPicYuvRef->isSSValidBlock( rpcTempCU->getAddr(), rpcTempCU->getZorderIdxInCU(), cSSMv, iWidth, iHeight ) ) // uiAbsPartIdx = 0
                 {
                   UInt uiOrgQP = rpcTempCU->getQP( 0 );
                   rpcTempCU->getTotalCost() = MAX_DOUBLE;
@@ -1692,6 +1703,7 @@ Void TEncCu::xCopyYuv2SSRef(TComPic* rpcPic, UInt uiCUAddr, UInt uiAbsPartIdx, U
     UInt uiPartIdxY = ( ( uiAbsPartIdxInRaster / rpcPic->getNumPartInWidth() ) % uiSrcBlkWidth) / uiBlkWidth;
     UInt uiPartIdx = uiPartIdxY * ( uiSrcBlkWidth / uiBlkWidth ) + uiPartIdxX;
     m_ppcRecoYuvBest[uiSrcDepth]->copyToPicYuv( rpcPic->getPicYuvRec (), uiCUAddr, uiAbsPartIdx, uiDepth - uiSrcDepth, uiPartIdx);
+    rpcPic->getPicYuvRec()->setSSValid( uiLPelX, uiTPelY, g_uiMaxCUWidth>>uiDepth, g_uiMaxCUHeight>>uiDepth );
     rpcPic->getPicYuvRec()->setBorderExtension(false);
     rpcPic->getPicYuvRec()->extendPicBorder();
   }
@@ -1712,6 +1724,13 @@ Void TEncCu::xCopyYuv2SSRef(TComPic* rpcPic, UInt uiCUAddr, UInt uiAbsPartIdx, U
       }
     }
   }
+#if IT_SS_HASH_SEARCH
+  // the whole CTU is final: index its blocks for the hash search
+  if ( uiDepth == 0 && m_pcEncCfg->getUseSSHashSearch() )
+  {
+    m_pcPredSearch->getSSHash()->addCtu( rpcPic->getPicYuvRec(), uiLPelX, uiTPelY, g_uiMaxCUWidth, g_uiMaxCUHeight );
+  }
+#endif
 }
 #endif
 
@@ -0,0 +1,208 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncSSHash.cpp
+    \brief    hash table of the reconstructed blocks of the SS reference
+*/
+
+#include "TEncSSHash.h"
+#include <string.h>
+
+//! \ingroup TLibEncoder
+//! \{
+
+#if IT_SS_HASH_SEARCH
+
+TEncSSHash::TEncSSHash()
+: m_piHead      ( NULL )
+, m_piNext      ( NULL )
+, m_puiKey      ( NULL )
+, m_piPos       ( NULL )
+, m_iNumEntries ( 0 )
+, m_iMaxEntries ( 0 )
+, m_iBucketBits ( 0 )
+, m_iWidth      ( 0 )
+, m_iHeight     ( 0 )
+{
+  // CRC-32 (reflected polynomial 0xEDB88320)
+  for ( UInt n = 0; n < 256; n++ )
+  {
+    UInt c = n;
+    for ( Int k = 0; k < 8; k++ )
+    {
+      c = ( c & 1 ) ? ( 0xEDB88320 ^ ( c >> 1 ) ) : ( c >> 1 );
+    }
+    m_auiCrcTable[n] = c;
+  }
+}
+
+TEncSSHash::~TEncSSHash()
+{
+  destroy();
+}
+
+/** allocate the table for one entry per luma position
+ * \param iPicWidth  luma width of the SS reference
+ * \param iPicHeight luma height of the SS reference
+ */
+Void TEncSSHash::create( Int iPicWidth, Int iPicHeight )
+{
+  destroy();
+
+  m_iWidth      = iPicWidth;
+  m_iHeight     = iPicHeight;
+  m_iMaxEntries = iPicWidth * iPicHeight;
+
+  // about two entries per bucket
+  m_iBucketBits = 1;
+  while ( ( 1 << ( m_iBucketBits + 1 ) ) < m_iMaxEntries && m_iBucketBits < 24 )
+  {
+    m_iBucketBits++;
+  }
+
+  m_piHead  = new Int [ 1 << m_iBucketBits ];
+  m_piNext  = new Int [ m_iMaxEntries ];
+  m_puiKey  = new UInt[ m_iMaxEntries ];
+  m_piPos   = new Int [ m_iMaxEntries ];
+
+  ::memset( m_piHead, -1, sizeof(Int) * ( 1 << m_iBucketBits ) );
+  m_iNumEntries = 0;
+}
+
+Void TEncSSHash::destroy()
+{
+  delete [] m_piHead;  m_piHead = NULL;
+  delete [] m_piNext;  m_piNext = NULL;
+  delete [] m_puiKey;  m_puiKey = NULL;
+  delete [] m_piPos;   m_piPos  = NULL;
+  m_iNumEntries = 0;
+  m_iMaxEntries = 0;
+}
+
+/** empty the table when the SS reference is cleared, (re)allocating it for the picture size
+ * \param pcPicYuv SS reference
+ */
+Void TEncSSHash::reset( TComPicYuv* pcPicYuv )
+{
+  if ( m_piHead == NULL || m_iWidth != pcPicYuv->getWidth() || m_iHeight != pcPicYuv->getHeight() )
+  {
+    create( pcPicYuv->getWidth(), pcPicYuv->getHeight() );
+    return;
+  }
+  if ( m_iNumEntries > 0 )
+  {
+    ::memset( m_piHead, -1, sizeof(Int) * ( 1 << m_iBucketBits ) );
+    m_iNumEntries = 0;
+  }
+}
+
+/** signature of the 8x8 block at piSrc
+ * \param piSrc   top-left sample of the block
+ * \param iStride stride of the block
+ * \param ruiKey  returned key
+ * \returns false for a flat block, which is not worth indexing
+ *
+ * The key is the CRC of the coarsely quantized means of the four 4x4 sub-blocks, so that an original block and a
+ * lossy reconstruction of the same content usually share it.
+ */
+Bool TEncSSHash::getBlockKey( const Pel* piSrc, Int iStride, UInt& ruiKey ) const
+{
+  Int  aiMean[4] = { 0, 0, 0, 0 };
+  Int  iShift    = 4 + std::max( 0, g_bitDepthY - SS_HASH_MEAN_BITS );
+
+  for ( Int y = 0; y < SS_HASH_BLK_SIZE; y++ )
+  {
+    Int* piMean = aiMean + ( ( y >> 2 ) << 1 );
+    for ( Int x = 0; x < SS_HASH_BLK_SIZE; x++ )
+    {
+      piMean[x >> 2] += piSrc[x];
+    }
+    piSrc += iStride;
+  }
+
+  UInt uiCrc = 0xFFFFFFFF;
+  for ( Int i = 0; i < 4; i++ )
+  {
+    aiMean[i] >>= iShift;
+    uiCrc = m_auiCrcTable[ ( uiCrc ^ aiMean[i] ) & 0xFF ] ^ ( uiCrc >> 8 );
+  }
+
+  ruiKey = ~uiCrc;
+  return !( aiMean[0] == aiMean[1] && aiMean[0] == aiMean[2] && aiMean[0] == aiMean[3] );
+}
+
+/** index the blocks completed by a coded CTU
+ * \param pcPicYuv   SS reference holding the final reconstruction of the CTU
+ * \param iCtuPelX   luma position of the CTU
+ * \param iCtuPelY
+ * \param iCtuWidth  luma size of the CTU
+ * \param iCtuHeight
+ *
+ * CTUs are coded in raster order, so the CTU holding the bottom-right sample of a block is the last one the block
+ * overlaps: each position is added exactly once, when that CTU is done, and its content does not change afterwards.
+ */
+Void TEncSSHash::addCtu( TComPicYuv* pcPicYuv, Int iCtuPelX, Int iCtuPelY, Int iCtuWidth, Int iCtuHeight )
+{
+  Int  iStride = pcPicYuv->getStride();
+  Pel* piOrg   = pcPicYuv->getLumaAddr();
+  Int  iMinX   = std::max( 0, iCtuPelX - SS_HASH_BLK_SIZE + 1 );
+  Int  iMinY   = std::max( 0, iCtuPelY - SS_HASH_BLK_SIZE + 1 );
+  Int  iMaxX   = std::min( iCtuPelX + iCtuWidth,  m_iWidth  ) - SS_HASH_BLK_SIZE;
+  Int  iMaxY   = std::min( iCtuPelY + iCtuHeight, m_iHeight ) - SS_HASH_BLK_SIZE;
+  UInt uiMask  = ( 1 << m_iBucketBits ) - 1;
+  UInt uiKey;
+
+  for ( Int y = iMinY; y <= iMaxY; y++ )
+  {
+    for ( Int x = iMinX; x <= iMaxX; x++ )
+    {
+      if ( m_iNumEntries >= m_iMaxEntries )
+      {
+        return;
+      }
+      if ( !getBlockKey( piOrg + y * iStride + x, iStride, uiKey ) )
+      {
+        continue;
+      }
+      Int iEntry = m_iNumEntries++;
+      m_puiKey[iEntry]  = uiKey;
+      m_piPos [iEntry]  = y * m_iWidth + x;
+      m_piNext[iEntry]  = m_piHead[uiKey & uiMask];
+      m_piHead[uiKey & uiMask] = iEntry;
+    }
+  }
+}
+
+#endif
+
+//! \}
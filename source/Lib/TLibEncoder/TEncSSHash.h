@@ -0,0 +1,99 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.  
+ *
+ * Copyright (c) 2010-2014, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncSSHash.h
+    \brief    hash table of the reconstructed blocks of the SS reference (header)
+*/
+
+#ifndef __TENCSSHASH__
+#define __TENCSSHASH__
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/TComPicYuv.h"
+
+//! \ingroup TLibEncoder
+//! \{
+
+#if IT_SS_HASH_SEARCH
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define SS_HASH_BLK_SIZE            8             ///< size of the block the key is computed on (top-left block of the PU)
+#define SS_HASH_MEAN_BITS           5             ///< precision of the sub-block means in the key
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// positions of the SS reference indexed by a signature of the 8x8 block starting there
+class TEncSSHash
+{
+private:
+  Int*    m_piHead;                               ///< first entry of each bucket, -1 when empty
+  Int*    m_piNext;                               ///< next entry of the same bucket
+  UInt*   m_puiKey;                               ///< full key of each entry
+  Int*    m_piPos;                                ///< luma position of each entry (y * width + x)
+  Int     m_iNumEntries;
+  Int     m_iMaxEntries;
+  Int     m_iBucketBits;
+  Int     m_iWidth;
+  Int     m_iHeight;
+
+  UInt    m_auiCrcTable[256];
+
+public:
+  TEncSSHash();
+  virtual ~TEncSSHash();
+
+  Void    create        ( Int iPicWidth, Int iPicHeight );
+  Void    destroy       ();
+  Void    reset         ( TComPicYuv* pcPicYuv );
+  Void    addCtu        ( TComPicYuv* pcPicYuv, Int iCtuPelX, Int iCtuPelY, Int iCtuWidth, Int iCtuHeight );
+
+  Bool    getBlockKey   ( const Pel* piSrc, Int iStride, UInt& ruiKey ) const;
+
+  Bool    isEmpty       () const          { return m_iNumEntries == 0; }
+  Int     getFirst      ( UInt uiKey ) const  { return m_piHead[ uiKey & ( ( 1 << m_iBucketBits ) - 1 ) ]; }
+  Int     getNext       ( Int iEntry ) const  { return m_piNext[iEntry]; }
+  UInt    getKey        ( Int iEntry ) const  { return m_puiKey[iEntry]; }
+  Int     getPosX       ( Int iEntry ) const  { return m_piPos[iEntry] % m_iWidth; }
+  Int     getPosY       ( Int iEntry ) const  { return m_piPos[iEntry] / m_iWidth; }
+};
+
+#endif
+
+//! \}
+
+#endif // __TENCSSHASH__
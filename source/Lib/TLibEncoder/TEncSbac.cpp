@@ -1068,6 +1068,10 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
   const TComCUMvField* pcCUGT2Field = pcCU->getCUGT2Field( eRefList );
   const TComCUMvField* pcCUGT3Field = pcCU->getCUGT3Field( eRefList );
   const Bool bGTFlag = pcCU->getGTFlag(uiAbsPartIdx);
+  const Bool bGTAffine = pcCU->getSlice()->getGTAffineFlag();
+#if IT_GT_CODING == 1
+  const Int  iGTMaxIteration = pcCU->getSlice()->getGTMaxIteration();
+#endif
 
   const Int iHorGT0 = pcCUGT0Field->getMv(uiAbsPartIdx).getHor();
   const Int iVerGT0 = pcCUGT0Field->getMv(uiAbsPartIdx).getVer();
@@ -1141,18 +1145,19 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 	  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 	  // Corner 3 / x=0? y=0?
-#if !IT_GT_AFFINE
-	  m_pcBinIf->encodeBin( iHorGT3 != 0 ? 1 : 0, *pCtx );
+	  if ( !bGTAffine )
+	  {
+		  m_pcBinIf->encodeBin( iHorGT3 != 0 ? 1 : 0, *pCtx );
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
-	  m_pcBinIf->encodeBin( iVerGT3 != 0 ? 1 : 0, *pCtx );
+		  m_pcBinIf->encodeBin( iVerGT3 != 0 ? 1 : 0, *pCtx );
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
-#endif
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
+	  }
 
 
 	  pCtx++;
@@ -1208,24 +1213,25 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 	  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 	  // Corner 3 / |x|>1? |y|>1?
-#if !IT_GT_AFFINE
-	  if( !C3_Hor_NULL )
+	  if ( !bGTAffine )
 	  {
-		  m_pcBinIf->encodeBin( uiHorGT3Abs > 1 ? 1 : 0, *pCtx );
-	  }
+		  if( !C3_Hor_NULL )
+		  {
+			  m_pcBinIf->encodeBin( uiHorGT3Abs > 1 ? 1 : 0, *pCtx );
+		  }
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
-	  if( !C3_Ver_NULL )
-	  {
-		  m_pcBinIf->encodeBin( uiVerGT3Abs > 1 ? 1 : 0, *pCtx );
-	  }
+		  if( !C3_Ver_NULL )
+		  {
+			  m_pcBinIf->encodeBin( uiVerGT3Abs > 1 ? 1 : 0, *pCtx );
+		  }
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
-#endif
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
+	  }
 
 
 	  // Corner 0 / |x|-2 and |y|-2 -> EP / signal(x,y) -> EP
@@ -1304,32 +1310,33 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 	  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 	  // Corner 3 / |x|-2 and |y|-2 -> EP / signal(x,y) -> EP
-#if !IT_GT_AFFINE
-	  if( !C3_Hor_NULL )
+	  if ( !bGTAffine )
 	  {
-		  if( uiHorGT3Abs > 1 )
+		  if( !C3_Hor_NULL )
 		  {
-			  xWriteEpExGolomb( uiHorGT3Abs-2, 1 );
+			  if( uiHorGT3Abs > 1 )
+			  {
+				  xWriteEpExGolomb( uiHorGT3Abs-2, 1 );
+			  }
+			  m_pcBinIf->encodeBinEP( 0 > iHorGT3 ? 1 : 0 );
 		  }
-		  m_pcBinIf->encodeBinEP( 0 > iHorGT3 ? 1 : 0 );
-	  }
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
-	  if( !C3_Ver_NULL )
-	  {
-		  if( uiVerGT3Abs > 1 )
+		  if( !C3_Ver_NULL )
 		  {
-			  xWriteEpExGolomb( uiVerGT3Abs-2, 1 );
+			  if( uiVerGT3Abs > 1 )
+			  {
+				  xWriteEpExGolomb( uiVerGT3Abs-2, 1 );
+			  }
+			  m_pcBinIf->encodeBinEP( 0 > iVerGT3 ? 1 : 0 );
 		  }
-		  m_pcBinIf->encodeBinEP( 0 > iVerGT3 ? 1 : 0 );
-	  }
 #if IT_GT_COUNT_BITS
-	  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-	  wBits = m_pcBinIf->getNumWrittenBits();
-#endif
+		  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+		  wBits = m_pcBinIf->getNumWrittenBits();
 #endif
+	  }
 
   }
 #endif
@@ -1361,16 +1368,17 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
   gt2 += m_pcBinIf->getNumWrittenBits() - wBits;
   wBits = m_pcBinIf->getNumWrittenBits();
 #endif
-#if !IT_GT_AFFINE
-	  if(C3_NULL)
-		  m_pcBinIf->encodeBin( 0, *pCtx );
-	  else
-		  m_pcBinIf->encodeBin( 1, *pCtx );
+	  if ( !bGTAffine )
+	  {
+		  if(C3_NULL)
+			  m_pcBinIf->encodeBin( 0, *pCtx );
+		  else
+			  m_pcBinIf->encodeBin( 1, *pCtx );
 #if IT_GT_COUNT_BITS
-  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-  wBits = m_pcBinIf->getNumWrittenBits();
-#endif
+    gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+    wBits = m_pcBinIf->getNumWrittenBits();
 #endif
+	  }
 	  pCtx++;
 
 	  //x or y == 0
@@ -1419,23 +1427,24 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
   wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 	  }
-#if !IT_GT_AFFINE
-	  if(!C3_NULL)
+	  if ( !bGTAffine )
 	  {
-		  if(C3_Hor_NULL)
-			  m_pcBinIf->encodeBin( 0, *pCtx );
-		  else
-			  m_pcBinIf->encodeBin( 1, *pCtx );
-		  if(C3_Ver_NULL)
-			  m_pcBinIf->encodeBin( 0, *pCtx );
-		  else
-			  m_pcBinIf->encodeBin( 1, *pCtx );
-#if IT_GT_COUNT_BITS
-  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-  wBits = m_pcBinIf->getNumWrittenBits();
+		  if(!C3_NULL)
+		  {
+			  if(C3_Hor_NULL)
+				  m_pcBinIf->encodeBin( 0, *pCtx );
+			  else
+				  m_pcBinIf->encodeBin( 1, *pCtx );
+			  if(C3_Ver_NULL)
+				  m_pcBinIf->encodeBin( 0, *pCtx );
+			  else
+				  m_pcBinIf->encodeBin( 1, *pCtx );
+#if IT_GT_COUNT_BITS
+    gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+    wBits = m_pcBinIf->getNumWrittenBits();
 #endif
+		  }
 	  }
-#endif
 
 	  // signal and abs
 	  if(!C0_NULL)
@@ -1443,16 +1452,18 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 		  if(!C0_Hor_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iHorGT0 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiHorGT0Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiHorGT0Abs, 1 );
+			  }
 		  }
 		  if(!C0_Ver_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iVerGT0 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiVerGT0Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiVerGT0Abs, 1 );
+			  }
 		  }
 #if IT_GT_COUNT_BITS
   gt0 += m_pcBinIf->getNumWrittenBits() - wBits;
@@ -1464,16 +1475,18 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 		  if(!C1_Hor_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iHorGT1 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiHorGT1Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiHorGT1Abs, 1 );
+			  }
 		  }
 		  if(!C1_Ver_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iVerGT1 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiVerGT1Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiVerGT1Abs, 1 );
+			  }
 		  }
 #if IT_GT_COUNT_BITS
   gt1 += m_pcBinIf->getNumWrittenBits() - wBits;
@@ -1485,45 +1498,50 @@ Void TEncSbac::codeGT( TComDataCU* pcCU, UInt uiAbsPartIdx, RefPicList eRefList
 		  if(!C2_Hor_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iHorGT2 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiHorGT2Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiHorGT2Abs, 1 );
+			  }
 		  }
 		  if(!C2_Ver_NULL)
 		  {
 			  m_pcBinIf->encodeBinEP( 0 > iVerGT2 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiVerGT2Abs, 1 );
-#endif
+			  if(iGTMaxIteration > 1)
+			  {
+				  xWriteEpExGolomb( uiVerGT2Abs, 1 );
+			  }
 		  }
 #if IT_GT_COUNT_BITS
   gt2 += m_pcBinIf->getNumWrittenBits() - wBits;
   wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 	  }
-#if !IT_GT_AFFINE
-	  if(!C3_NULL)
+	  if ( !bGTAffine )
 	  {
-		  if(!C3_Hor_NULL)
+		  if(!C3_NULL)
 		  {
-			  m_pcBinIf->encodeBinEP( 0 > iHorGT3 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiHorGT3Abs, 1 );
+			  if(!C3_Hor_NULL)
+			  {
+				  m_pcBinIf->encodeBinEP( 0 > iHorGT3 ? 1 : 0 );
+				  if(iGTMaxIteration > 1)
+				  {
+					  xWriteEpExGolomb( uiHorGT3Abs, 1 );
+				  }
+			  }
+			  if(!C3_Ver_NULL)
+			  {
+				  m_pcBinIf->encodeBinEP( 0 > iVerGT3 ? 1 : 0 );
+				  if(iGTMaxIteration > 1)
+				  {
+					  xWriteEpExGolomb( uiVerGT3Abs, 1 );
+				  }
+			  }
+#if IT_GT_COUNT_BITS
+    gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
+    wBits = m_pcBinIf->getNumWrittenBits();
 #endif
 		  }
-		  if(!C3_Ver_NULL)
-		  {
-			  m_pcBinIf->encodeBinEP( 0 > iVerGT3 ? 1 : 0 );
-#if IT_MAX_NSS_Iteration > 1
-			  xWriteEpExGolomb( uiVerGT3Abs, 1 );
-#endif
-		  }
-#if IT_GT_COUNT_BITS
-  gt3 += m_pcBinIf->getNumWrittenBits() - wBits;
-  wBits = m_pcBinIf->getNumWrittenBits();
-#endif
 	  }
-#endif
   }
 #endif
 #if ENC_DEC_TRACE && CU_ENC_DEC_TRAC
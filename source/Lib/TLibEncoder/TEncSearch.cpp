@@ -97,6 +97,26 @@ TEncSearch::TEncSearch()
   m_pcQTTempTComYuv  = NULL;
   m_pcEncCfg = NULL;
   m_pcEntropyCoder = NULL;
+#if IT_HOLOSS
+  m_pcSSRefYuv = NULL;
+#endif
+#if IT_SS_SEA
+  m_puiSEASum   = NULL;
+  m_iSEASumSize = 0;
+#endif
+#if IT_SS_SAD_CACHE
+  m_pusSSSadCache  = NULL;
+  m_puiSSSadStamp  = NULL;
+  m_uiSSSadStamp   = 0;
+  m_iSSSadRange    = 0;
+  m_iSSSadCtuAddr  = -1;
+  m_bSSSadCacheBlk = false;
+#endif
+#if IT_GT_PARALLEL_SEEDS
+  m_piGTSeedRef    = NULL;
+  m_piGTSeedAux    = NULL;
+  m_iGTSeedRefSize = 0;
+#endif
   m_pTempPel = NULL;
   m_pSharedPredTransformSkip[0] = m_pSharedPredTransformSkip[1] = m_pSharedPredTransformSkip[2] = NULL;
   m_pcQTTempTUCoeffY   = NULL;
@@ -110,6 +130,10 @@ TEncSearch::TEncSearch()
   m_puhQTTempTransformSkipFlag[0] = NULL;
   m_puhQTTempTransformSkipFlag[1] = NULL;
   m_puhQTTempTransformSkipFlag[2] = NULL;
+#if FAST_INTRA_REF_CACHE
+  m_uiIntraRefCachePartIdx = MAX_UINT;
+  ::memset( m_abIntraRefCacheValid, 0, sizeof( m_abIntraRefCacheValid ) );
+#endif
   setWpScalingDistParam( NULL, -1, REF_PIC_LIST_X );
 }
 
@@ -120,6 +144,25 @@ TEncSearch::~TEncSearch()
     delete [] m_pTempPel;
     m_pTempPel = NULL;
   }
+#if IT_SS_SEA
+  if ( m_puiSEASum )
+  {
+    delete [] m_puiSEASum;
+    m_puiSEASum = NULL;
+  }
+#endif
+#if IT_SS_SAD_CACHE
+  delete [] m_pusSSSadCache;
+  delete [] m_puiSSSadStamp;
+  m_pusSSSadCache = NULL;
+  m_puiSSSadStamp = NULL;
+#endif
+#if IT_GT_PARALLEL_SEEDS
+  delete [] m_piGTSeedRef;
+  delete [] m_piGTSeedAux;
+  m_piGTSeedRef = NULL;
+  m_piGTSeedAux = NULL;
+#endif
   
   if ( m_pcEncCfg )
   {
@@ -225,6 +268,17 @@ void TEncSearch::init(TEncCfg*      pcEncCfg,
   }
   
   initTempBuff();
+#if IT_GT && IT_GT_WARP_CACHE
+  m_cGTWarpCache.create( IT_GT_WARP_CACHE_SIZE, MAX_CU_SIZE, MAX_CU_SIZE );
+#endif
+#if IT_GT_PARALLEL_SEEDS
+  if ( pcEncCfg->getGTSearchThreads() > 0 )
+  {
+    m_iGTSeedRefSize = m_filteredBlock[0][0].getStride() * m_filteredBlock[0][0].getHeight();
+    m_piGTSeedRef    = new Pel[ pcEncCfg->getGTSearchThreads() * m_iGTSeedRefSize ];
+    m_piGTSeedAux    = new Pel[ pcEncCfg->getGTSearchThreads() * MAX_CU_SIZE * MAX_CU_SIZE ];
+  }
+#endif
   
   m_pTempPel = new Pel[g_uiMaxCUWidth*g_uiMaxCUHeight];
   
@@ -287,6 +341,11 @@ void TEncSearch::init(TEncCfg*      pcEncCfg,
 #define FIRSTSEARCHSTOP     0
 #endif
 
+#if IT_SS_SAD_CACHE
+#define SS_SAD_CACHE_MAX_RANGE      256     ///< largest vector component kept in the SS SAD cache
+#define SS_SAD_CACHE_EMPTY          0xFFFF  ///< 8x8 SAD not computed yet (a half 8x8 SAD fits in 15 bits up to 10-bit video)
+#endif
+
 #define TZ_SEARCH_CONFIGURATION                                                                                 \
 const Int  iRaster                  = 5;  /* TZ soll von aussen ?ergeben werden */                            \
 const Bool bTestOtherPredictedMV    = 0;                                                                      \
@@ -312,6 +371,26 @@ __inline Void TEncSearch::xTZSearchHelp( TComPattern* pcPatternKey, IntTZSearchS
   
   Pel*  piRefSrch;
   
+#if IT_HOLOSS
+  if ( rcStruct.bIsSSE )
+  {
+    // same causal constraints as the full SS search in xPatternSearch
+    if ( iSearchX < rcStruct.cSSRngLT.getHor() || iSearchX > rcStruct.cSSRngRB.getHor() ||
+         iSearchY < rcStruct.cSSRngLT.getVer() || iSearchY > rcStruct.cSSRngRB.getVer() )
+    {
+      return;
+    }
+    if ( ( iSearchX >= rcStruct.iSSOffsetX ) && ( iSearchY > rcStruct.iSSOffsetY ) )
+    {
+      return;
+    }
+    if ( iSearchX > xGetSSValidRight( iSearchY ) )
+    {
+      return;
+    }
+  }
+#endif
+
   piRefSrch = rcStruct.piRefY + iSearchY * rcStruct.iYStride + iSearchX;
   
   //-- jclee for using the SAD function pointer
@@ -330,7 +409,11 @@ __inline Void TEncSearch::xTZSearchHelp( TComPattern* pcPatternKey, IntTZSearchS
 
   // distortion
   m_cDistParam.bitDepth = g_bitDepthY;
+#if IT_SS_SAD_CACHE
+  uiSad = m_bSSSadCacheBlk ? xGetSSSad( iSearchX, iSearchY ) : m_cDistParam.DistFunc( &m_cDistParam );
+#else
   uiSad = m_cDistParam.DistFunc( &m_cDistParam );
+#endif
   
   // motion cost
   uiSad += m_pcRdCost->getCost( iSearchX, iSearchY );
@@ -344,6 +427,9 @@ __inline Void TEncSearch::xTZSearchHelp( TComPattern* pcPatternKey, IntTZSearchS
     rcStruct.uiBestRound    = 0;
     rcStruct.ucPointNr      = ucPointNr;
   }
+#if IT_HOLOSS && IT_SS_NUMBER_OF_BEST_CAND
+  rcStruct.pcSSBestCand->insert( iSearchX, iSearchY, uiSad );
+#endif
 }
 
 __inline Void TEncSearch::xTZ2PointSearch( TComPattern* pcPatternKey, IntTZSearchStruct& rcStruct, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB )
@@ -999,6 +1085,67 @@ TEncSearch::xGetIntraBitsQTChroma( TComDataCU*  pcCU,
   return uiBits;
 }
 
+#if FAST_INTRA_REF_CACHE
+/** Save the luma reference samples of a TU starting at the PU under test.
+ * Only the first row and column of the unfiltered and filtered buffers of m_piYuvExt are read by
+ * predIntraLumaAng, so they are the only samples kept.
+ * \param uiTrDepth   TU depth relative to the CU
+ * \param uiSize      TU size
+ * \param bAboveAvail availability returned by initAdiPattern
+ * \param bLeftAvail  availability returned by initAdiPattern
+ */
+Void TEncSearch::xStoreIntraRefCache( UInt uiTrDepth, UInt uiSize, Bool bAboveAvail, Bool bLeftAvail )
+{
+  assert( uiTrDepth < MAX_CU_DEPTH && uiSize <= MAX_CU_SIZE );
+  const Int  iLine  = 2 * uiSize + 1;
+  const UInt uiWH   = iLine * iLine;
+  Int*       piDst  = m_aiIntraRefCache[uiTrDepth];
+
+  for( Int iBuf = 0; iBuf < 2; iBuf++ )
+  {
+    const Int* piSrc = m_piYuvExt + iBuf * uiWH;
+    ::memcpy( piDst, piSrc, iLine * sizeof( Int ) );
+    piDst += iLine;
+    for( Int k = 1; k < iLine; k++ )
+    {
+      *piDst++ = piSrc[k * iLine];
+    }
+  }
+  m_abIntraRefCacheValid[uiTrDepth] = true;
+  m_abIntraRefCacheAbove[uiTrDepth] = bAboveAvail;
+  m_abIntraRefCacheLeft [uiTrDepth] = bLeftAvail;
+}
+
+/** Restore the luma reference samples saved by xStoreIntraRefCache into m_piYuvExt.
+ * \returns false when nothing is saved for this TU depth
+ */
+Bool TEncSearch::xLoadIntraRefCache( UInt uiTrDepth, UInt uiSize, Bool& rbAboveAvail, Bool& rbLeftAvail )
+{
+  assert( uiTrDepth < MAX_CU_DEPTH && uiSize <= MAX_CU_SIZE );
+  if( !m_abIntraRefCacheValid[uiTrDepth] )
+  {
+    return false;
+  }
+  const Int  iLine  = 2 * uiSize + 1;
+  const UInt uiWH   = iLine * iLine;
+  const Int* piSrc  = m_aiIntraRefCache[uiTrDepth];
+
+  for( Int iBuf = 0; iBuf < 2; iBuf++ )
+  {
+    Int* piDst = m_piYuvExt + iBuf * uiWH;
+    ::memcpy( piDst, piSrc, iLine * sizeof( Int ) );
+    piSrc += iLine;
+    for( Int k = 1; k < iLine; k++ )
+    {
+      piDst[k * iLine] = *piSrc++;
+    }
+  }
+  rbAboveAvail = m_abIntraRefCacheAbove[uiTrDepth];
+  rbLeftAvail  = m_abIntraRefCacheLeft [uiTrDepth];
+  return true;
+}
+#endif
+
 Void
 TEncSearch::xIntraCodingLumaBlk( TComDataCU* pcCU,
                                 UInt        uiTrDepth,
@@ -1039,7 +1186,20 @@ TEncSearch::xIntraCodingLumaBlk( TComDataCU* pcCU,
   if(default0Save1Load2 != 2)
   {
     pcCU->getPattern()->initPattern   ( pcCU, uiTrDepth, uiAbsPartIdx );
+#if FAST_INTRA_REF_CACHE
+    // the first TU of the PU under test only uses samples outside the PU, which do not change while its modes are tested
+    const Bool bRefCached = ( uiAbsPartIdx == m_uiIntraRefCachePartIdx );
+    if( !bRefCached || !xLoadIntraRefCache( uiTrDepth, uiWidth, bAboveAvail, bLeftAvail ) )
+    {
+      pcCU->getPattern()->initAdiPattern( pcCU, uiAbsPartIdx, uiTrDepth, m_piYuvExt, m_iYuvExtStride, m_iYuvExtHeight, bAboveAvail, bLeftAvail );
+      if( bRefCached )
+      {
+        xStoreIntraRefCache( uiTrDepth, uiWidth, bAboveAvail, bLeftAvail );
+      }
+    }
+#else
     pcCU->getPattern()->initAdiPattern( pcCU, uiAbsPartIdx, uiTrDepth, m_piYuvExt, m_iYuvExtStride, m_iYuvExtHeight, bAboveAvail, bLeftAvail );
+#endif
     //===== get prediction signal =====
     predIntraLumaAng( pcCU->getPattern(), uiLumaPredMode, piPred, uiStride, uiWidth, uiHeight, bAboveAvail, bLeftAvail );
     // save prediction 
@@ -2428,6 +2588,11 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
     Bool bLeftAvail  = false;
     pcCU->getPattern()->initPattern   ( pcCU, uiInitTrDepth, uiPartOffset );
     pcCU->getPattern()->initAdiPattern( pcCU, uiPartOffset, uiInitTrDepth, m_piYuvExt, m_iYuvExtStride, m_iYuvExtHeight, bAboveAvail, bLeftAvail );
+#if FAST_INTRA_REF_CACHE
+    m_uiIntraRefCachePartIdx = uiPartOffset;
+    ::memset( m_abIntraRefCacheValid, 0, sizeof( m_abIntraRefCacheValid ) );
+    xStoreIntraRefCache( uiInitTrDepth, uiWidth, bAboveAvail, bLeftAvail );
+#endif
     
     //===== determine set of modes to be tested (using prediction signal only) =====
     Int numModesAvailable     = 35; //total number of Intra modes
@@ -2609,6 +2774,9 @@ TEncSearch::estIntraPredQT( TComDataCU* pcCU,
       }
     } // Mode loop
 #endif
+#if FAST_INTRA_REF_CACHE
+    m_uiIntraRefCachePartIdx = MAX_UINT;
+#endif
     
     //--- update overall distortion ---
     uiOverallDistY += uiBestPUDistY;
@@ -3073,7 +3241,7 @@ Void TEncSearch::xMergeEstimation(  TComDataCU*   pcCU,
           TComMv cSSMv = pcCU->getCUMvField( REF_PIC_LIST_0 )->getMv(uiAbsPartIdx);
           pcCU->clipMv(cSSMv);
           TComPicYuv* pcPicYuvRef = pcCU->getSlice()->getRefPic( REF_PIC_LIST_0, iRefIdx )->getPicYuvRec();
-          if ( !m_pcRdCost->isValidPattern( pcPicYuvRef->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiAbsPartIdx ), pcPicYuvRef->getStride(), cSSMv, iWidth, iHeight) )
+          if ( !pcPicYuvRef->isSSValidBlock( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiAbsPartIdx, cSSMv, iWidth, iHeight ) )
           {
             uiCostCand = MAX_UINT;
             continue;
@@ -4428,7 +4596,7 @@ UInt TEncSearch::xGetTemplateCost( TComDataCU* pcCU,
         // SS reference is in the last position of the list 0:
         ( iRefIdx == pcCU->getSlice()->getRefIdxOfSS() ) && 
         // See if it is valid or not. Here, not to need to clip MV - it is already done on fillMvpCand:
-        ( !m_pcRdCost->isValidPattern( pcPicYuvRef->getLumaAddr( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr ), pcPicYuvRef->getStride(), cMvCand, iSizeX, iSizeY) )
+        ( !pcPicYuvRef->isSSValidBlock( pcCU->getAddr(), pcCU->getZorderIdxInCU() + uiPartAddr, cMvCand, iSizeX, iSizeY ) )
      )
   {
     return uiCost;
@@ -4560,6 +4728,10 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU,
   m_pcRdCost->setCostScale  ( 2 );
 
   setWpScalingDistParam( pcCU, iRefIdxPred, eRefPicList );
+#if IT_SS_NUMBER_OF_BEST_CAND
+  // seeds of the GT search come from the integer search of this reference only
+  pcCU->getSSBestCand()->init( m_pcEncCfg->getSSBestCandNum(), m_pcEncCfg->getSSBestCandDist() );
+#endif
   //  Do integer search
 #if IT_HOLOSS
    // SS reference is in the last position of List 0
@@ -4568,14 +4740,50 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU,
 
 #if IT_SCALABLE_V1
   bIsSSE = pcCU->getSlice()->isScalableSlice() ? false : bIsSSE;
+#endif
+#if IT_HOLOSS
+  if ( bIsSSE )
+  {
+    Int iPSW, iPSH;
+    m_pcSSRefYuv = pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec();
+    pcCU->getPartPosition( iPartIdx, m_iSSBlkPelX, m_iSSBlkPelY, iPSW, iPSH );
+    m_iSSBlkWidth  = iRoiWidth;
+    m_iSSBlkHeight = iRoiHeight;
+    xSetSearchRange   (pcCU, cMvSrchRngLT, cMvSrchRngRB, iOffsetX, iOffsetY, bisFirstRow, bisFirstCol);
+  }
+#endif
+#if IT_SS_SAD_CACHE
+  // blocks on the 8x8 grid of the CTU, original samples not modified for bi-prediction
+  m_bSSSadCacheBlk = bIsSSE && !bBi && m_pcEncCfg->getUseSSSadCache() && g_bitDepthY <= 10 &&
+                     ( m_iSSSadCtuAddr == (Int)pcCU->getAddr() ) && ( m_pusSSSadCache != NULL ) &&
+                     ( ( ( m_iSSBlkPelX - m_iSSSadCtuX ) | ( m_iSSBlkPelY - m_iSSSadCtuY ) | iRoiWidth | iRoiHeight ) & 7 ) == 0;
+#endif
+#if IT_SS_HASH_SEARCH
+#if !IT_SS_NUMBER_OF_BEST_CAND
+  if ( bIsSSE && !bBi && m_pcEncCfg->getUseSSHashSearch() && xPatternSearchHash( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY ) )
+#else
+  if ( bIsSSE && !bBi && m_pcEncCfg->getUseSSHashSearch() && xPatternSearchHash( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY, pcCU->getSSBestCand() ) )
+#endif
+  {
+    // close enough hash match, no window search needed
+  }
+  else
+#endif
+#if IT_SS_MI_LATTICE_SEARCH
+  // the lattice is anchored at the block position while the bi-prediction window is centred on rcMv, so bi-prediction keeps the window search
+  if ( bIsSSE && !bBi && m_pcEncCfg->getUseMILatticeSearch() && pcCU->getSlice()->getMicroImSize() > 0 )
+  {
+#if !IT_SS_NUMBER_OF_BEST_CAND
+    xPatternSearchMILattice ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY );
+#else
+    xPatternSearchMILattice ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY, pcCU->getSSBestCand() );
+#endif
+  }
+  else
 #endif
   if ( !m_iFastSearch || bBi )
   {
 #if IT_HOLOSS
-    if ( bIsSSE )
-    {
-      xSetSearchRange   (pcCU, cMvSrchRngLT, cMvSrchRngRB, iOffsetX, iOffsetY, bisFirstRow, bisFirstCol);
-    }
 #if !IT_SS_NUMBER_OF_BEST_CAND
     xPatternSearch      ( pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY, bIsSSE );
 #else
@@ -4587,22 +4795,23 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU,
   }
   else
   {
+    rcMv = *pcMvPred;
 #if IT_HOLOSS
-    if ( bIsSSE )
-    {
-      printf("IT development for non-scalable codec does not support fast search (TZ search)...");
-      exit(0);
-    }
+#if !IT_SS_NUMBER_OF_BEST_CAND
+    xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY, bIsSSE );
+#else
+    xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost, iOffsetX, iOffsetY, pcCU->getSSBestCand(), bIsSSE );
 #endif
-    rcMv = *pcMvPred;
+#else
     xPatternSearchFast  ( pcCU, pcPatternKey, piRefY, iRefStride, &cMvSrchRngLT, &cMvSrchRngRB, rcMv, ruiCost );
+#endif
   }
  #if IT_HOLOSS
   if ( bIsSSE )
   {
     if( ( ruiCost == MAX_UINT ) || 
         ( (rcMv.getHor() == 0)&&(rcMv.getVer() == 0) )  ||
-        ( pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->getBufY()[0x00] == NOT_VALID )
+        ( !pcCU->getSlice()->getRefPic( eRefPicList, iRefIdxPred )->getPicYuvRec()->isSSValid( 0, 0 ) )
     )
     {
       // means that the vector is not valid and cannot continue with fractional estimation!
@@ -4627,9 +4836,23 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU,
   if(bUseGT)
   {
 #if !IT_SS_NUMBER_OF_BEST_CAND
-	  xPatternSearchGT( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi );
+	  if ( pcCU->getSlice()->getGTAffineFlag() )
+	  {
+		  xPatternSearchGT<true> ( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi );
+	  }
+	  else
+	  {
+		  xPatternSearchGT<false>( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi );
+	  }
 #else
-	  xPatternSearchGT( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi, pcCU->getSSBestCand() );
+	  if ( pcCU->getSlice()->getGTAffineFlag() )
+	  {
+		  xPatternSearchGT<true> ( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi, pcCU->getSSBestCand() );
+	  }
+	  else
+	  {
+		  xPatternSearchGT<false>( pcCU, pcPatternKey, piRefY, iRefStride, &rcMv, &cMvHalf, &cMvQter, &rcGT0, &rcGT1, &rcGT2, &rcGT3, gtFlag, ruiCost,bBi, pcCU->getSSBestCand() );
+	  }
 #endif
   }
   else
@@ -4683,6 +4906,359 @@ Void TEncSearch::xMotionEstimation( TComDataCU* pcCU,
 }
 
 #if IT_GT
+/** Add the warp distortion of a GT candidate to the cost of its side information
+ * The warp is skipped when uiCost already reaches uiCostBound, and measured only up to the distortion that still
+ * improves on it otherwise, through rcDistParam.uiMaxCost.
+ * \param uiCost      cost of the SS vector and GT corners of the candidate
+ * \param uiCostBound cost the candidate has to improve on
+ * \returns cost of the candidate, at least uiCostBound when it is discarded
+ */
+UInt TEncSearch::xGTWarpCost( Pel* piRefSrch, Pel* piAux, GTWarpParam& rcParam, Int iCols, Int iRows, Int iRefSrchStride, Int iNSSWindow, DistParam& rcDistParam, UInt uiCost, UInt uiCostBound )
+{
+  if ( uiCost >= uiCostBound )
+  {
+    return uiCost;
+  }
+  rcDistParam.uiMaxCost = uiCostBound - uiCost;
+  return uiCost + GTWarpDistortion( piRefSrch, piAux, rcParam, iCols, iRows, iRefSrchStride, iNSSWindow, rcDistParam, m_pcEncCfg->getUseHADME() );
+}
+
+#if IT_GT_SEARCH == 2
+/** Diamond search of the GT corners around one SS seed
+ * \param piRefSrch         up-sampled reference of the seed, at the top-left sample of the block
+ * \param piRefSrchStride   stride of piRefSrch
+ * \param piAux             warp buffer of the block
+ * \param rcDistParam       distortion parameters of the block, pCur is piAux
+ * \param iMaxNSSIteration  number of halvings of the corner step
+ * \param lastIterationStep corner step of the last iteration
+ * \param Hor               seed vector (1/4 pel)
+ * \param Ver               seed vector (1/4 pel)
+ * \param uiDistBest        cost to improve on, updated with the cost of the best corners
+ * \param iBestCornerX      best corners, updated when the seed improves on uiDistBest
+ * \param iBestCornerY      best corners, updated when the seed improves on uiDistBest
+ * \returns true if the seed improved on uiDistBest
+ */
+template <Bool bAffine>
+Bool TEncSearch::xGTDiamondSearch( Pel* piRefSrch, Int piRefSrchStride, Pel* piAux, DistParam& rcDistParam, Int iCols, Int iRows, Int iNSSWindow, Int iMaxNSSIteration, Int lastIterationStep, Short Hor, Short Ver, UInt& uiDistBest, Int* iBestCornerX, Int* iBestCornerY )
+{
+	Int iCurrCornerX[4], iCurrCornerY[4];
+	Int iBestNSSCenterX[4], iBestNSSCenterY[4];
+	Int iCurrNSSCenterX[4], iCurrNSSCenterY[4];
+	Int iNSSIteration[4];
+	Int i0, i1, i2, i3;
+	Int marginX = 0, marginY = 0; // negative values allow causal area search
+	UInt uiDist;
+	GTWarpParam dProjective;
+	Bool bImproved = false;
+
+	rcDistParam.uiComp   = 0;
+	rcDistParam.bitDepth = g_bitDepthY;
+
+	iNSSIteration[0] = 1;
+	for (Int j0 = iNSSWindow; (j0 > 1) && (iNSSIteration[0] <= iMaxNSSIteration); j0 /= 2){
+		iNSSIteration[0]++;
+		if (j0 == iNSSWindow){
+			iCurrNSSCenterX[0] = iBestNSSCenterX[0] = 0;
+			iCurrNSSCenterY[0] = iBestNSSCenterY[0] = 0;
+#if IT_Independent_Iterations
+#if IT_GT_GRID_SIZE == 1
+			iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols - 1;
+			iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
+			iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols - 1;
+			iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows - 1;
+			iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
+			iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows - 1;
+#else
+			iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols*IT_GT_GRID_SIZE - 1;
+			iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
+			iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols*IT_GT_GRID_SIZE - 1;
+			iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows*IT_GT_GRID_SIZE - 1;
+			iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
+			iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows*IT_GT_GRID_SIZE - 1;
+#endif
+#endif
+		}
+		else{
+			iCurrNSSCenterX[0] = iBestNSSCenterX[0];
+			iCurrNSSCenterY[0] = iBestNSSCenterY[0];
+#if IT_Independent_Iterations
+			iCurrNSSCenterX[1] = iBestNSSCenterX[1];
+			iCurrNSSCenterY[1] = iBestNSSCenterY[1];
+			iCurrNSSCenterX[2] = iBestNSSCenterX[2];
+			iCurrNSSCenterY[2] = iBestNSSCenterY[2];
+			iCurrNSSCenterX[3] = iBestNSSCenterX[3];
+			iCurrNSSCenterY[3] = iBestNSSCenterY[3];
+#endif
+		}//------------------------------------------ corner 0 ---------------------------------------------------//
+		i0 = j0;
+		for (Int y0 = i0 / 2; y0 >= -i0 / 2; y0 -= i0 / 2) {
+			iCurrCornerY[0] = iCurrNSSCenterY[0] + y0;
+			for (Int x0 = i0 / 2; x0 >= -i0 / 2; x0 -= i0 / 2) {
+				if((y0 != 0 && x0 == 0 ) || (y0 == 0 && x0 != 0 ) || (y0 == 0 && x0 == 0 )){
+					iCurrCornerX[0] = iCurrNSSCenterX[0] + x0;
+#if !IT_Independent_Iterations
+					iNSSIteration[1] = 1;
+					for (Int j1 = iNSSWindow; (j1 > 1) && (iNSSIteration[1] <= iMaxNSSIteration); j1 /= 2){
+						iNSSIteration[1]++;
+						if (j1 == iNSSWindow){
+							iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols - 1;
+							iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
+						}
+						else{
+							iCurrNSSCenterX[1] = iBestNSSCenterX[1];
+							iCurrNSSCenterY[1] = iBestNSSCenterY[1];
+						}
+						i1 = j1;
+#else
+						i1 = j0;
+#endif
+						//-------------------------------------- corner 1 ------------------------------------------------------//
+						for (Int y1 = i1 / 2; y1 >= -i1 / 2; y1 -= i1 / 2) {
+							iCurrCornerY[1] = iCurrNSSCenterY[1] + y1;
+							for (Int x1 = i1 / 2; x1 >= -i1 / 2; x1 -= i1 / 2) {
+								if((y1 != 0 && x1 == 0 ) || (y1 == 0 && x1 != 0 ) || (y1 == 0 && x1 == 0 )){
+									iCurrCornerX[1] = iCurrNSSCenterX[1] + x1;
+#if !IT_Independent_Iterations
+									iNSSIteration[2] = 1;
+									for (Int j2 = iNSSWindow; (j2 > 1) && (iNSSIteration[2] <= iMaxNSSIteration); j2 /= 2){
+										iNSSIteration[2]++;
+										if (j2 == iNSSWindow){
+											iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols - 1;
+											iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows - 1;
+										}
+										else{
+											iCurrNSSCenterX[2] = iBestNSSCenterX[2];
+											iCurrNSSCenterY[2] = iBestNSSCenterY[2];
+										}
+										i2 = j2;
+#else
+										i2 = j0;
+#endif
+										//-------------------------------------- corner 2 ------------------------------------------------------//
+										for (Int y2 = i2 / 2; y2 >= -i2 / 2; y2 -= i2 / 2) {
+											iCurrCornerY[2] = iCurrNSSCenterY[2] + y2;
+											for (Int x2 = i2 / 2; x2 >= -i2 / 2; x2 -= i2 / 2) {
+												if((y2 != 0 && x2 == 0 ) || (y2 == 0 && x2 != 0 ) || (y2 == 0 && x2 == 0 )){
+													iCurrCornerX[2] = iCurrNSSCenterX[2] + x2;
+#if !IT_Independent_Iterations
+													iNSSIteration[3] = 1;
+													for (Int j3 = iNSSWindow; (j3 > 1) && (iNSSIteration[3] <= iMaxNSSIteration); j3 /= 2){
+														iNSSIteration[3]++;
+														if (j3 == iNSSWindow){
+															iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
+															iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows - 1;
+														}
+														else{
+															iCurrNSSCenterX[3] = iBestNSSCenterX[3];
+															iCurrNSSCenterY[3] = iBestNSSCenterY[3];
+														}
+														i3 = j3;
+#else
+														i3 = j0;
+#endif
+														//-------------------------------------- corner 3 ------------------------------------------------------//
+														for (Int y3 = i3 / 2; y3 >= -i3 / 2; y3 -= i3 / 2) {
+															iCurrCornerY[3] = iCurrNSSCenterY[3] + y3;
+															for (Int x3 = i3 / 2; x3 >= -i3 / 2; x3 -= i3 / 2) {
+																if((y3 != 0 && x3 == 0 ) || (y3 == 0 && x3 != 0 ) || (y3 == 0 && x3 == 0 )){
+																	iCurrCornerX[3] = iCurrNSSCenterX[3] + x3;
+																	// if not translation
+																	if ( !(x0 == x1  && x0 == x2 && x0 == x3 && y0 == y1 && y0 == y2 && y0 == y3) )
+																	{
+#if IT_GT_GRID_SIZE < 2
+																		// valid GT location
+																		if(((x0 + (Hor >> 2)        < -marginX  && y0 + (Ver >> 2)        <= -marginY)  || (x0 + (Hor >> 2)         >= -marginX  && y0 + (Ver >> 2)         < -marginY))  &&
+																			((x1 + (Hor >> 2) +iCols < -marginX  && y1 + (Ver >> 2)        <= -marginY)  || (x1 + (Hor >> 2) +iCols  >= -marginX  && y1 + (Ver >> 2)         < -marginY))  &&
+																			((x2 + (Hor >> 2) +iCols < -marginX  && y2 + (Ver >> 2) +iRows <= -marginY)  || (x2 + (Hor >> 2) +iCols  >= -marginX  && y2 + (Ver >> 2) +iRows  < -marginY))  &&
+																			((x3 + (Hor >> 2)        < -marginX  && y3 + (Ver >> 2) +iRows <= -marginY)  || (x3 + (Hor >> 2)         >= -marginX  && y3 + (Ver >> 2) +iRows  < -marginY))    )
+																		{
+#else
+																			// valid GT location
+																			/*if((((x0 / IT_GT_GRID_SIZE) + (Hor >> 2)        < -marginX  && (y0 / IT_GT_GRID_SIZE) + (Ver >> 2)        <= -marginY)  || ((x0 / IT_GT_GRID_SIZE) + (Hor >> 2)         >= -marginX  && (y0 / IT_GT_GRID_SIZE) + (Ver >> 2)         < -marginY))  &&
+																			(((x1 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols 	< -marginX  && (y1 / IT_GT_GRID_SIZE) + (Ver >> 2)        <= -marginY)  || ((x1 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols  >= -marginX  && (y1 / IT_GT_GRID_SIZE) + (Ver >> 2)         < -marginY))  &&
+																			(((x2 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols 	< -marginX  && (y2 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows <= -marginY)  || ((x2 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols  >= -marginX  && (y2 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows  < -marginY))  &&
+																			(((x3 / IT_GT_GRID_SIZE) + (Hor >> 2)        	< -marginX  && (y3 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows <= -marginY)  || ((x3 / IT_GT_GRID_SIZE) + (Hor >> 2)         >= -marginX  && (y3 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows  < -marginY))    )*/
+																			if(1)
+																			{
+#endif
+#if IT_GT_FIXED_POINT_WARP
+																				// the affine search rejects the other transforms, which are not even derived
+																				if ( bAffine && !isGTAffineCorners( iCurrCornerX, iCurrCornerY, IT_GT_BILINEAR_TRANSFORMATION ) )
+																				{
+																					continue;
+																				}
+#endif
+// calculate gt param
+#if IT_GT_GRID_SIZE < 2
+#if !IT_GT_BILINEAR_TRANSFORMATION
+																				calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
+#else
+																				calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
+#endif
+#else
+#if !IT_GT_BILINEAR_TRANSFORMATION
+																			calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE);
+#else
+																			calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE);
+#endif
+#endif
+#if !IT_GT_BILINEAR_TRANSFORMATION
+																			if( !bAffine || dProjective.bAffine ){ // AFFINE
+#else
+																				if( !bAffine || dProjective.bAffine ){ // AFFINE
+#endif
+																				uiDist  = m_pcRdCost->getCost( Hor , Ver );
+																				uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
+#if IT_GT_GRID_SIZE < 2
+																						(iCurrCornerX[0])/lastIterationStep				, (iCurrCornerY[0])/lastIterationStep			,
+																						(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])        /lastIterationStep   ,
+																						(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep,
+																						(iCurrCornerX[3])/lastIterationStep				, (iCurrCornerY[3] - iRows +1)/lastIterationStep)
+#else
+																						(iCurrCornerX[0])/lastIterationStep								, (iCurrCornerY[0])/lastIterationStep			,
+																						(iCurrCornerX[1] - iCols*IT_GT_GRID_SIZE +1)/lastIterationStep  , (iCurrCornerY[1])        /lastIterationStep   ,
+																						(iCurrCornerX[2] - iCols*IT_GT_GRID_SIZE +1)/lastIterationStep  , (iCurrCornerY[2] - iRows*IT_GT_GRID_SIZE +1)/lastIterationStep,
+																						(iCurrCornerX[3])/lastIterationStep								, (iCurrCornerY[3] - iRows*IT_GT_GRID_SIZE +1)/lastIterationStep)
+#endif
+																				);
+#if IT_GT_GRID_SIZE < 2
+																				uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, rcDistParam, uiDist, uiDistBest);
+#else
+																				uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE, piRefSrchStride, iNSSWindow, rcDistParam, uiDist, uiDistBest);
+#endif
+																				// GT COST
+																				// check if best
+																				if (uiDist < uiDistBest)
+																				{
+																					uiDistBest = uiDist;
+																					iBestCornerX[0] = iCurrCornerX[0];
+																					iBestCornerX[1] = iCurrCornerX[1];
+																					iBestCornerX[2] = iCurrCornerX[2];
+																					iBestCornerX[3] = iCurrCornerX[3];
+																					iBestCornerY[0] = iCurrCornerY[0];
+																					iBestCornerY[1] = iCurrCornerY[1];
+																					iBestCornerY[2] = iCurrCornerY[2];
+																					iBestCornerY[3] = iCurrCornerY[3];
+																					iBestNSSCenterX[0] = iCurrCornerX[0];
+																					iBestNSSCenterX[1] = iCurrCornerX[1];
+																					iBestNSSCenterX[2] = iCurrCornerX[2];
+																					iBestNSSCenterX[3] = iCurrCornerX[3];
+																					iBestNSSCenterY[0] = iCurrCornerY[0];
+																					iBestNSSCenterY[1] = iCurrCornerY[1];
+																					iBestNSSCenterY[2] = iCurrCornerY[2];
+																					iBestNSSCenterY[3] = iCurrCornerY[3];
+																					bImproved = true;
+																				}
+																			}
+																		}
+																	}
+																}
+															}
+														} // CORNER 3
+#if !IT_Independent_Iterations
+													}
+#endif
+												}
+											}
+										} // CORNER 2
+#if !IT_Independent_Iterations
+									}
+#endif
+								}
+							}
+						} // CORNER 1
+#if !IT_Independent_Iterations
+					}
+#endif
+				}
+			}
+		} // CORNER 0
+	}
+
+	return bImproved;
+}
+#endif
+
+#if IT_SS_NUMBER_OF_BEST_CAND && !IT_SS_QUARTER_PEL
+/** Copy the search window of an integer SS seed
+ * The samples are clipped like the output of the interpolation filters, which also maps the unavailable
+ * samples of the SS reference (-1) to 0.
+ * \param piSrc      top-left sample of the window in the reference
+ * \param iSrcStride stride of the reference
+ * \param piDst      destination window
+ * \param iDstStride stride of the destination
+ * \param iWidth     width of the window
+ * \param iHeight    height of the window
+ */
+Void TEncSearch::xGTCopySeedWindow( const Pel* piSrc, Int iSrcStride, Pel* piDst, Int iDstStride, Int iWidth, Int iHeight )
+{
+	const Pel iMaxVal = ( 1 << g_bitDepthY ) - 1;
+	for ( Int y = 0; y < iHeight; y++ )
+	{
+		for ( Int x = 0; x < iWidth; x++ )
+		{
+			piDst[x] = Clip3<Pel>( 0, iMaxVal, piSrc[x] );
+		}
+		piSrc += iSrcStride;
+		piDst += iDstStride;
+	}
+}
+#endif
+
+#if IT_GT_PARALLEL_SEEDS && IT_SS_NUMBER_OF_BEST_CAND
+/** Refine a batch of SS seeds of the GT diamond search independently of each other, in parallel with OpenMP
+ * Every seed starts from the reference cost and the cheapest result is kept, the first seed on ties,
+ * so the result does not depend on the number of threads.
+ * \param iNumSeeds         number of seeds of the batch
+ * \param piSeedHor         seed vectors (1/4 pel)
+ * \param piSeedVer         seed vectors (1/4 pel)
+ * \param ppiSeedRef        search window of each seed, at the top-left sample of the block
+ * \param uiRefCost         reference cost, cost of the block without GT
+ * \param ruiDistBest       cost of the best corners, updated by the seeds that improve on it
+ * \param riBestSSX         seed vector of the best corners
+ * \param riBestSSY         seed vector of the best corners
+ */
+template <Bool bAffine>
+Void TEncSearch::xGTRefineSeeds( Int iNumSeeds, const Short* piSeedHor, const Short* piSeedVer, Pel* const* ppiSeedRef, Int piRefSrchStride, Int iCols, Int iRows, Int iNSSWindow, Int iMaxNSSIteration, Int lastIterationStep,
+                                 UInt uiRefCost, UInt& ruiDistBest, Int* iBestCornerX, Int* iBestCornerY, Int& riBestSSX, Int& riBestSSY )
+{
+	UInt auiDist[IT_GT_MAX_SEARCH_THREADS];
+	Int  aiCornerX[IT_GT_MAX_SEARCH_THREADS][4], aiCornerY[IT_GT_MAX_SEARCH_THREADS][4];
+	Bool abImproved[IT_GT_MAX_SEARCH_THREADS];
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(iNumSeeds) schedule(static, 1)
+#endif
+	for ( Int k = 0; k < iNumSeeds; k++ )
+	{
+		Pel*      piAux      = m_piGTSeedAux + k * MAX_CU_SIZE * MAX_CU_SIZE;
+		DistParam cDistParam = m_cDistParam;
+		cDistParam.pCur = piAux;
+		auiDist[k]      = uiRefCost;
+		abImproved[k]   = xGTDiamondSearch<bAffine>( ppiSeedRef[k], piRefSrchStride, piAux, cDistParam, iCols, iRows, iNSSWindow,
+		                                             iMaxNSSIteration, lastIterationStep, piSeedHor[k], piSeedVer[k], auiDist[k], aiCornerX[k], aiCornerY[k] );
+	}
+
+	for ( Int k = 0; k < iNumSeeds; k++ )
+	{
+		if ( abImproved[k] && auiDist[k] < ruiDistBest )
+		{
+			ruiDistBest = auiDist[k];
+			for ( Int i = 0; i < 4; i++ )
+			{
+				iBestCornerX[i] = aiCornerX[k][i];
+				iBestCornerY[i] = aiCornerY[k][i];
+			}
+			riBestSSX = piSeedHor[k];
+			riBestSSY = piSeedVer[k];
+		}
+	}
+}
+#endif
+#endif
+
+#if IT_GT
+template <Bool bAffine>
 Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
                                        TComPattern* pcPatternKey,
                                        Pel* piRefY,
@@ -4698,7 +5274,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
                                        UInt& ruiCost
                                        ,Bool biPred
 #if IT_SS_NUMBER_OF_BEST_CAND
-										 ,TComMv* bestSSCand
+										 ,TComMvTopK* bestSSCand
 #endif
                                        )
 {
@@ -4727,32 +5303,48 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	Int iCols = pcPatternKey->getROIYWidth();
 	Int iOffset = pcMvInt->getHor() - iCols/2 + (pcMvInt->getVer() - iRows/2) * iRefStride;
 	Int piRefSrchStride = m_filteredBlock[0][0].getStride();
+	Pel* piRefSrch;
 
-	cPatternRoi.initPattern( piRefY +  iOffset, NULL, NULL, iCols * 2, iRows * 2, iRefStride, 0, 0 );
-
-	xExtDIFUpSamplingH ( &cPatternRoi, biPred );
-	xExtDIFUpSamplingQ ( &cPatternRoi, *rcMvHalf, biPred );
-
-	Pel* piRefSrch = m_filteredBlock[ Ver & 3 ][ Hor & 3 ].getLumaAddr();
-	if ( Hor == 2 && ( Ver & 1 ) == 0 )
+#if IT_GT_SEARCH == 2 && IT_SS_NUMBER_OF_BEST_CAND && !IT_SS_QUARTER_PEL
+	// the diamond search reads its integer seeds from the reference, only the gradient search reads the sub-pel vector
+	if ( m_pcEncCfg->getGTGradientSearch() == 0 )
 	{
-		piRefSrch += 1;
+		piRefSrchStride = iRefStride;
+		piRefSrch       = piRefY + iOffset + (iCols/2) + (iRows/2) * iRefStride;
 	}
-	if ( ( Hor & 1 ) == 0 && Ver == 2 )
+	else
+#endif
 	{
-		piRefSrch += m_filteredBlock[0][0].getStride();
-	}
+		cPatternRoi.initPattern( piRefY +  iOffset, NULL, NULL, iCols * 2, iRows * 2, iRefStride, 0, 0 );
 
-	piRefSrch += (iCols/2) + (iRows/2) * piRefSrchStride; // inside block (jump the margin pixels)
+		xExtDIFUpSamplingH ( &cPatternRoi, biPred );
+		xExtDIFUpSamplingQ ( &cPatternRoi, *rcMvHalf, biPred );
 
-	// BMGT variables
-	Pel* piAux = (Pel*)xMalloc(Pel, (iRows * iCols));
-	Double dProjective[9];
-	Int iBestCornerX[4], iBestCornerY[4];
-	Int iCurrCornerX[4], iCurrCornerY[4];
-	Int iBestNSSCenterX[4], iBestNSSCenterY[4];
+		piRefSrch = m_filteredBlock[ Ver & 3 ][ Hor & 3 ].getLumaAddr();
+		if ( Hor == 2 && ( Ver & 1 ) == 0 )
+		{
+			piRefSrch += 1;
+		}
+		if ( ( Hor & 1 ) == 0 && Ver == 2 )
+		{
+			piRefSrch += m_filteredBlock[0][0].getStride();
+		}
+
+		piRefSrch += (iCols/2) + (iRows/2) * piRefSrchStride; // inside block (jump the margin pixels)
+	}
+
+	// BMGT variables
+	UInt uiScratchMark = m_cGTScratch.getMark();
+	Pel* piAux = m_cGTScratch.alloc<Pel>( iRows * iCols );
+	GTWarpParam dProjective;
+	Int iBestCornerX[4], iBestCornerY[4];
+#if IT_GT_SEARCH != 2 // the diamond search keeps its corners in xGTDiamondSearch
+	Int iCurrCornerX[4], iCurrCornerY[4];
+	Int iBestNSSCenterX[4], iBestNSSCenterY[4];
 	Int iCurrNSSCenterX[4], iCurrNSSCenterY[4];
-	Int iNSSIteration[4], iMaxNSSIteration = IT_MAX_NSS_Iteration;
+	Int iNSSIteration[4];
+#endif
+	Int iMaxNSSIteration = m_iGTMaxIteration;
 	Int iNSSWindow = ((iRows < iCols) ? (iRows) : (iCols)) >> 1; // 64x32 -> 32 -> Window 16x16
 #if IT_GT_GRID_SIZE > 1
 	iNSSWindow *= IT_GT_GRID_SIZE;
@@ -4764,19 +5356,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	if(lastIterationStep == 0)
 		lastIterationStep = 1;
 
+#if IT_GT_SEARCH != 2
 	Int i0, i1, i2, i3;
 	Int marginX = 0, marginY = 0; // negative values allow causal area search
-	UInt uiDist, uiDistBest = ruiCost; // REFERENCE COST!
+	UInt uiDist;
+#endif
+	UInt uiDistBest = ruiCost; // REFERENCE COST!
 
 	// init variables
 	m_pcRdCost->setDistParam( pcPatternKey, piAux, iCols, 1, m_cDistParam, m_pcEncCfg->getUseHADME() );
+#if IT_GT_SEARCH != 2
 	uiDist = uiDistBest;
+#endif
 	//Hor += pcMvInt->getHor() << 2;
 	//Ver += pcMvInt->getVer() << 2;
 	for (Int k = 0; k < 4; k++){ iBestCornerX[k] = 0; iBestCornerY[k] = 0; }
-	dProjective[0] = 1.0; dProjective[1] = 0.0; dProjective[2] = 0.0;
-	dProjective[3] = 0.0; dProjective[4] = 1.0; dProjective[5] = 0.0;
-	dProjective[6] = 0.0; dProjective[7] = 0.0; dProjective[8] = 1.0;
+#if IT_GT_SEARCH != 2
 #if IT_GT_GRID_SIZE == 1
 	iCurrNSSCenterX[0] = iBestNSSCenterX[0] = 0;          iCurrNSSCenterY[0] = iBestNSSCenterY[0] = 0;
 	iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols - 1;  iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
@@ -4788,11 +5383,30 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols*IT_GT_GRID_SIZE - 1;  	iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows*IT_GT_GRID_SIZE - 1;
 	iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;         			 		iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows*IT_GT_GRID_SIZE - 1;
 #endif
+#endif
 
 #if IT_DEBUG
 	cout << "SS - " << Hor << " " << Ver << endl;
 #endif
 
+#if IT_GT_FIXED_POINT_WARP
+	if ( m_pcEncCfg->getGTGradientSearch() > 0 )
+	{
+		TComMv acGT[4];
+		gtFlag = xGTGradientSearch( piRefSrch, piRefSrchStride, piAux, iCols, iRows, iNSSWindow, lastIterationStep, bAffine, Hor, Ver, acGT, uiDistBest );
+		if ( gtFlag )
+		{
+			*rcGT0 = acGT[0];
+			*rcGT1 = acGT[1];
+			*rcGT2 = acGT[2];
+			*rcGT3 = acGT[3];
+			ruiCost = uiDistBest;
+		}
+		m_cGTScratch.release( uiScratchMark );
+		return;
+	}
+#endif
+
 #if IT_GT_SEARCH == 0
 	// SEARCH NSS
 	iNSSIteration[0] = 1;
@@ -4901,21 +5515,17 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 														{
 															// calculate gt param
 															calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-															if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-																ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+															if( !bAffine || dProjective.bAffine ){ // AFFINE
 																setDistParamComp(0);
-															m_cDistParam.pCur = piAux;
 																m_cDistParam.bitDepth = g_bitDepthY;
-																uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-																uiDist += m_pcRdCost->getCost( Hor , Ver );
+																uiDist  = m_pcRdCost->getCost( Hor , Ver );
 																uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 																		(iCurrCornerX[0])/lastIterationStep				, (iCurrCornerY[0])/lastIterationStep			,
 																		(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])        /lastIterationStep   ,
 																		(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep,
 																		(iCurrCornerX[3])/lastIterationStep				, (iCurrCornerY[3] - iRows +1)/lastIterationStep)
 																);
+																uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 																// GT COST
 																// check if best
 																if (uiDist < uiDistBest)
@@ -4938,9 +5548,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 																	iBestNSSCenterY[2] = iCurrCornerY[2];
 																	iBestNSSCenterY[3] = iCurrCornerY[3];
 																}
-#if IT_GT_AFFINE
 															}
-#endif
 														}
 													}
 												}
@@ -4964,7 +5572,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 
 	calcParamProjective(iBestCornerX, iBestCornerY, dProjective, iCols, iRows);
 	ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
-	xFree(piAux);
+	m_cGTScratch.release( uiScratchMark );
 
 
 	if (iBestCornerX[0] != 0 || iBestCornerY[0] != 0 ||
@@ -5024,21 +5632,17 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 										{
 											// calculate gt param
 											calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-											if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-												ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+											if( !bAffine || dProjective.bAffine ){ // AFFINE
 												setDistParamComp(0);
-												m_cDistParam.pCur = piAux;
 												m_cDistParam.bitDepth = g_bitDepthY;
-												uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-												uiDist += m_pcRdCost->getCost( Hor , Ver );
+												uiDist  = m_pcRdCost->getCost( Hor , Ver );
 												uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 														(iCurrCornerX[0])			  , (iCurrCornerY[0])			,
 														(iCurrCornerX[1] - iCols +1)  , (iCurrCornerY[1])           ,
 														(iCurrCornerX[2] - iCols +1)  , (iCurrCornerY[2] - iRows +1),
 														(iCurrCornerX[3])			  , (iCurrCornerY[3] - iRows +1) )
 												);
+												uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 												// GT COST
 												// check if best
 												if (uiDist < uiDistBest)
@@ -5053,9 +5657,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 													iBestCornerY[2] = iCurrCornerY[2];
 													iBestCornerY[3] = iCurrCornerY[3];
 												}
-#if IT_GT_AFFINE
 											}
-#endif
 										}
 									}
 								}
@@ -5068,7 +5670,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	}
 	calcParamProjective(iBestCornerX, iBestCornerY, dProjective, iCols, iRows);
 	ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
-	xFree(piAux);
+	m_cGTScratch.release( uiScratchMark );
 
 
 	if (iBestCornerX[0] != 0 || iBestCornerY[0] != 0 ||
@@ -5096,6 +5698,13 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	Int iBestSSX = 0;
 	Int iBestSSY = 0;
 	TComMv nullVect = TComMv (0,0);
+#if IT_GT_PARALLEL_SEEDS
+	// GTSearchThreads > 0: the seeds are refined independently of each other, in batches of GTSearchThreads seeds
+	const Int iSeedThreads = m_pcEncCfg->getGTSearchThreads();
+	Int   iNumSeeds = 0;
+	Short aiSeedHor[IT_GT_MAX_SEARCH_THREADS], aiSeedVer[IT_GT_MAX_SEARCH_THREADS];
+	Pel*  apiSeedRef[IT_GT_MAX_SEARCH_THREADS];
+#endif
 #if IT_SS_USE_PREDICTORS
 	AMVPInfo* pcAMVPInfo = pcCU->getCUMvField(REF_PIC_LIST_0)->getAMVPInfo();
 	Int numPred = pcAMVPInfo->iN;
@@ -5103,21 +5712,23 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	for(Int i=0; i<numPred; i++)
 		extraVects[i] = pcAMVPInfo->m_acMvCand[i]; // 1/4 pel
 #endif
-	for(Int b = 0; b < IT_SS_NUMBER_OF_BEST_CAND
+	bestSSCand->sort(); // cheapest seed first
+	Int numSSCand = bestSSCand->getNumCand();
+	for(Int b = 0; b < numSSCand
 #if IT_SS_USE_PREDICTORS
 	+ numPred
 #endif
 	; b++)
 	{
 #if IT_SS_USE_PREDICTORS
-		if(b<IT_SS_NUMBER_OF_BEST_CAND)
+		if(b<numSSCand)
 		{
 #endif
-			if(bestSSCand[b] == nullVect)
+			if(bestSSCand->getMv(b) == nullVect)
 				continue;
-			Ver = bestSSCand[b].getVer();
-			Hor = bestSSCand[b].getHor(); // 1 pel
-			iOffset = bestSSCand[b].getHor() - iCols/2 + (bestSSCand[b].getVer() - iRows/2) * iRefStride;
+			Ver = bestSSCand->getMv(b).getVer();
+			Hor = bestSSCand->getMv(b).getHor(); // 1 pel
+			iOffset = bestSSCand->getMv(b).getHor() - iCols/2 + (bestSSCand->getMv(b).getVer() - iRows/2) * iRefStride;
 
 			Ver <<= 2;
 			Hor <<= 2; // 1/4 pel
@@ -5141,10 +5752,10 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 		}
 		else
 		{
-			if(extraVects[b-IT_SS_NUMBER_OF_BEST_CAND] == nullVect)
+			if(extraVects[b-numSSCand] == nullVect)
 				continue;
-			Ver = extraVects[b-IT_SS_NUMBER_OF_BEST_CAND].getVer();
-			Hor = extraVects[b-IT_SS_NUMBER_OF_BEST_CAND].getHor(); // 1/4 pel
+			Ver = extraVects[b-numSSCand].getVer();
+			Hor = extraVects[b-numSSCand].getHor(); // 1/4 pel
 			Ver >>=2;
 			Hor >>=2; // 1 pel
 			iOffset = Hor - iCols/2 + (Ver - iRows/2) * iRefStride;
@@ -5152,18 +5763,28 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			Ver <<=2; // 1/4 pel
 			Hor <<=2;
 #else
-			Ver = extraVects[b-IT_SS_NUMBER_OF_BEST_CAND].getVer();
-			Hor = extraVects[b-IT_SS_NUMBER_OF_BEST_CAND].getHor(); // 1/4 pel
+			Ver = extraVects[b-numSSCand].getVer();
+			Hor = extraVects[b-numSSCand].getHor(); // 1/4 pel
 #endif
 		}
 #endif
-		//cout << b << "/" << IT_SS_NUMBER_OF_BEST_CAND + numPred << " " << Ver << " " << Hor << endl;
+		//cout << b << "/" << numSSCand + numPred << " " << Ver << " " << Hor << endl;
+#if !IT_SS_QUARTER_PEL
+		// integer seed: the window is only copied, no sub-pel plane is read
+		piRefSrchStride = m_filteredBlock[0][0].getStride();
+		piRefSrch       = m_filteredBlock[0][0].getLumaAddr();
+#if IT_GT_PARALLEL_SEEDS
+		if ( iSeedThreads > 0 )
+		{
+			piRefSrch = m_piGTSeedRef + iNumSeeds * m_iGTSeedRefSize;
+		}
+#endif
+		xGTCopySeedWindow( piRefY + iOffset, iRefStride, piRefSrch, piRefSrchStride, iCols * 2, iRows * 2 );
+		piRefSrch += (iCols/2) + (iRows/2) * piRefSrchStride; // inside block (jump the margin pixels)
+#else
 		cPatternRoi.initPattern( piRefY +  iOffset, NULL, NULL, iCols * 2, iRows * 2, iRefStride, 0, 0 );
 		xExtDIFUpSamplingH ( &cPatternRoi, biPred );
 		xExtDIFUpSamplingQ ( &cPatternRoi, nullVect, biPred );
-#if !IT_SS_QUARTER_PEL
-		piRefSrch = m_filteredBlock[ 0 ][ 0 ].getLumaAddr(); // no interpolation
-#else
 		piRefSrch = m_filteredBlock[ Ver & 3 ][ Hor & 3 ].getLumaAddr();
 		if ( Hor == 2 && ( Ver & 1 ) == 0 )
 		{
@@ -5173,244 +5794,48 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 		{
 			piRefSrch += m_filteredBlock[0][0].getStride();
 		}
-#endif
 		piRefSrch += (iCols/2) + (iRows/2) * piRefSrchStride; // inside block (jump the margin pixels)
 #endif
+#endif
 
-		iNSSIteration[0] = 1;
-		for (Int j0 = iNSSWindow; (j0 > 1) && (iNSSIteration[0] <= iMaxNSSIteration); j0 /= 2){
-			iNSSIteration[0]++;
-			if (j0 == iNSSWindow){
-				iCurrNSSCenterX[0] = iBestNSSCenterX[0] = 0;
-				iCurrNSSCenterY[0] = iBestNSSCenterY[0] = 0;
-#if IT_Independent_Iterations
-#if IT_GT_GRID_SIZE == 1
-				iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols - 1;
-				iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
-				iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols - 1;
-				iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows - 1;
-				iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
-				iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows - 1;
+#if IT_GT_PARALLEL_SEEDS && IT_SS_NUMBER_OF_BEST_CAND
+		if ( iSeedThreads > 0 )
+		{
+			// the seed is refined with its batch, from a copy of its search window
+#if IT_SS_QUARTER_PEL
+			Pel* piSeedPlane = m_filteredBlock[ Ver & 3 ][ Hor & 3 ].getLumaAddr();
+			::memcpy( m_piGTSeedRef + iNumSeeds * m_iGTSeedRefSize, piSeedPlane, m_iGTSeedRefSize * sizeof(Pel) );
+			apiSeedRef[iNumSeeds] = m_piGTSeedRef + iNumSeeds * m_iGTSeedRefSize + ( piRefSrch - piSeedPlane );
 #else
-				iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols*IT_GT_GRID_SIZE - 1;
-				iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
-				iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols*IT_GT_GRID_SIZE - 1;
-				iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows*IT_GT_GRID_SIZE - 1;
-				iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
-				iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows*IT_GT_GRID_SIZE - 1;
-#endif
+			apiSeedRef[iNumSeeds] = piRefSrch; // already copied to the window of the seed
 #endif
+			aiSeedHor[iNumSeeds]       = Hor;
+			aiSeedVer[iNumSeeds]       = Ver;
+			if ( ++iNumSeeds == iSeedThreads )
+			{
+				xGTRefineSeeds<bAffine>( iNumSeeds, aiSeedHor, aiSeedVer, apiSeedRef, piRefSrchStride, iCols, iRows, iNSSWindow, iMaxNSSIteration, lastIterationStep,
+				                         ruiCost, uiDistBest, iBestCornerX, iBestCornerY, iBestSSX, iBestSSY );
+				iNumSeeds = 0;
 			}
-			else{
-				iCurrNSSCenterX[0] = iBestNSSCenterX[0];
-				iCurrNSSCenterY[0] = iBestNSSCenterY[0];
-#if IT_Independent_Iterations
-				iCurrNSSCenterX[1] = iBestNSSCenterX[1];
-				iCurrNSSCenterY[1] = iBestNSSCenterY[1];
-				iCurrNSSCenterX[2] = iBestNSSCenterX[2];
-				iCurrNSSCenterY[2] = iBestNSSCenterY[2];
-				iCurrNSSCenterX[3] = iBestNSSCenterX[3];
-				iCurrNSSCenterY[3] = iBestNSSCenterY[3];
-#endif
-			}//------------------------------------------ corner 0 ---------------------------------------------------//
-			i0 = j0;
-			for (Int y0 = i0 / 2; y0 >= -i0 / 2; y0 -= i0 / 2) {
-				iCurrCornerY[0] = iCurrNSSCenterY[0] + y0;
-				for (Int x0 = i0 / 2; x0 >= -i0 / 2; x0 -= i0 / 2) {
-					if((y0 != 0 && x0 == 0 ) || (y0 == 0 && x0 != 0 ) || (y0 == 0 && x0 == 0 )){
-						iCurrCornerX[0] = iCurrNSSCenterX[0] + x0;
-#if !IT_Independent_Iterations
-						iNSSIteration[1] = 1;
-						for (Int j1 = iNSSWindow; (j1 > 1) && (iNSSIteration[1] <= iMaxNSSIteration); j1 /= 2){
-							iNSSIteration[1]++;
-							if (j1 == iNSSWindow){
-								iCurrNSSCenterX[1] = iBestNSSCenterX[1] = iCols - 1;
-								iCurrNSSCenterY[1] = iBestNSSCenterY[1] = 0;
-							}
-							else{
-								iCurrNSSCenterX[1] = iBestNSSCenterX[1];
-								iCurrNSSCenterY[1] = iBestNSSCenterY[1];
-							}
-							i1 = j1;
-#else
-							i1 = j0;
-#endif
-							//-------------------------------------- corner 1 ------------------------------------------------------//
-							for (Int y1 = i1 / 2; y1 >= -i1 / 2; y1 -= i1 / 2) {
-								iCurrCornerY[1] = iCurrNSSCenterY[1] + y1;
-								for (Int x1 = i1 / 2; x1 >= -i1 / 2; x1 -= i1 / 2) {
-									if((y1 != 0 && x1 == 0 ) || (y1 == 0 && x1 != 0 ) || (y1 == 0 && x1 == 0 )){
-										iCurrCornerX[1] = iCurrNSSCenterX[1] + x1;
-#if !IT_Independent_Iterations
-										iNSSIteration[2] = 1;
-										for (Int j2 = iNSSWindow; (j2 > 1) && (iNSSIteration[2] <= iMaxNSSIteration); j2 /= 2){
-											iNSSIteration[2]++;
-											if (j2 == iNSSWindow){
-												iCurrNSSCenterX[2] = iBestNSSCenterX[2] = iCols - 1;
-												iCurrNSSCenterY[2] = iBestNSSCenterY[2] = iRows - 1;
-											}
-											else{
-												iCurrNSSCenterX[2] = iBestNSSCenterX[2];
-												iCurrNSSCenterY[2] = iBestNSSCenterY[2];
-											}
-											i2 = j2;
-#else
-											i2 = j0;
-#endif
-											//-------------------------------------- corner 2 ------------------------------------------------------//
-											for (Int y2 = i2 / 2; y2 >= -i2 / 2; y2 -= i2 / 2) {
-												iCurrCornerY[2] = iCurrNSSCenterY[2] + y2;
-												for (Int x2 = i2 / 2; x2 >= -i2 / 2; x2 -= i2 / 2) {
-													if((y2 != 0 && x2 == 0 ) || (y2 == 0 && x2 != 0 ) || (y2 == 0 && x2 == 0 )){
-														iCurrCornerX[2] = iCurrNSSCenterX[2] + x2;
-#if !IT_Independent_Iterations
-														iNSSIteration[3] = 1;
-														for (Int j3 = iNSSWindow; (j3 > 1) && (iNSSIteration[3] <= iMaxNSSIteration); j3 /= 2){
-															iNSSIteration[3]++;
-															if (j3 == iNSSWindow){
-																iCurrNSSCenterX[3] = iBestNSSCenterX[3] = 0;
-																iCurrNSSCenterY[3] = iBestNSSCenterY[3] = iRows - 1;
-															}
-															else{
-																iCurrNSSCenterX[3] = iBestNSSCenterX[3];
-																iCurrNSSCenterY[3] = iBestNSSCenterY[3];
-															}
-															i3 = j3;
-#else
-															i3 = j0;
-#endif
-															//-------------------------------------- corner 3 ------------------------------------------------------//
-															for (Int y3 = i3 / 2; y3 >= -i3 / 2; y3 -= i3 / 2) {
-																iCurrCornerY[3] = iCurrNSSCenterY[3] + y3;
-																for (Int x3 = i3 / 2; x3 >= -i3 / 2; x3 -= i3 / 2) {
-																	if((y3 != 0 && x3 == 0 ) || (y3 == 0 && x3 != 0 ) || (y3 == 0 && x3 == 0 )){
-																		iCurrCornerX[3] = iCurrNSSCenterX[3] + x3;
-																		// if not translation
-																		if ( !(x0 == x1  && x0 == x2 && x0 == x3 && y0 == y1 && y0 == y2 && y0 == y3) )
-																		{
-#if IT_GT_GRID_SIZE < 2
-																			// valid GT location
-																			if(((x0 + (Hor >> 2)        < -marginX  && y0 + (Ver >> 2)        <= -marginY)  || (x0 + (Hor >> 2)         >= -marginX  && y0 + (Ver >> 2)         < -marginY))  &&
-																				((x1 + (Hor >> 2) +iCols < -marginX  && y1 + (Ver >> 2)        <= -marginY)  || (x1 + (Hor >> 2) +iCols  >= -marginX  && y1 + (Ver >> 2)         < -marginY))  &&
-																				((x2 + (Hor >> 2) +iCols < -marginX  && y2 + (Ver >> 2) +iRows <= -marginY)  || (x2 + (Hor >> 2) +iCols  >= -marginX  && y2 + (Ver >> 2) +iRows  < -marginY))  &&
-																				((x3 + (Hor >> 2)        < -marginX  && y3 + (Ver >> 2) +iRows <= -marginY)  || (x3 + (Hor >> 2)         >= -marginX  && y3 + (Ver >> 2) +iRows  < -marginY))    )
-																			{
-#else
-																				// valid GT location
-																				/*if((((x0 / IT_GT_GRID_SIZE) + (Hor >> 2)        < -marginX  && (y0 / IT_GT_GRID_SIZE) + (Ver >> 2)        <= -marginY)  || ((x0 / IT_GT_GRID_SIZE) + (Hor >> 2)         >= -marginX  && (y0 / IT_GT_GRID_SIZE) + (Ver >> 2)         < -marginY))  &&
-																				(((x1 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols 	< -marginX  && (y1 / IT_GT_GRID_SIZE) + (Ver >> 2)        <= -marginY)  || ((x1 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols  >= -marginX  && (y1 / IT_GT_GRID_SIZE) + (Ver >> 2)         < -marginY))  &&
-																				(((x2 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols 	< -marginX  && (y2 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows <= -marginY)  || ((x2 / IT_GT_GRID_SIZE) + (Hor >> 2) +iCols  >= -marginX  && (y2 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows  < -marginY))  &&
-																				(((x3 / IT_GT_GRID_SIZE) + (Hor >> 2)        	< -marginX  && (y3 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows <= -marginY)  || ((x3 / IT_GT_GRID_SIZE) + (Hor >> 2)         >= -marginX  && (y3 / IT_GT_GRID_SIZE) + (Ver >> 2) +iRows  < -marginY))    )*/
-																				if(1)
-																				{
-#endif
-// calculate gt param
-#if IT_GT_GRID_SIZE < 2
-#if !IT_GT_BILINEAR_TRANSFORMATION
-																					calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#else
-																					calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#endif
-#else
-#if !IT_GT_BILINEAR_TRANSFORMATION
-																				calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE);
-#else
-																				calcParamBilinear(iCurrCornerX, iCurrCornerY, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE);
-#endif
-#endif
-#if IT_GT_AFFINE
-#if !IT_GT_BILINEAR_TRANSFORMATION
-																				if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#else
-																					if(dProjective[3]==0.0 && dProjective[7]==0.0){ // AFFINE
-#endif
-#endif
-#if IT_GT_GRID_SIZE < 2
-#if !IT_GT_BILINEAR_TRANSFORMATION
-																					ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
-#else
-																					BilinearTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
-#endif
-#else
-#if !IT_GT_BILINEAR_TRANSFORMATION
-																					ProjectiveTransform(piRefSrch, piAux, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE, piRefSrchStride, iNSSWindow);
-#else
-																					BilinearTransform(piRefSrch, piAux, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE, piRefSrchStride, iNSSWindow);
-#endif
+			continue;
+		}
 #endif
-																					setDistParamComp(0);
-																					m_cDistParam.pCur = piAux;
-																					m_cDistParam.bitDepth = g_bitDepthY;
-																					uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-																					uiDist += m_pcRdCost->getCost( Hor , Ver );
-																					uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
-#if IT_GT_GRID_SIZE < 2
-																							(iCurrCornerX[0])/lastIterationStep				, (iCurrCornerY[0])/lastIterationStep			,
-																							(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])        /lastIterationStep   ,
-																							(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep,
-																							(iCurrCornerX[3])/lastIterationStep				, (iCurrCornerY[3] - iRows +1)/lastIterationStep)
-#else
-																							(iCurrCornerX[0])/lastIterationStep								, (iCurrCornerY[0])/lastIterationStep			,
-																							(iCurrCornerX[1] - iCols*IT_GT_GRID_SIZE +1)/lastIterationStep  , (iCurrCornerY[1])        /lastIterationStep   ,
-																							(iCurrCornerX[2] - iCols*IT_GT_GRID_SIZE +1)/lastIterationStep  , (iCurrCornerY[2] - iRows*IT_GT_GRID_SIZE +1)/lastIterationStep,
-																							(iCurrCornerX[3])/lastIterationStep								, (iCurrCornerY[3] - iRows*IT_GT_GRID_SIZE +1)/lastIterationStep)
-#endif
-																					);
-																					// GT COST
-																					// check if best
-																					if (uiDist < uiDistBest)
-																					{
-																						uiDistBest = uiDist;
-																						iBestCornerX[0] = iCurrCornerX[0];
-																						iBestCornerX[1] = iCurrCornerX[1];
-																						iBestCornerX[2] = iCurrCornerX[2];
-																						iBestCornerX[3] = iCurrCornerX[3];
-																						iBestCornerY[0] = iCurrCornerY[0];
-																						iBestCornerY[1] = iCurrCornerY[1];
-																						iBestCornerY[2] = iCurrCornerY[2];
-																						iBestCornerY[3] = iCurrCornerY[3];
-																						iBestNSSCenterX[0] = iCurrCornerX[0];
-																						iBestNSSCenterX[1] = iCurrCornerX[1];
-																						iBestNSSCenterX[2] = iCurrCornerX[2];
-																						iBestNSSCenterX[3] = iCurrCornerX[3];
-																						iBestNSSCenterY[0] = iCurrCornerY[0];
-																						iBestNSSCenterY[1] = iCurrCornerY[1];
-																						iBestNSSCenterY[2] = iCurrCornerY[2];
-																						iBestNSSCenterY[3] = iCurrCornerY[3];
+		if ( xGTDiamondSearch<bAffine>( piRefSrch, piRefSrchStride, piAux, m_cDistParam, iCols, iRows, iNSSWindow, iMaxNSSIteration, lastIterationStep, Hor, Ver, uiDistBest, iBestCornerX, iBestCornerY ) )
+		{
 #if IT_SS_NUMBER_OF_BEST_CAND
-																						iBestSSX = Hor;
-																						iBestSSY = Ver;
-#endif
-																					}
-#if IT_GT_AFFINE
-																				}
-#endif
-																			}
-																		}
-																	}
-																}
-															} // CORNER 3
-#if !IT_Independent_Iterations
-														}
-#endif
-													}
-												}
-											} // CORNER 2
-#if !IT_Independent_Iterations
-										}
-#endif
-									}
-								}
-							} // CORNER 1
-#if !IT_Independent_Iterations
-						}
+			iBestSSX = Hor;
+			iBestSSY = Ver;
 #endif
-					}
-				}
-			} // CORNER 0
 		}
 #if IT_SS_NUMBER_OF_BEST_CAND
 	}
+#if IT_GT_PARALLEL_SEEDS
+	if ( iNumSeeds > 0 )
+	{
+		xGTRefineSeeds<bAffine>( iNumSeeds, aiSeedHor, aiSeedVer, apiSeedRef, piRefSrchStride, iCols, iRows, iNSSWindow, iMaxNSSIteration, lastIterationStep,
+		                         ruiCost, uiDistBest, iBestCornerX, iBestCornerY, iBestSSX, iBestSSY );
+	}
+#endif
 #endif
 
 #if IT_GT_GRID_SIZE < 2
@@ -5430,7 +5855,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	BilinearTransform(piRefSrch, piAux, dProjective, iCols * IT_GT_GRID_SIZE, iRows * IT_GT_GRID_SIZE, piRefSrchStride, iNSSWindow);
 #endif
 #endif
-	xFree(piAux);
+	m_cGTScratch.release( uiScratchMark );
 
 
 	if (iBestCornerX[0] != 0 || iBestCornerY[0] != 0 ||
@@ -5475,6 +5900,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	TComMv test;
 	Int unusedCand = 0;
 	Int i = 0;
+	bestSSCand->clear();
 	for(Int y = -W; y < 0; y+=4)
 	{
 		for(Int x = -W; x < W; x+=4)
@@ -5482,7 +5908,7 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			test.set(x,y);
 			if(m_pcRdCost->isValidPattern( piRefY, iRefStride, test, iCols, iRows))
 			{
-				bestSSCand[i].set(x,y);
+				bestSSCand->insert(x,y,i); // raster order
 				i++;
 #if IT_DEBUG
 				cout << x << " " << y << " | " ;
@@ -5498,21 +5924,18 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 #endif
 #if IT_DEBUG
 	cout << endl;
-	cout << IT_SS_NUMBER_OF_BEST_CAND - unusedCand << endl;
+	cout << bestSSCand->getNumCand() << endl;
 #endif
 	TComMv nullVect = TComMv(0,0);
-	for(Int b = 0; b < IT_SS_NUMBER_OF_BEST_CAND
-#if IT_SS_OVERWRITE_BEST_CAND
-	- unusedCand
-#endif
-	; b++)
+	bestSSCand->sort();
+	for(Int b = 0; b < bestSSCand->getNumCand(); b++)
 	{
-		Ver = bestSSCand[b].getVer();
-		Hor = bestSSCand[b].getHor();
+		Ver = bestSSCand->getMv(b).getVer();
+		Hor = bestSSCand->getMv(b).getHor();
 		Ver <<= 2;
 		Hor <<= 2;
 
-		iOffset = bestSSCand[b].getHor() - iCols/2 + (bestSSCand[b].getVer() - iRows/2) * iRefStride;
+		iOffset = bestSSCand->getMv(b).getHor() - iCols/2 + (bestSSCand->getMv(b).getVer() - iRows/2) * iRefStride;
 		cPatternRoi.initPattern( piRefY +  iOffset, NULL, NULL, iCols * 2, iRows * 2, iRefStride, 0, 0 );
 		xExtDIFUpSamplingH ( &cPatternRoi, biPred );
 		xExtDIFUpSamplingQ ( &cPatternRoi, nullVect, biPred );
@@ -5523,21 +5946,17 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 	iCurrCornerY[0] = iCurrNSSCenterY[0] + N; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5556,28 +5975,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 1
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0] + N; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5596,28 +6009,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 2
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1] + N; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5636,28 +6043,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 3
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1] + N; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5676,28 +6077,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 4
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2] + N; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5716,28 +6111,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 5
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2] + N; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5756,28 +6145,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 6
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3] + N; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5796,28 +6179,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 7
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3] + N;
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5836,28 +6213,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 8
 	iCurrCornerY[0] = iCurrNSSCenterY[0] - N; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5876,28 +6247,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 9
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0] - N; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5916,28 +6281,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 10
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1] - N; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5956,28 +6315,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 11
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1] - N; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -5996,28 +6349,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 12
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2] - N; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -6036,28 +6383,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 13
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2] - N; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -6076,28 +6417,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 14
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3] - N; iCurrCornerX[3] = iCurrNSSCenterX[3];
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -6116,28 +6451,22 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 	// 15
 	iCurrCornerY[0] = iCurrNSSCenterY[0]; iCurrCornerX[0] = iCurrNSSCenterX[0]; iCurrCornerY[1] = iCurrNSSCenterY[1]; iCurrCornerX[1] = iCurrNSSCenterX[1]; iCurrCornerY[2] = iCurrNSSCenterY[2]; iCurrCornerX[2] = iCurrNSSCenterX[2]; iCurrCornerY[3] = iCurrNSSCenterY[3]; iCurrCornerX[3] = iCurrNSSCenterX[3] - N;
 	// calculate gt param
 	calcParamProjective(iCurrCornerX, iCurrCornerY, dProjective, iCols, iRows);
-#if IT_GT_AFFINE
-	if(dProjective[2]==0.0 && dProjective[5]==0.0){ // AFFINE
-#endif
-		ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
+	if( !bAffine || dProjective.bAffine ){ // AFFINE
 		setDistParamComp(0);
-		m_cDistParam.pCur = piAux;
 		m_cDistParam.bitDepth = g_bitDepthY;
-		uiDist = m_cDistParam.DistFunc(&m_cDistParam);
-		uiDist += m_pcRdCost->getCost( Hor , Ver );
+		uiDist  = m_pcRdCost->getCost( Hor , Ver );
 		uiDist += m_pcRdCost->getCost(m_pcRdCost->getBitsGT(
 				(iCurrCornerX[0])/lastIterationStep			    , (iCurrCornerY[0])/lastIterationStep			  ,
 				(iCurrCornerX[1] - iCols +1)/lastIterationStep  , (iCurrCornerY[1])/lastIterationStep             ,
 				(iCurrCornerX[2] - iCols +1)/lastIterationStep  , (iCurrCornerY[2] - iRows +1)/lastIterationStep  ,
 				(iCurrCornerX[3])/lastIterationStep			    , (iCurrCornerY[3] - iRows +1)/lastIterationStep  )
 		);
+		uiDist = xGTWarpCost(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiDistBest);
 		// GT COST
 		// check if best
 		if (uiDist < uiDistBest)
@@ -6156,15 +6485,13 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 			iBestSSY = Ver;
 #endif
 		}
-#if IT_GT_AFFINE
 	}
-#endif
 #if IT_SS_NUMBER_OF_BEST_CAND
 	}
 #endif
 	//calcParamProjective(iBestCornerX, iBestCornerY, dProjective, iCols, iRows);
 	//ProjectiveTransform(piRefSrch, piAux, dProjective, iCols, iRows, piRefSrchStride, iNSSWindow);
-	xFree(piAux);
+	m_cGTScratch.release( uiScratchMark );
 
 
 	if (iBestCornerX[0] != 0 || iBestCornerY[0] != 0 ||
@@ -6197,61 +6524,470 @@ Void TEncSearch::xPatternSearchGT(TComDataCU* pcCU,
 #endif
 #endif
 }
-#endif
-
 
-
-Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& cMvPred, Int iSrchRng, TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
+#if IT_GT_FIXED_POINT_WARP
+/** Solve the damped normal equations adA * pdX = pdB of the gradient GT estimation
+ * \returns false if the system is singular
+ */
+static Bool xSolveGTNormalEquations( Double adA[8][8], Double* pdB, Double* pdX, Int iN )
 {
-  Int  iMvShift = 2;
-  TComMv cTmpMvPred = cMvPred;
-  pcCU->clipMv( cTmpMvPred );
-
-  rcMvSrchRngLT.setHor( cTmpMvPred.getHor() - (iSrchRng << iMvShift) );
-  rcMvSrchRngLT.setVer( cTmpMvPred.getVer() - (iSrchRng << iMvShift) );
-  
-  rcMvSrchRngRB.setHor( cTmpMvPred.getHor() + (iSrchRng << iMvShift) );
-  rcMvSrchRngRB.setVer( cTmpMvPred.getVer() + (iSrchRng << iMvShift) );
-  pcCU->clipMv        ( rcMvSrchRngLT );
-  pcCU->clipMv        ( rcMvSrchRngRB );
-  
-  rcMvSrchRngLT >>= iMvShift;
-  rcMvSrchRngRB >>= iMvShift;
+  Double dTrace = 0;
+  for ( Int i = 0; i < iN; i++ )
+  {
+    dTrace += adA[i][i];
+  }
+  // Levenberg damping keeps flat blocks, whose gradients vanish, from diverging
+  for ( Int i = 0; i < iN; i++ )
+  {
+    adA[i][i] += 1e-3 * dTrace / iN + 1e-6;
+  }
+  for ( Int i = 0; i < iN; i++ )
+  {
+    Int iPivot = i;
+    for ( Int r = i + 1; r < iN; r++ )
+    {
+      if ( fabs( adA[r][i] ) > fabs( adA[iPivot][i] ) )
+      {
+        iPivot = r;
+      }
+    }
+    if ( fabs( adA[iPivot][i] ) < 1e-12 )
+    {
+      return false;
+    }
+    if ( iPivot != i )
+    {
+      for ( Int c = 0; c < iN; c++ )
+      {
+        std::swap( adA[i][c], adA[iPivot][c] );
+      }
+      std::swap( pdB[i], pdB[iPivot] );
+    }
+    for ( Int r = i + 1; r < iN; r++ )
+    {
+      Double dFactor = adA[r][i] / adA[i][i];
+      for ( Int c = i; c < iN; c++ )
+      {
+        adA[r][c] -= dFactor * adA[i][c];
+      }
+      pdB[r] -= dFactor * pdB[i];
+    }
+  }
+  for ( Int i = iN - 1; i >= 0; i-- )
+  {
+    Double dSum = pdB[i];
+    for ( Int c = i + 1; c < iN; c++ )
+    {
+      dSum -= adA[i][c] * pdX[c];
+    }
+    pdX[i] = dSum / adA[i][i];
+  }
+  return true;
 }
 
-#if IT_HOLOSS
-// ************** For IT development (non-scalable codec) *****************
-Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& pcMvSrchRngLT, TComMv& pcMvSrchRngRB, Int& riOffsetX, Int& riOffsetY, Bool  isFirstRow, Bool isFirstCol)
+/** Estimate the GT corners of a block from the image gradients of its SS match (Gauss-Newton)
+ * \param piRefSrch      SS match of the block in the up-sampled reference
+ * \param iRefSrchStride stride of piRefSrch
+ * \param piAux          scratch buffer of the size of the block
+ * \param iCols          width of the block
+ * \param iRows          height of the block
+ * \param iNSSWindow     reference margin around the block on the transformed grid, bounds the corner displacements
+ * \param iStep          precision of the coded corners on the transformed grid
+ * \param bAffine        the fourth corner is derived from the other three
+ * \param iHor           horizontal SS vector in quarter samples
+ * \param iVer           vertical SS vector in quarter samples
+ * \param pcGT           coded corners of the estimated GT
+ * \param ruiDistBest    cost to beat, updated with the cost of the estimated GT
+ * \returns true if the estimated GT is cheaper than ruiDistBest
+ *
+ * The corner displacements are interpolated bilinearly over the transformed grid, which linearises the warp around the
+ * current corners. Each iteration warps the block once and solves the normal equations of the linearised residual. The
+ * result is rounded to the coded corner precision and refined by single steps of the coded coordinates.
+ */
+Bool TEncSearch::xGTGradientSearch( Pel* piRefSrch, Int iRefSrchStride, Pel* piAux, Int iCols, Int iRows, Int iNSSWindow, Int iStep, Bool bAffine, Int iHor, Int iVer, TComMv* pcGT, UInt& ruiDistBest )
 {
-  Int   iSrchRngHorLeft   = pcMvSrchRngLT.getHor();
-  Int   iSrchRngHorRight  = pcMvSrchRngRB.getHor();
-  Int   iSrchRngVerTop    = pcMvSrchRngLT.getVer();
-  Int   iSrchRngVerBottom = pcMvSrchRngRB.getVer();
+  const Int  iCornerShift = 4; // corner precision of the iterations
+  const Int  iGridW       = iCols * IT_GT_GRID_SIZE;
+  const Int  iGridH       = iRows * IT_GT_GRID_SIZE;
+  const Int  iOffsetX     = iGridW/2 - (iCols / 2);
+  const Int  iOffsetY     = iGridH/2 - (iRows / 2);
+  const Int  iNumParam    = bAffine ? 6 : 8;
+  const Int  aiCornerX[4] = { 0, iGridW - 1, iGridW - 1, 0 };
+  const Int  aiCornerY[4] = { 0, 0, iGridH - 1, iGridH - 1 };
+  const Pel* piOrg        = m_cDistParam.pOrg;
+  const Int  iStrideOrg   = m_cDistParam.iStrideOrg;
+  Double     adDispX[4]   = { 0, 0, 0, 0 };
+  Double     adDispY[4]   = { 0, 0, 0, 0 };
+  Int        aiX[4], aiY[4];
+  GTWarpParam cParam;
+
+  for ( Int iIter = 0; iIter < m_pcEncCfg->getGTGradientSearch(); iIter++ )
+  {
+    for ( Int k = 0; k < 4; k++ )
+    {
+      aiX[k] = ( aiCornerX[k] << iCornerShift ) + (Int)floor( adDispX[k] * ( 1 << iCornerShift ) + 0.5 );
+      aiY[k] = ( aiCornerY[k] << iCornerShift ) + (Int)floor( adDispY[k] * ( 1 << iCornerShift ) + 0.5 );
+    }
+#if !IT_GT_BILINEAR_TRANSFORMATION
+    calcParamProjective( aiX, aiY, cParam, iGridW, iGridH, iCornerShift );
+    ProjectiveTransform( piRefSrch, piAux, cParam, iGridW, iGridH, iRefSrchStride, iNSSWindow );
+#else
+    calcParamBilinear( aiX, aiY, cParam, iGridW, iGridH, iCornerShift );
+    BilinearTransform( piRefSrch, piAux, cParam, iGridW, iGridH, iRefSrchStride, iNSSWindow );
+#endif
+
+    Double adA[8][8];
+    Double adB[8];
+    Double adJ[8];
+    Double adDelta[8];
+    memset( adA, 0, sizeof(adA) );
+    memset( adB, 0, sizeof(adB) );
+    for ( Int y = 0; y < iRows; y++ )
+    {
+      const Pel* piCur  = piAux + y * iCols;
+      const Pel* piUp   = piAux + ( y > 0 ? y - 1 : y ) * iCols;
+      const Pel* piDown = piAux + ( y < iRows - 1 ? y + 1 : y ) * iCols;
+      const Double dScaleY = ( y > 0 && y < iRows - 1 ) ? 0.5 : 1.0;
+      const Double v = (Double)( iOffsetY + y ) / ( iGridH - 1 );
+      for ( Int x = 0; x < iCols; x++ )
+      {
+        const Int    iLeft  = x > 0 ? x - 1 : x;
+        const Int    iRight = x < iCols - 1 ? x + 1 : x;
+        const Double dGradX = ( piCur[iRight] - piCur[iLeft] ) * ( ( x > 0 && x < iCols - 1 ) ? 0.5 : 1.0 );
+        const Double dGradY = ( piDown[x] - piUp[x] ) * dScaleY;
+        const Double dErr   = piOrg[y * iStrideOrg + x] - piCur[x];
+        const Double u      = (Double)( iOffsetX + x ) / ( iGridW - 1 );
+        Double adWeight[4]  = { ( 1 - u ) * ( 1 - v ), u * ( 1 - v ), u * v, ( 1 - u ) * v };
+        if ( bAffine )
+        {
+          // corner 3 = corner 0 - corner 1 + corner 2
+          adWeight[0] += adWeight[3];
+          adWeight[1] -= adWeight[3];
+          adWeight[2] += adWeight[3];
+        }
+        for ( Int k = 0; k < iNumParam / 2; k++ )
+        {
+          adJ[2 * k]     = dGradX * adWeight[k];
+          adJ[2 * k + 1] = dGradY * adWeight[k];
+        }
+        for ( Int i = 0; i < iNumParam; i++ )
+        {
+          adB[i] += adJ[i] * dErr;
+          for ( Int j = i; j < iNumParam; j++ )
+          {
+            adA[i][j] += adJ[i] * adJ[j];
+          }
+        }
+      }
+    }
+    for ( Int i = 0; i < iNumParam; i++ )
+    {
+      for ( Int j = 0; j < i; j++ )
+      {
+        adA[i][j] = adA[j][i];
+      }
+    }
+    if ( !xSolveGTNormalEquations( adA, adB, adDelta, iNumParam ) )
+    {
+      break;
+    }
 
-  if (isFirstCol && isFirstRow)
+    Double dMaxDelta = 0;
+    for ( Int k = 0; k < iNumParam / 2; k++ )
+    {
+      adDispX[k] = Clip3( (Double)-iNSSWindow, (Double)iNSSWindow, adDispX[k] + adDelta[2 * k] );
+      adDispY[k] = Clip3( (Double)-iNSSWindow, (Double)iNSSWindow, adDispY[k] + adDelta[2 * k + 1] );
+      dMaxDelta  = max( dMaxDelta, max( fabs( adDelta[2 * k] ), fabs( adDelta[2 * k + 1] ) ) );
+    }
+    if ( bAffine )
+    {
+      adDispX[3] = adDispX[0] - adDispX[1] + adDispX[2];
+      adDispY[3] = adDispY[0] - adDispY[1] + adDispY[2];
+    }
+    if ( dMaxDelta < 1.0 / ( 1 << iCornerShift ) )
+    {
+      break;
+    }
+  }
+
+  // round to the coded corner precision
+  Int aiGTX[4], aiGTY[4];
+  for ( Int k = 0; k < 4; k++ )
   {
-    iSrchRngHorRight = iSrchRngHorLeft + 1;
-    iSrchRngVerTop = iSrchRngVerBottom + 1;
+    aiGTX[k] = (Int)floor( adDispX[k] / iStep + 0.5 );
+    aiGTY[k] = (Int)floor( adDispY[k] / iStep + 0.5 );
   }
-  else
+  if ( bAffine )
   {
-    iSrchRngVerBottom = (iSrchRngVerBottom > (-riOffsetY-4)) ? (-riOffsetY-4) : iSrchRngVerBottom;
-    riOffsetX = - riOffsetX - (Int)pcCU->getWidth(0)  - 4;
-    riOffsetY = - riOffsetY - (Int)pcCU->getHeight(0) - 4;
-    iSrchRngVerBottom = ( isFirstCol && (iSrchRngVerBottom > riOffsetY) ) ? riOffsetY : iSrchRngVerBottom;
-    iSrchRngHorRight  = ( isFirstRow && (iSrchRngHorRight > riOffsetX) )  ? riOffsetX : iSrchRngHorRight;
-    iSrchRngHorRight  = (!isFirstRow && (pcCU->getAddr() < pcCU->getPic()->getFrameWidthInCU()) && ( iSrchRngHorRight > ( riOffsetX + (pcCU->getWidth(0)<<1) ) ) ) ? ( riOffsetX + (pcCU->getWidth(0)<<1) ) : iSrchRngHorRight;
+    aiGTX[3] = aiGTX[0] - aiGTX[1] + aiGTX[2];
+    aiGTY[3] = aiGTY[0] - aiGTY[1] + aiGTY[2];
   }
+  UInt uiBest = xGTGradientCost( piRefSrch, iRefSrchStride, piAux, iCols, iRows, iNSSWindow, iStep, iHor, iVer, aiGTX, aiGTY, MAX_UINT );
 
-  pcMvSrchRngLT.setHor( iSrchRngHorLeft );
-  pcMvSrchRngLT.setVer( iSrchRngVerTop );
-  pcMvSrchRngRB.setHor( iSrchRngHorRight );
-  pcMvSrchRngRB.setVer( iSrchRngVerBottom );
-
-  // Clip again to avoid error. It needs a shift because the clip is done in 1/4 pel!!
-  Int  iMvShift = 2;
-  pcMvSrchRngLT <<= iMvShift;
-  pcMvSrchRngRB <<= iMvShift;
+  // the rounding and the linearisation are corrected by one step of each coded coordinate
+  Bool bImproved = true;
+  for ( Int iPass = 0; iPass < 2 && bImproved; iPass++ )
+  {
+    bImproved = false;
+    for ( Int i = 0; i < iNumParam; i++ )
+    {
+      Int* piGT = ( i & 1 ) ? aiGTY : aiGTX;
+      for ( Int iSign = -1; iSign <= 1; iSign += 2 )
+      {
+        piGT[i >> 1] += iSign;
+        if ( bAffine )
+        {
+          piGT[3] = piGT[0] - piGT[1] + piGT[2];
+        }
+        UInt uiCost = xGTGradientCost( piRefSrch, iRefSrchStride, piAux, iCols, iRows, iNSSWindow, iStep, iHor, iVer, aiGTX, aiGTY, uiBest );
+        if ( uiCost < uiBest )
+        {
+          uiBest    = uiCost;
+          bImproved = true;
+          break;
+        }
+        piGT[i >> 1] -= iSign;
+        if ( bAffine )
+        {
+          piGT[3] = piGT[0] - piGT[1] + piGT[2];
+        }
+      }
+    }
+  }
+
+  if ( uiBest >= ruiDistBest )
+  {
+    return false;
+  }
+  ruiDistBest = uiBest;
+  for ( Int k = 0; k < 4; k++ )
+  {
+    pcGT[k].set( aiGTX[k], aiGTY[k] );
+  }
+  return true;
+}
+
+/** Cost of the GT of coded corners piGTX/piGTY for the gradient GT estimation
+ * \param uiCostBound cost from which the GT is discarded, the distortion is not measured beyond it
+ * \returns MAX_UINT for a translation, which is left to the SS vector, and a cost of at least uiCostBound for a discarded GT
+ */
+UInt TEncSearch::xGTGradientCost( Pel* piRefSrch, Int iRefSrchStride, Pel* piAux, Int iCols, Int iRows, Int iNSSWindow, Int iStep, Int iHor, Int iVer, Int* piGTX, Int* piGTY, UInt uiCostBound )
+{
+  if ( piGTX[0] == piGTX[1] && piGTX[0] == piGTX[2] && piGTX[0] == piGTX[3] &&
+       piGTY[0] == piGTY[1] && piGTY[0] == piGTY[2] && piGTY[0] == piGTY[3] )
+  {
+    return MAX_UINT;
+  }
+  const Int iGridW       = iCols * IT_GT_GRID_SIZE;
+  const Int iGridH       = iRows * IT_GT_GRID_SIZE;
+  Int       aiX[4]       = { 0, iGridW - 1, iGridW - 1, 0 };
+  Int       aiY[4]       = { 0, 0, iGridH - 1, iGridH - 1 };
+  GTWarpParam cParam;
+
+  for ( Int k = 0; k < 4; k++ )
+  {
+    aiX[k] += piGTX[k] * iStep;
+    aiY[k] += piGTY[k] * iStep;
+  }
+#if !IT_GT_BILINEAR_TRANSFORMATION
+  calcParamProjective( aiX, aiY, cParam, iGridW, iGridH );
+#else
+  calcParamBilinear( aiX, aiY, cParam, iGridW, iGridH );
+#endif
+  UInt uiDist = m_pcRdCost->getCost( iHor, iVer );
+  uiDist += m_pcRdCost->getCost( m_pcRdCost->getBitsGT( piGTX[0], piGTY[0], piGTX[1], piGTY[1], piGTX[2], piGTY[2], piGTX[3], piGTY[3] ) );
+  if ( uiDist >= uiCostBound )
+  {
+    return uiDist;
+  }
+  setDistParamComp(0);
+  m_cDistParam.bitDepth = g_bitDepthY;
+  return xGTWarpCost( piRefSrch, piAux, cParam, iGridW, iGridH, iRefSrchStride, iNSSWindow, m_cDistParam, uiDist, uiCostBound );
+}
+#endif
+#endif
+
+
+
+Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& cMvPred, Int iSrchRng, TComMv& rcMvSrchRngLT, TComMv& rcMvSrchRngRB )
+{
+  Int  iMvShift = 2;
+  TComMv cTmpMvPred = cMvPred;
+  pcCU->clipMv( cTmpMvPred );
+
+  rcMvSrchRngLT.setHor( cTmpMvPred.getHor() - (iSrchRng << iMvShift) );
+  rcMvSrchRngLT.setVer( cTmpMvPred.getVer() - (iSrchRng << iMvShift) );
+  
+  rcMvSrchRngRB.setHor( cTmpMvPred.getHor() + (iSrchRng << iMvShift) );
+  rcMvSrchRngRB.setVer( cTmpMvPred.getVer() + (iSrchRng << iMvShift) );
+  pcCU->clipMv        ( rcMvSrchRngLT );
+  pcCU->clipMv        ( rcMvSrchRngRB );
+  
+  rcMvSrchRngLT >>= iMvShift;
+  rcMvSrchRngRB >>= iMvShift;
+}
+
+#if IT_HOLOSS
+/** Right-most horizontal vector component of the current SS block that points to a reconstructed area
+ * \param iMvY vertical vector component (integer pel)
+ * \returns MAX_INT when the whole row is available, -MAX_INT when nothing is
+ */
+Int TEncSearch::xGetSSValidRight( Int iMvY )
+{
+  Int iRight = m_pcSSRefYuv->getSSValidRight( m_iSSBlkPelY + iMvY, m_iSSBlkWidth, m_iSSBlkHeight );
+  if ( iRight == MAX_INT || iRight == -MAX_INT )
+  {
+    return iRight;
+  }
+  return iRight - m_iSSBlkPelX;
+}
+#endif
+
+#if IT_SS_SAD_CACHE
+/** Start the SAD cache of the SS searches for a new CTU
+ * \param pcCtu CTU about to be compressed
+ *
+ * Entries are invalidated lazily: a vector whose stamp differs from the current one is cleared on first use.
+ */
+Void TEncSearch::initSSSadCache( TComDataCU* pcCtu )
+{
+  Int iNumVec = ( 2 * m_iSSSadRange + 1 ) * ( 2 * m_iSSSadRange + 1 );
+  if ( m_pusSSSadCache == NULL )
+  {
+    m_iSSSadRange   = min( m_iSearchRange, SS_SAD_CACHE_MAX_RANGE );
+    m_iSSSadCtuBlks = g_uiMaxCUWidth >> 3;
+    iNumVec         = ( 2 * m_iSSSadRange + 1 ) * ( 2 * m_iSSSadRange + 1 );
+    m_pusSSSadCache = new UShort[ 2 * iNumVec * m_iSSSadCtuBlks * ( g_uiMaxCUHeight >> 3 ) ];
+    m_puiSSSadStamp = new UInt  [ iNumVec ];
+    ::memset( m_puiSSSadStamp, 0, iNumVec * sizeof(UInt) );
+    m_uiSSSadStamp  = 0;
+  }
+
+  m_uiSSSadStamp++;
+  if ( m_uiSSSadStamp == 0 )
+  {
+    ::memset( m_puiSSSadStamp, 0, iNumVec * sizeof(UInt) );
+    m_uiSSSadStamp = 1;
+  }
+  m_iSSSadCtuAddr = pcCtu->getAddr();
+  m_iSSSadCtuX    = pcCtu->getCUPelX();
+  m_iSSSadCtuY    = pcCtu->getCUPelY();
+}
+
+/** SAD of the current SS block (m_cDistParam) at an integer vector
+ * \param iMvX  integer vector
+ * \param iMvY
+ * \returns the same value as m_cDistParam.DistFunc
+ *
+ * The block is made of 8x8 blocks of the CTU grid. When the reference block lies in the CTUs already coded, whose
+ * reconstruction is final, their SADs are taken from the cache, or computed once and stored. Even and odd rows are
+ * kept in separate planes so that the row subsampling of the fast encoder gives the same result as the direct SAD.
+ * Each plane is stored per 8x8 block, then per vector, so that a search reads neighbouring vectors contiguously.
+ */
+UInt TEncSearch::xGetSSSad( Int iMvX, Int iMvY )
+{
+  Int iRefX = m_iSSBlkPelX + iMvX;
+  Int iRefY = m_iSSBlkPelY + iMvY;
+
+  Bool bInCtu = ( iRefX + m_iSSBlkWidth  > m_iSSSadCtuX ) && ( iRefX < m_iSSSadCtuX + (Int)g_uiMaxCUWidth  ) &&
+                ( iRefY + m_iSSBlkHeight > m_iSSSadCtuY ) && ( iRefY < m_iSSSadCtuY + (Int)g_uiMaxCUHeight );
+  Bool bInPic = ( iRefX >= 0 ) && ( iRefY >= 0 ) &&
+                ( iRefX + m_iSSBlkWidth <= m_pcSSRefYuv->getWidth() ) && ( iRefY + m_iSSBlkHeight <= m_pcSSRefYuv->getHeight() );
+
+  if ( bInCtu || !bInPic || abs( iMvX ) > m_iSSSadRange || abs( iMvY ) > m_iSSSadRange || m_cDistParam.bApplyWeight )
+  {
+    return m_cDistParam.DistFunc( &m_cDistParam );
+  }
+
+  Int     iNumVec  = ( 2 * m_iSSSadRange + 1 ) * ( 2 * m_iSSSadRange + 1 );
+  Int     iNumBlks = m_iSSSadCtuBlks * ( g_uiMaxCUHeight >> 3 );
+  Int     iVec     = ( iMvY + m_iSSSadRange ) * ( 2 * m_iSSSadRange + 1 ) + iMvX + m_iSSSadRange;
+  UShort* pusEven  = m_pusSSSadCache + iVec;
+  UShort* pusOdd   = pusEven + iNumBlks * iNumVec;
+  if ( m_puiSSSadStamp[iVec] != m_uiSSSadStamp )
+  {
+    m_puiSSSadStamp[iVec] = m_uiSSSadStamp;
+    for ( Int i = 0; i < iNumBlks; i++ )
+    {
+      pusEven[i * iNumVec] = SS_SAD_CACHE_EMPTY;
+      pusOdd [i * iNumVec] = SS_SAD_CACHE_EMPTY;
+    }
+  }
+
+  Int  iSubShift  = m_cDistParam.iSubShift;
+  Int  iStrideOrg = m_cDistParam.iStrideOrg;
+  Int  iStrideCur = m_cDistParam.iStrideCur;
+  Int  iBlkX0     = ( m_iSSBlkPelX - m_iSSSadCtuX ) >> 3;
+  Int  iBlkY0     = ( m_iSSBlkPelY - m_iSSSadCtuY ) >> 3;
+  UInt uiSum      = 0;
+
+  for ( Int by = 0; by < ( m_iSSBlkHeight >> 3 ); by++ )
+  {
+    for ( Int bx = 0; bx < ( m_iSSBlkWidth >> 3 ); bx++ )
+    {
+      Int iBlk = ( ( iBlkY0 + by ) * m_iSSSadCtuBlks + iBlkX0 + bx ) * iNumVec;
+      for ( Int iPar = 0; iPar <= ( iSubShift ? 0 : 1 ); iPar++ )
+      {
+        UShort* pusSad = ( iPar ? pusOdd : pusEven ) + iBlk;
+        if ( *pusSad == SS_SAD_CACHE_EMPTY )
+        {
+          const Pel* piOrg = m_cDistParam.pOrg + ( 8 * by + iPar ) * iStrideOrg + 8 * bx;
+          const Pel* piCur = m_cDistParam.pCur + ( 8 * by + iPar ) * iStrideCur + 8 * bx;
+          UInt uiBlkSad = 0;
+          for ( Int y = 0; y < 8; y += 2 )
+          {
+            for ( Int x = 0; x < 8; x++ )
+            {
+              uiBlkSad += abs( piOrg[x] - piCur[x] );
+            }
+            piOrg += 2 * iStrideOrg;
+            piCur += 2 * iStrideCur;
+          }
+          *pusSad = (UShort)uiBlkSad;
+        }
+        uiSum += *pusSad;
+      }
+    }
+  }
+
+  uiSum <<= iSubShift;
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT( m_cDistParam.bitDepth - 8 );
+}
+#endif
+
+#if IT_HOLOSS
+// ************** For IT development (non-scalable codec) *****************
+Void TEncSearch::xSetSearchRange ( TComDataCU* pcCU, TComMv& pcMvSrchRngLT, TComMv& pcMvSrchRngRB, Int& riOffsetX, Int& riOffsetY, Bool  isFirstRow, Bool isFirstCol)
+{
+  Int   iSrchRngHorLeft   = pcMvSrchRngLT.getHor();
+  Int   iSrchRngHorRight  = pcMvSrchRngRB.getHor();
+  Int   iSrchRngVerTop    = pcMvSrchRngLT.getVer();
+  Int   iSrchRngVerBottom = pcMvSrchRngRB.getVer();
+
+  if (isFirstCol && isFirstRow)
+  {
+    iSrchRngHorRight = iSrchRngHorLeft + 1;
+    iSrchRngVerTop = iSrchRngVerBottom + 1;
+  }
+  else
+  {
+    iSrchRngVerBottom = (iSrchRngVerBottom > (-riOffsetY-4)) ? (-riOffsetY-4) : iSrchRngVerBottom;
+    riOffsetX = - riOffsetX - (Int)pcCU->getWidth(0)  - 4;
+    riOffsetY = - riOffsetY - (Int)pcCU->getHeight(0) - 4;
+    iSrchRngVerBottom = ( isFirstCol && (iSrchRngVerBottom > riOffsetY) ) ? riOffsetY : iSrchRngVerBottom;
+    iSrchRngHorRight  = ( isFirstRow && (iSrchRngHorRight > riOffsetX) )  ? riOffsetX : iSrchRngHorRight;
+    iSrchRngHorRight  = (!isFirstRow && (pcCU->getAddr() < pcCU->getPic()->getFrameWidthInCU()) && ( iSrchRngHorRight > ( riOffsetX + (pcCU->getWidth(0)<<1) ) ) ) ? ( riOffsetX + (pcCU->getWidth(0)<<1) ) : iSrchRngHorRight;
+  }
+
+  pcMvSrchRngLT.setHor( iSrchRngHorLeft );
+  pcMvSrchRngLT.setVer( iSrchRngVerTop );
+  pcMvSrchRngRB.setHor( iSrchRngHorRight );
+  pcMvSrchRngRB.setVer( iSrchRngVerBottom );
+
+  // Clip again to avoid error. It needs a shift because the clip is done in 1/4 pel!!
+  Int  iMvShift = 2;
+  pcMvSrchRngLT <<= iMvShift;
+  pcMvSrchRngRB <<= iMvShift;
   pcCU->clipMv        ( pcMvSrchRngLT ); 
   pcCU->clipMv        ( pcMvSrchRngRB );
   pcMvSrchRngLT >>= iMvShift;
@@ -6270,7 +7006,7 @@ Void TEncSearch::xPatternSearch(  TComPattern* pcPatternKey,
                                 ,Int     riOffsetX
                                 ,Int     riOffsetY
 #if IT_SS_NUMBER_OF_BEST_CAND
-								,TComMv*		ssBestCand
+								,TComMvTopK*	ssBestCand
 #endif
 								, Bool    isSSE
 #endif
@@ -6281,21 +7017,16 @@ Void TEncSearch::xPatternSearch(  TComPattern* pcPatternKey,
   Int   iSrchRngVerTop    = pcMvSrchRngLT->getVer();
   Int   iSrchRngVerBottom = pcMvSrchRngRB->getVer();
   
-  UInt  uiSad;
   UInt  uiSadBest         = MAX_UINT;
   Int   iBestX = 0;
   Int   iBestY = 0;
   
-  Pel*  piRefSrch;
+  Int   aiBatchX[4];
+  Int   iNumBatch         = 0;
 
 #if IT_HOLOSS
   Bool isValid = false;
 #endif
-#if IT_SS_NUMBER_OF_BEST_CAND > 0
-  Int usedBestCand = 0;
-  Int bestCand = 0;
-#endif
-
   //-- jclee for using the SAD function pointer
   m_pcRdCost->setDistParam( pcPatternKey, piRefY, iRefStride,  m_cDistParam );
   
@@ -6307,48 +7038,97 @@ Void TEncSearch::xPatternSearch(  TComPattern* pcPatternKey,
       m_cDistParam.iSubShift = 1;
     }
   }
+
+#if IT_SS_SEA
+  // successive elimination: |sum(org) - sum(ref)| of the block, or of its quadrants for MSEA, is a lower bound of the SAD
+  Int  iSEAMode  = m_cDistParam.bApplyWeight ? 0 : m_pcEncCfg->getSEASearch();
+  Int  iBlkCols  = m_cDistParam.iCols;
+  Int  iBlkRows  = m_cDistParam.iRows;
+  Bool bMSEA     = ( iSEAMode == 2 ) && ( iBlkCols >= 8 ) && ( iBlkRows >= 8 );
+  Int  iSEAShift = m_cDistParam.iSubShift;
+  Int  iSEAAdj   = DISTORTION_PRECISION_ADJUSTMENT( g_bitDepthY - 8 );
+  if ( iSEAMode && ( iSrchRngVerTop <= iSrchRngVerBottom ) && ( iSrchRngHorLeft <= iSrchRngHorRight ) )
+  {
+    xSEAInit( pcPatternKey, piRefY + iSrchRngVerTop * iRefStride + iSrchRngHorLeft, iRefStride,
+              iSrchRngHorRight - iSrchRngHorLeft + iBlkCols, iSrchRngVerBottom - iSrchRngVerTop + iBlkRows, iSEAShift );
+  }
+#endif
   
   piRefY += (iSrchRngVerTop * iRefStride);
   for ( Int y = iSrchRngVerTop; y <= iSrchRngVerBottom; y++ )
   {
+#if IT_HOLOSS
+    Int iRowRight = iSrchRngHorRight;
+    if (isSSE)
+    {
+      // causal part of the row: reconstructed SS blocks, outside the current CU
+      iRowRight = min( iRowRight, xGetSSValidRight( y ) );
+      if ( y > riOffsetY )
+      {
+        iRowRight = min( iRowRight, riOffsetX - 1 );
+      }
+    }
+    for ( Int x = iSrchRngHorLeft; x <= iRowRight; x++ )
+#else
     for ( Int x = iSrchRngHorLeft; x <= iSrchRngHorRight; x++ )
+#endif
     {
-      //  find min. distortion position
-      piRefSrch = piRefY + x;
-      m_cDistParam.pCur = piRefSrch;
-
-      setDistParamComp(0);
-
-      m_cDistParam.bitDepth = g_bitDepthY;
-      uiSad = m_cDistParam.DistFunc( &m_cDistParam );
-      
 #if IT_HOLOSS
-      if (isSSE)
+      isValid = true;
+#endif
+#if IT_SS_SEA
+      if ( iSEAMode )
       {
-        if ( ( x >= riOffsetX ) && ( y > riOffsetY ) )
-          continue;
-        if( !m_pcRdCost->isValidPattern( &m_cDistParam,m_cDistParam.iCols) )
+        Int  iWinX  = x - iSrchRngHorLeft;
+        Int  iWinY  = y - iSrchRngVerTop;
+        UInt uiCost = m_pcRdCost->getCost( x, y );
+        UInt uiBound = abs( m_aiSEAOrgSum[0] - xSEAGetSum( iWinX, iWinY, iBlkCols, iBlkRows ) );
+#if IT_SS_NUMBER_OF_BEST_CAND > 0
+        // positions that cannot enter the candidate list are not needed either
+        UInt uiSadPrune = ssBestCand->getWorstCost();
+#else
+        UInt uiSadPrune = uiSadBest;
+#endif
+        if ( ( ( uiBound << iSEAShift ) >> iSEAAdj ) + uiCost >= uiSadPrune )
+        {
           continue;
+        }
+        if ( bMSEA )
+        {
+          Int iHalfCols = iBlkCols >> 1;
+          Int iHalfRows = iBlkRows >> 1;
+          uiBound  = abs( m_aiSEAOrgSum[1] - xSEAGetSum( iWinX,             iWinY,             iHalfCols, iHalfRows ) );
+          uiBound += abs( m_aiSEAOrgSum[2] - xSEAGetSum( iWinX + iHalfCols, iWinY,             iHalfCols, iHalfRows ) );
+          uiBound += abs( m_aiSEAOrgSum[3] - xSEAGetSum( iWinX,             iWinY + iHalfRows, iHalfCols, iHalfRows ) );
+          uiBound += abs( m_aiSEAOrgSum[4] - xSEAGetSum( iWinX + iHalfCols, iWinY + iHalfRows, iHalfCols, iHalfRows ) );
+          if ( ( ( uiBound << iSEAShift ) >> iSEAAdj ) + uiCost >= uiSadPrune )
+          {
+            continue;
+          }
+        }
       }
-      isValid = true;
-#endif      
-      // motion cost
-      uiSad += m_pcRdCost->getCost( x, y );
-      
-      if ( uiSad < uiSadBest )
+#endif
+      //  find min. distortion position, four positions at a time
+      aiBatchX[iNumBatch++] = x;
+      if ( iNumBatch == 4 )
       {
-        uiSadBest = uiSad;
-        iBestX    = x;
-        iBestY    = y;
-#if IT_SS_NUMBER_OF_BEST_CAND > 0
-        ssBestCand[bestCand].set(x, y);
-        usedBestCand++;
-        bestCand++;
-        if(bestCand == IT_SS_NUMBER_OF_BEST_CAND)
-        	bestCand = 0;
+#if IT_SS_NUMBER_OF_BEST_CAND
+        xPatternSearchBatch( piRefY, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY, ssBestCand );
+#else
+        xPatternSearchBatch( piRefY, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY );
 #endif
+        iNumBatch = 0;
       }
     } // for x
+    if ( iNumBatch > 0 )
+    {
+#if IT_SS_NUMBER_OF_BEST_CAND
+      xPatternSearchBatch( piRefY, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY, ssBestCand );
+#else
+      xPatternSearchBatch( piRefY, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY );
+#endif
+      iNumBatch = 0;
+    }
     piRefY += iRefStride;
   } // for y
 
@@ -6363,14 +7143,369 @@ Void TEncSearch::xPatternSearch(  TComPattern* pcPatternKey,
   rcMv.set( iBestX, iBestY );
   
   ruiSAD = uiSadBest - m_pcRdCost->getCost( iBestX, iBestY );
+
+  return;
+}
+
+/** SADs plus vector costs of up to four positions of a search row, the best vectors are updated in the order of the positions
+ * \param piRefRow   reference at the horizontal vector 0 of the row
+ * \param piMvX      horizontal vectors of the positions
+ * \param iMvY       vertical vector of the row
+ * \param iNumPos    number of positions, 1 to 4
+ * \param ruiSadBest best cost of the search
+ * \param riBestX    best vector of the search
+ * \param riBestY
+ * \param ssBestCand K best vectors of the search
+ *
+ * One DistFuncX4 call measures the positions with the original block loaded once. Blocks served by the SAD
+ * cache are measured one position at a time. Deferring the costs of a batch only loosens the SEA bound of the
+ * positions in the batch, the vectors found are the same.
+ */
+Void TEncSearch::xPatternSearchBatch( Pel* piRefRow, const Int* piMvX, Int iMvY, Int iNumPos, UInt& ruiSadBest, Int& riBestX, Int& riBestY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    , TComMvTopK* ssBestCand
+#endif
+                                    )
+{
+  UInt auiSad[4];
+
+  setDistParamComp(0);
+  m_cDistParam.bitDepth = g_bitDepthY;
+
+#if IT_SS_SAD_CACHE
+  if ( m_bSSSadCacheBlk || iNumPos == 1 )
+#else
+  if ( iNumPos == 1 )
+#endif
+  {
+    for ( Int k = 0; k < iNumPos; k++ )
+    {
+      m_cDistParam.pCur = piRefRow + piMvX[k];
+#if IT_SS_SAD_CACHE
+      auiSad[k] = m_bSSSadCacheBlk ? xGetSSSad( piMvX[k], iMvY ) : m_cDistParam.DistFunc( &m_cDistParam );
+#else
+      auiSad[k] = m_cDistParam.DistFunc( &m_cDistParam );
+#endif
+    }
+  }
+  else
+  {
+    // a partial batch repeats its last position
+    Pel* apiCur[4];
+    for ( Int k = 0; k < 4; k++ )
+    {
+      apiCur[k] = piRefRow + piMvX[ min( k, iNumPos - 1 ) ];
+    }
+    m_cDistParam.DistFuncX4( &m_cDistParam, apiCur, auiSad );
+  }
+
+  for ( Int k = 0; k < iNumPos; k++ )
+  {
+    // motion cost
+    UInt uiSad = auiSad[k] + m_pcRdCost->getCost( piMvX[k], iMvY );
+
+    if ( uiSad < ruiSadBest )
+    {
+      ruiSadBest = uiSad;
+      riBestX    = piMvX[k];
+      riBestY    = iMvY;
+    }
+#if IT_SS_NUMBER_OF_BEST_CAND > 0
+    ssBestCand->insert( piMvX[k], iMvY, uiSad );
+#endif
+  }
+}
+
+#if IT_SS_SEA
+/** Prepare the successive elimination of a full search
+ * \param pcPatternKey block to be predicted
+ * \param piRef        top-left sample of the search window
+ * \param iRefStride   stride of the reference
+ * \param iWinCols     width of the window, search range plus block width
+ * \param iWinRows     height of the window, search range plus block height
+ * \param iSubShift    row subsampling of the SAD
+ *
+ * The integral image only accumulates every (1<<iSubShift)-th row, as the SAD does. The sums are kept
+ * modulo 2^32, the difference of four entries is exact as long as the block sum fits in an Int.
+ */
+Void TEncSearch::xSEAInit( TComPattern* pcPatternKey, Pel* piRef, Int iRefStride, Int iWinCols, Int iWinRows, Int iSubShift )
+{
+  assert( iSubShift <= 1 );
+  m_iSEASubStep   = 1 << iSubShift;
+  m_iSEASumStride = iWinCols + 1;
+
+  // two leading zero rows so that the row above the window is addressable for both steps
+  Int iSize = ( iWinRows + 2 ) * m_iSEASumStride;
+  if ( iSize > m_iSEASumSize )
+  {
+    delete [] m_puiSEASum;
+    m_puiSEASum   = new UInt[iSize];
+    m_iSEASumSize = iSize;
+  }
+  ::memset( m_puiSEASum, 0, 2 * m_iSEASumStride * sizeof(UInt) );
+
+  for ( Int y = 0; y < iWinRows; y++ )
+  {
+    const UInt* piAbove = m_puiSEASum + ( y + 2 - m_iSEASubStep ) * m_iSEASumStride;
+    UInt*       piSum   = m_puiSEASum + ( y + 2 ) * m_iSEASumStride;
+    UInt        uiRow   = 0;
+    piSum[0] = 0;
+    for ( Int x = 0; x < iWinCols; x++ )
+    {
+      uiRow       += (UInt)piRef[x];
+      piSum[x + 1] = piAbove[x + 1] + uiRow;
+    }
+    piRef += iRefStride;
+  }
+
+  Pel* piOrg      = pcPatternKey->getROIY();
+  Int  iOrgStride = pcPatternKey->getPatternLStride();
+  Int  iCols      = pcPatternKey->getROIYWidth();
+  Int  iRows      = pcPatternKey->getROIYHeight();
+  ::memset( m_aiSEAOrgSum, 0, sizeof(m_aiSEAOrgSum) );
+  for ( Int y = 0; y < iRows; y += m_iSEASubStep )
+  {
+    for ( Int x = 0; x < iCols; x++ )
+    {
+      Int iQuadrant = 1 + ( x >= ( iCols >> 1 ) ) + 2 * ( y >= ( iRows >> 1 ) );
+      m_aiSEAOrgSum[0]         += piOrg[x];
+      m_aiSEAOrgSum[iQuadrant] += piOrg[x];
+    }
+    piOrg += iOrgStride * m_iSEASubStep;
+  }
+}
+#endif
+
+#if IT_SS_MI_LATTICE_SEARCH
+/** SS integer search restricted to the micro-image lattice
+ * \param pcCU          current CU, its slice gives the MI size
+ * \param pcPatternKey  block to be predicted
+ * \param piRefY        SS reference at the block position
+ * \param iRefStride    stride of the reference
+ * \param pcMvSrchRngLT causal search window, top-left (integer pel)
+ * \param pcMvSrchRngRB causal search window, bottom-right (integer pel)
+ * \param rcMv          best integer vector
+ * \param ruiSAD        distortion of the best vector, MAX_UINT when no causal position exists
+ * \param iOffsetX      causal limits returned by the SS xSetSearchRange
+ * \param iOffsetY
+ *
+ * Lenslet content repeats with the MI size, so only the vectors within MILatticeRange of a
+ * multiple of the MI size are tested instead of the whole window.
+ */
+Void TEncSearch::xPatternSearchMILattice( TComDataCU* pcCU,
+                                          TComPattern* pcPatternKey,
+                                          Pel* piRefY,
+                                          Int iRefStride,
+                                          TComMv* pcMvSrchRngLT,
+                                          TComMv* pcMvSrchRngRB,
+                                          TComMv& rcMv,
+                                          UInt& ruiSAD,
+                                          Int iOffsetX,
+                                          Int iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                         ,TComMvTopK* ssBestCand
+#endif
+                                         )
+{
+  Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
+  Int   iSrchRngHorRight  = pcMvSrchRngRB->getHor();
+  Int   iSrchRngVerTop    = pcMvSrchRngLT->getVer();
+  Int   iSrchRngVerBottom = pcMvSrchRngRB->getVer();
+
+  Int   iMIsize           = pcCU->getSlice()->getMicroImSize();
+  Int   iRange            = m_pcEncCfg->getMILatticeRange();
+
+  UInt  uiSadBest         = MAX_UINT;
+  Int   iBestX = 0;
+  Int   iBestY = 0;
+
+  Int   aiBatchX[4];
+  Int   iNumBatch         = 0;
+
+  m_pcRdCost->setDistParam( pcPatternKey, piRefY, iRefStride,  m_cDistParam );
+
+  // fast encoder decision: use subsampled SAD for integer ME
+  if ( m_pcEncCfg->getUseFastEnc() )
+  {
+    if ( m_cDistParam.iRows > 8 )
+    {
+      m_cDistParam.iSubShift = 1;
+    }
+  }
+
+  // first and last lattice points whose neighbourhood can overlap the window
+  Int iLatTop    = ( ( iSrchRngVerTop    - iRange ) / iMIsize ) * iMIsize;
+  Int iLatBottom = ( ( iSrchRngVerBottom + iRange ) / iMIsize ) * iMIsize;
+  Int iLatLeft   = ( ( iSrchRngHorLeft   - iRange ) / iMIsize ) * iMIsize;
+  Int iLatRight  = ( ( iSrchRngHorRight  + iRange ) / iMIsize ) * iMIsize;
+
+  for ( Int iLatY = iLatTop; iLatY <= iLatBottom; iLatY += iMIsize )
+  {
+    Int iTop    = max( iSrchRngVerTop,    iLatY - iRange );
+    Int iBottom = min( iSrchRngVerBottom, iLatY + iRange );
+
+    for ( Int iLatX = iLatLeft; iLatX <= iLatRight; iLatX += iMIsize )
+    {
+      Int iLeft  = max( iSrchRngHorLeft,  iLatX - iRange );
+      Int iRight = min( iSrchRngHorRight, iLatX + iRange );
+
+      for ( Int y = iTop; y <= iBottom; y++ )
+      {
+        Int iRowRight = min( iRight, xGetSSValidRight( y ) );
+        if ( y > iOffsetY )
+        {
+          iRowRight = min( iRowRight, iOffsetX - 1 );
+        }
+
+        for ( Int x = iLeft; x <= iRowRight; x++ )
+        {
+          aiBatchX[iNumBatch++] = x;
+          if ( iNumBatch == 4 || x == iRowRight )
+          {
+#if IT_SS_NUMBER_OF_BEST_CAND
+            xPatternSearchBatch( piRefY + y * iRefStride, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY, ssBestCand );
+#else
+            xPatternSearchBatch( piRefY + y * iRefStride, aiBatchX, y, iNumBatch, uiSadBest, iBestX, iBestY );
+#endif
+            iNumBatch = 0;
+          }
+        }
+      }
+    }
+  }
+
+  if ( uiSadBest == MAX_UINT )
+  {
+    ruiSAD = MAX_UINT;
+    return;
+  }
+
+  rcMv.set( iBestX, iBestY );
+
+  ruiSAD = uiSadBest - m_pcRdCost->getCost( iBestX, iBestY );
+}
+#endif
+
+#if IT_SS_HASH_SEARCH
+/** Look up close matches of the SS block in the hash table of the coded CTUs
+ * \param pcCU          current CU
+ * \param pcPatternKey  original block
+ * \param piRefY        SS reference at the block position
+ * \param iRefStride    stride of the reference
+ * \param pcMvSrchRngRB causal search window, bottom-right (integer pel)
+ * \param rcMv          best match
+ * \param ruiSAD        distortion of the match
+ * \param iOffsetX      causal limits returned by the SS xSetSearchRange
+ * \param iOffsetY
+ * \returns true when a causal match within SSHashThreshold was found, so that the window search can be skipped
+ *
+ * The key is a signature of the top-left 8x8 block of the PU. Every hit is evaluated on the whole block with the
+ * usual SAD plus vector cost. Hits may lie outside the search range. The acceptance threshold follows the
+ * quantization step, since even a perfect match differs from the original by the quantization noise.
+ */
+Bool TEncSearch::xPatternSearchHash( TComDataCU* pcCU,
+                                     TComPattern* pcPatternKey,
+                                     Pel* piRefY,
+                                     Int iRefStride,
+                                     TComMv* pcMvSrchRngRB,
+                                     TComMv& rcMv,
+                                     UInt& ruiSAD,
+                                     Int iOffsetX,
+                                     Int iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK* ssBestCand
+#endif
+                                    )
+{
+  UInt  uiKey;
+
+  if ( pcPatternKey->getROIYWidth() < SS_HASH_BLK_SIZE || pcPatternKey->getROIYHeight() < SS_HASH_BLK_SIZE || m_cSSHash.isEmpty() )
+  {
+    return false;
+  }
+  if ( !m_cSSHash.getBlockKey( pcPatternKey->getROIY(), pcPatternKey->getPatternLStride(), uiKey ) )
+  {
+    return false;
+  }
+
+  m_pcRdCost->setDistParam( pcPatternKey, piRefY, iRefStride,  m_cDistParam );
+  if ( m_cDistParam.bApplyWeight )
+  {
+    return false;
+  }
+  setDistParamComp(0);
+  m_cDistParam.bitDepth = g_bitDepthY;
+
+  UInt  uiCostBest = MAX_UINT;
+  UInt  uiSadBest  = MAX_UINT;
+  Int   iBestX     = 0;
+  Int   iBestY     = 0;
+  Int   iNumCand   = 0;
+  Double dQStep    = pow( 2.0, ( pcCU->getQP( 0 ) - 4 ) / 6.0 ) * ( 1 << ( g_bitDepthY - 8 ) );
+  UInt  uiSadMax   = (UInt)( dQStep * m_pcEncCfg->getSSHashThreshold() / 16.0 * pcPatternKey->getROIYWidth() * pcPatternKey->getROIYHeight() );
+
+  for ( Int iEntry = m_cSSHash.getFirst( uiKey ); iEntry >= 0 && iNumCand < IT_SS_HASH_MAX_CAND; iEntry = m_cSSHash.getNext( iEntry ) )
+  {
+    if ( m_cSSHash.getKey( iEntry ) != uiKey )
+    {
+      continue;
+    }
+    iNumCand++;
+
+    Int x = m_cSSHash.getPosX( iEntry ) - m_iSSBlkPelX;
+    Int y = m_cSSHash.getPosY( iEntry ) - m_iSSBlkPelY;
+
+    // same causal rules as the window searches
+    if ( x > pcMvSrchRngRB->getHor() || y > pcMvSrchRngRB->getVer() || x > xGetSSValidRight( y ) || ( y > iOffsetY && x >= iOffsetX ) )
+    {
+      continue;
+    }
+
+    UInt uiCost = m_pcRdCost->getCost( x, y );
+    if ( uiCost >= uiCostBest )
+    {
+      continue;
+    }
+
+    m_cDistParam.pCur = piRefY + y * iRefStride + x;
+#if IT_SS_SAD_CACHE
+    UInt uiSad = m_bSSSadCacheBlk ? xGetSSSad( x, y ) : m_cDistParam.DistFunc( &m_cDistParam );
+#else
+    UInt uiSad = m_cDistParam.DistFunc( &m_cDistParam );
+#endif
+    if ( uiSad + uiCost < uiCostBest )
+    {
+      uiCostBest = uiSad + uiCost;
+      uiSadBest  = uiSad;
+      iBestX     = x;
+      iBestY     = y;
+    }
 #if IT_SS_NUMBER_OF_BEST_CAND > 0
-  //cout << usedBestCand << " ";
+    ssBestCand->insert( x, y, uiSad + uiCost );
 #endif
+  }
 
-  return;
+  if ( uiSadBest > uiSadMax )
+  {
+    return false;
+  }
+
+  rcMv.set( iBestX, iBestY );
+  ruiSAD = uiSadBest;
+  return true;
 }
+#endif
 
-Void TEncSearch::xPatternSearchFast( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* piRefY, Int iRefStride, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, TComMv& rcMv, UInt& ruiSAD )
+Void TEncSearch::xPatternSearchFast( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* piRefY, Int iRefStride, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, TComMv& rcMv, UInt& ruiSAD
+#if IT_HOLOSS
+                                     ,Int     iOffsetX
+                                     ,Int     iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                     ,TComMvTopK* ssBestCand
+#endif
+                                     ,Bool    isSSE
+#endif
+                                     )
 {
   pcCU->getMvPredLeft       ( m_acMvPredictors[0] );
   pcCU->getMvPredAbove      ( m_acMvPredictors[1] );
@@ -6379,7 +7514,15 @@ Void TEncSearch::xPatternSearchFast( TComDataCU* pcCU, TComPattern* pcPatternKey
   switch ( m_iFastSearch )
   {
     case 1:
-      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD );
+      xTZSearch( pcCU, pcPatternKey, piRefY, iRefStride, pcMvSrchRngLT, pcMvSrchRngRB, rcMv, ruiSAD
+#if IT_HOLOSS
+                , iOffsetX, iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                , ssBestCand
+#endif
+                , isSSE
+#endif
+                );
       break;
 
     default:
@@ -6387,7 +7530,16 @@ Void TEncSearch::xPatternSearchFast( TComDataCU* pcCU, TComPattern* pcPatternKey
   }
 }
 
-Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* piRefY, Int iRefStride, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, TComMv& rcMv, UInt& ruiSAD )
+Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* piRefY, Int iRefStride, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, TComMv& rcMv, UInt& ruiSAD
+#if IT_HOLOSS
+                            ,Int     iOffsetX
+                            ,Int     iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                            ,TComMvTopK* ssBestCand
+#endif
+                            ,Bool    isSSE
+#endif
+                            )
 {
   Int   iSrchRngHorLeft   = pcMvSrchRngLT->getHor();
   Int   iSrchRngHorRight  = pcMvSrchRngRB->getHor();
@@ -6404,10 +7556,52 @@ Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* pi
   cStruct.iYStride    = iRefStride;
   cStruct.piRefY      = piRefY;
   cStruct.uiBestSad   = MAX_UINT;
+#if IT_HOLOSS
+  // the SS start points may all be rejected, so the search state needs defined values
+  cStruct.iBestX          = 0;
+  cStruct.iBestY          = 0;
+  cStruct.uiBestRound     = 0;
+  cStruct.uiBestDistance  = 0;
+  cStruct.ucPointNr       = 0;
+  cStruct.bIsSSE      = isSSE;
+  cStruct.iSSOffsetX  = iOffsetX;
+  cStruct.iSSOffsetY  = iOffsetY;
+  cStruct.cSSRngLT    = *pcMvSrchRngLT;
+  cStruct.cSSRngRB    = *pcMvSrchRngRB;
+#if IT_SS_NUMBER_OF_BEST_CAND
+  cStruct.pcSSBestCand = ssBestCand;
+#endif
+#endif
 
   // set rcMv (Median predictor) as start point and as best point
   xTZSearchHelp( pcPatternKey, cStruct, rcMv.getHor(), rcMv.getVer(), 0, 0 );
 
+#if IT_HOLOSS
+  if ( isSSE )
+  {
+    // SS: the remaining AMVP candidates and the neighbouring micro-images are the likely matches
+    AMVPInfo* pcAMVPInfo = pcCU->getCUMvField( REF_PIC_LIST_0 )->getAMVPInfo();
+    for ( Int i = 0; i < pcAMVPInfo->iN; i++ )
+    {
+      TComMv cMv = pcAMVPInfo->m_acMvCand[i];
+      pcCU->clipMv( cMv );
+      cMv >>= 2;
+      xTZSearchHelp( pcPatternKey, cStruct, cMv.getHor(), cMv.getVer(), 0, 0 );
+    }
+
+    Int iMIsize = pcCU->getSlice()->getMicroImSize();
+    if ( iMIsize > 0 )
+    {
+      Int iMIShiftX = ( ( pcPatternKey->getROIYWidth()  + iMIsize - 1 ) / iMIsize ) * iMIsize;
+      Int iMIShiftY = ( ( pcPatternKey->getROIYHeight() + iMIsize - 1 ) / iMIsize ) * iMIsize;
+      xTZSearchHelp( pcPatternKey, cStruct, -iMIShiftX,          0, 0, 0 ); // left MI
+      xTZSearchHelp( pcPatternKey, cStruct,          0, -iMIShiftY, 0, 0 ); // above MI
+      xTZSearchHelp( pcPatternKey, cStruct, -iMIShiftX, -iMIShiftY, 0, 0 ); // above-left MI
+      xTZSearchHelp( pcPatternKey, cStruct,  iMIShiftX, -iMIShiftY, 0, 0 ); // above-right MI
+    }
+  }
+#endif
+
   // test whether one of PRED_A, PRED_B, PRED_C MV is better start point than Median predictor
   if ( bTestOtherPredictedMV )
   {
@@ -6475,7 +7669,11 @@ Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* pi
   }
 
   // raster search if distance is too big
+#if IT_HOLOSS
+  if ( bEnableRasterSearch && ( ((Int)(cStruct.uiBestDistance) > iRaster) || bAlwaysRasterSearch || cStruct.uiBestSad == MAX_UINT ) )
+#else
   if ( bEnableRasterSearch && ( ((Int)(cStruct.uiBestDistance) > iRaster) || bAlwaysRasterSearch ) )
+#endif
   {
     cStruct.uiBestDistance = iRaster;
     for ( iStartY = iSrchRngVerTop; iStartY <= iSrchRngVerBottom; iStartY += iRaster )
@@ -6556,6 +7754,15 @@ Void TEncSearch::xTZSearch( TComDataCU* pcCU, TComPattern* pcPatternKey, Pel* pi
     }
   }
 
+#if IT_HOLOSS
+  if ( cStruct.uiBestSad == MAX_UINT )
+  {
+    // no causal position available for the SS search
+    ruiSAD = MAX_UINT;
+    return;
+  }
+#endif
+
   // write out best match
   rcMv.set( cStruct.iBestX, cStruct.iBestY );
   ruiSAD = cStruct.uiBestSad - m_pcRdCost->getCost( cStruct.iBestX, cStruct.iBestY );
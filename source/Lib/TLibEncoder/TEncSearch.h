@@ -48,6 +48,9 @@
 #include "TEncEntropy.h"
 #include "TEncSbac.h"
 #include "TEncCfg.h"
+#if IT_SS_HASH_SEARCH
+#include "TEncSSHash.h"
+#endif
 #include <cmath>
 //! \ingroup TLibEncoder
 //! \{
@@ -92,6 +95,14 @@ private:
   Int*            m_ppcQTTempTUArlCoeffCb;
   Int*            m_ppcQTTempTUArlCoeffCr;
 #endif
+#if FAST_INTRA_REF_CACHE
+  // reference samples of the TUs starting at the current intra PU, per TU depth
+  UInt            m_uiIntraRefCachePartIdx;                             ///< first partition of the PU under test, MAX_UINT when disabled
+  Bool            m_abIntraRefCacheValid[MAX_CU_DEPTH];
+  Bool            m_abIntraRefCacheAbove[MAX_CU_DEPTH];
+  Bool            m_abIntraRefCacheLeft [MAX_CU_DEPTH];
+  Int             m_aiIntraRefCache[MAX_CU_DEPTH][2*(4*MAX_CU_SIZE+1)]; ///< first row and column of the unfiltered and filtered buffers
+#endif
 protected:
   // interface to option
   TEncCfg*        m_pcEncCfg;
@@ -109,6 +120,42 @@ protected:
   TComMv          m_cSrchRngLT;
   TComMv          m_cSrchRngRB;
   TComMv          m_acMvPredictors[3];
+#if IT_HOLOSS
+  TComPicYuv*     m_pcSSRefYuv;       ///< SS reference of the current integer search
+  Int             m_iSSBlkPelX;       ///< luma position and size of the searched block
+  Int             m_iSSBlkPelY;
+  Int             m_iSSBlkWidth;
+  Int             m_iSSBlkHeight;
+#endif
+#if IT_SS_SEA
+  // successive elimination for the full search
+  UInt*           m_puiSEASum;        ///< integral image of the search window, over the rows used by the SAD
+  Int             m_iSEASumSize;
+  Int             m_iSEASumStride;
+  Int             m_iSEASubStep;      ///< row step of the SAD (fast encoder subsampling)
+  Int             m_aiSEAOrgSum[5];   ///< sums of the original block: whole block, then the four quadrants
+#endif
+#if IT_SS_HASH_SEARCH
+  TEncSSHash      m_cSSHash;          ///< 8x8 blocks of the coded CTUs of the SS reference
+#endif
+#if IT_SS_SAD_CACHE
+  // SADs of the SS integer searches, shared by all CU depths and partitions of a CTU
+  UShort*         m_pusSSSadCache;    ///< per integer vector, even and odd row SADs of each 8x8 block of the CTU
+  UInt*           m_puiSSSadStamp;    ///< per integer vector, CTU its entries belong to
+  UInt            m_uiSSSadStamp;
+  Int             m_iSSSadRange;      ///< cached vectors: |mv| <= range in both directions
+  Int             m_iSSSadCtuAddr;
+  Int             m_iSSSadCtuX;
+  Int             m_iSSSadCtuY;
+  Int             m_iSSSadCtuBlks;    ///< 8x8 blocks per CTU row
+  Bool            m_bSSSadCacheBlk;   ///< the current SS block can use the cache
+#endif
+#if IT_GT_PARALLEL_SEEDS
+  // independent refinement of the SS seeds of the GT search (GTSearchThreads > 0)
+  Pel*            m_piGTSeedRef;      ///< copy of the search window of each seed of a batch
+  Pel*            m_piGTSeedAux;      ///< warp buffer of each seed of a batch
+  Int             m_iGTSeedRefSize;   ///< samples of a search window
+#endif
   
   // RD computation
   TEncSbac***     m_pppcRDSbacCoder;
@@ -139,6 +186,13 @@ public:
             TEncSbac***   pppcRDSbacCoder,
             TEncSbac*     pcRDGoOnSbacCoder );
   
+#if IT_SS_HASH_SEARCH
+  TEncSSHash* getSSHash         ()  { return &m_cSSHash; }
+#endif
+#if IT_SS_SAD_CACHE
+  Void  initSSSadCache          ( TComDataCU* pcCtu );
+#endif
+
 protected:
   
   /// sub-function for motion vector refinement used in fractional-pel accuracy
@@ -156,10 +210,36 @@ protected:
     UInt  uiBestDistance;
     UInt  uiBestSad;
     UChar ucPointNr;
+#if IT_HOLOSS
+    Bool    bIsSSE;           ///< self-similarity search: only causal, reconstructed positions are tested
+    Int     iSSOffsetX;       ///< causal limits returned by the SS xSetSearchRange
+    Int     iSSOffsetY;
+    TComMv  cSSRngLT;         ///< SS search window (integer pel)
+    TComMv  cSSRngRB;
+#if IT_SS_NUMBER_OF_BEST_CAND
+    TComMvTopK* pcSSBestCand; ///< best searched positions, kept for the GT search
+#endif
+#endif
   } IntTZSearchStruct;
   
   // sub-functions for ME
   __inline Void xTZSearchHelp         ( TComPattern* pcPatternKey, IntTZSearchStruct& rcStruct, const Int iSearchX, const Int iSearchY, const UChar ucPointNr, const UInt uiDistance );
+#if IT_HOLOSS
+  Int           xGetSSValidRight      ( Int iMvY );
+#endif
+#if IT_SS_SAD_CACHE
+  UInt          xGetSSSad             ( Int iMvX, Int iMvY );
+#endif
+#if IT_SS_SEA
+  Void          xSEAInit              ( TComPattern* pcPatternKey, Pel* piRef, Int iRefStride, Int iWinCols, Int iWinRows, Int iSubShift );
+  /// sum of the sampled rows of a window block (window coordinates)
+  Int           xSEAGetSum            ( Int iX, Int iY, Int iWidth, Int iHeight )
+  {
+    const UInt* piBot = m_puiSEASum + ( iY + iHeight - m_iSEASubStep + 2 ) * m_iSEASumStride;
+    const UInt* piTop = m_puiSEASum + ( iY - m_iSEASubStep + 2 ) * m_iSEASumStride;
+    return (Int)( piBot[iX + iWidth] - piBot[iX] - piTop[iX + iWidth] + piTop[iX] );
+  }
+#endif
   __inline Void xTZ2PointSearch       ( TComPattern* pcPatternKey, IntTZSearchStruct& rcStrukt, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB );
   __inline Void xTZ8PointSquareSearch ( TComPattern* pcPatternKey, IntTZSearchStruct& rcStrukt, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, const Int iStartX, const Int iStartY, const Int iDist );
   __inline Void xTZ8PointDiamondSearch( TComPattern* pcPatternKey, IntTZSearchStruct& rcStrukt, TComMv* pcMvSrchRngLT, TComMv* pcMvSrchRngRB, const Int iStartX, const Int iStartY, const Int iDist );
@@ -266,6 +346,16 @@ protected:
                                     TComYuv*     pcResiYuv, 
                                     UInt&        ruiDist,
                                     Int         default0Save1Load2 = 0);
+#if FAST_INTRA_REF_CACHE
+  Void  xStoreIntraRefCache       ( UInt         uiTrDepth,
+                                    UInt         uiSize,
+                                    Bool         bAboveAvail,
+                                    Bool         bLeftAvail );
+  Bool  xLoadIntraRefCache        ( UInt         uiTrDepth,
+                                    UInt         uiSize,
+                                    Bool&        rbAboveAvail,
+                                    Bool&        rbLeftAvail );
+#endif
   Void  xIntraCodingChromaBlk     ( TComDataCU*  pcCU,
                                     UInt         uiTrDepth,
                                     UInt         uiAbsPartIdx,
@@ -441,7 +531,16 @@ protected:
                                     TComMv*       pcMvSrchRngLT,
                                     TComMv*       pcMvSrchRngRB,
                                     TComMv&       rcMv,
-                                    UInt&         ruiSAD );
+                                    UInt&         ruiSAD
+#if IT_HOLOSS
+                                    ,Int          iOffsetX
+                                    ,Int          iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK*  ssBestCand
+#endif
+                                    ,Bool         isSSE
+#endif
+                                    );
   
   Void xSetSearchRange            ( TComDataCU*   pcCU,
                                     TComMv&       cMvPred,
@@ -466,7 +565,16 @@ protected:
                                     TComMv*       pcMvSrchRngLT,
                                     TComMv*       pcMvSrchRngRB,
                                     TComMv&       rcMv,
-                                    UInt&         ruiSAD );
+                                    UInt&         ruiSAD
+#if IT_HOLOSS
+                                    ,Int          iOffsetX
+                                    ,Int          iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK*  ssBestCand
+#endif
+                                    ,Bool         isSSE
+#endif
+                                    );
   
   Void xPatternSearch             ( TComPattern*  pcPatternKey,
                                     Pel*          piRefY,
@@ -480,10 +588,56 @@ protected:
                                     ,Int          riOffsetY
 #endif
 #if IT_SS_NUMBER_OF_BEST_CAND
-									,TComMv*		ssBestCand
+									,TComMvTopK*	ssBestCand
 #endif
 									, Bool         isSSE = false
                                   );
+
+  Void xPatternSearchBatch        ( Pel*          piRefRow,
+                                    const Int*    piMvX,
+                                    Int           iMvY,
+                                    Int           iNumPos,
+                                    UInt&         ruiSadBest,
+                                    Int&          riBestX,
+                                    Int&          riBestY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK*  ssBestCand
+#endif
+                                    );
+
+#if IT_SS_MI_LATTICE_SEARCH
+  Void xPatternSearchMILattice    ( TComDataCU*   pcCU,
+                                    TComPattern*  pcPatternKey,
+                                    Pel*          piRefY,
+                                    Int           iRefStride,
+                                    TComMv*       pcMvSrchRngLT,
+                                    TComMv*       pcMvSrchRngRB,
+                                    TComMv&       rcMv,
+                                    UInt&         ruiSAD,
+                                    Int           iOffsetX,
+                                    Int           iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK*  ssBestCand
+#endif
+                                    );
+#endif
+
+#if IT_SS_HASH_SEARCH
+  Bool xPatternSearchHash         ( TComDataCU*   pcCU,
+                                    TComPattern*  pcPatternKey,
+                                    Pel*          piRefY,
+                                    Int           iRefStride,
+                                    TComMv*       pcMvSrchRngRB,
+                                    TComMv&       rcMv,
+                                    UInt&         ruiSAD,
+                                    Int           iOffsetX,
+                                    Int           iOffsetY
+#if IT_SS_NUMBER_OF_BEST_CAND
+                                    ,TComMvTopK*  ssBestCand
+#endif
+                                    );
+#endif
+
   
   Void xPatternSearchFracDIF      ( TComDataCU*   pcCU,
                                     TComPattern*  pcPatternKey,
@@ -497,6 +651,7 @@ protected:
                                    );
 
 #if IT_GT
+  template <Bool bAffine>
   Void xPatternSearchGT(TComDataCU* pcCU,
                                          TComPattern* pcPatternKey,
                                          Pel* piRefY,
@@ -512,9 +667,26 @@ protected:
                                          UInt& ruiCost
                                          ,Bool biPred
 #if IT_SS_NUMBER_OF_BEST_CAND
-										 ,TComMv* bestSSCand
+										 ,TComMvTopK* bestSSCand
 #endif
                                          );
+  UInt xGTWarpCost      ( Pel* piRefSrch, Pel* piAux, GTWarpParam& rcParam, Int iCols, Int iRows, Int iRefSrchStride, Int iNSSWindow, DistParam& rcDistParam, UInt uiCost, UInt uiCostBound );
+#if IT_GT_SEARCH == 2
+  template <Bool bAffine>
+  Bool xGTDiamondSearch( Pel* piRefSrch, Int piRefSrchStride, Pel* piAux, DistParam& rcDistParam, Int iCols, Int iRows, Int iNSSWindow, Int iMaxNSSIteration, Int lastIterationStep, Short Hor, Short Ver, UInt& uiDistBest, Int* iBestCornerX, Int* iBestCornerY );
+#endif
+#if IT_SS_NUMBER_OF_BEST_CAND && !IT_SS_QUARTER_PEL
+  Void xGTCopySeedWindow( const Pel* piSrc, Int iSrcStride, Pel* piDst, Int iDstStride, Int iWidth, Int iHeight );
+#endif
+#if IT_GT_PARALLEL_SEEDS && IT_SS_NUMBER_OF_BEST_CAND
+  template <Bool bAffine>
+  Void xGTRefineSeeds  ( Int iNumSeeds, const Short* piSeedHor, const Short* piSeedVer, Pel* const* ppiSeedRef, Int piRefSrchStride, Int iCols, Int iRows, Int iNSSWindow, Int iMaxNSSIteration, Int lastIterationStep,
+                         UInt uiRefCost, UInt& ruiDistBest, Int* iBestCornerX, Int* iBestCornerY, Int& riBestSSX, Int& riBestSSY );
+#endif
+#if IT_GT_FIXED_POINT_WARP
+  Bool xGTGradientSearch( Pel* piRefSrch, Int iRefSrchStride, Pel* piAux, Int iCols, Int iRows, Int iNSSWindow, Int iStep, Bool bAffine, Int iHor, Int iVer, TComMv* pcGT, UInt& ruiDistBest );
+  UInt xGTGradientCost  ( Pel* piRefSrch, Int iRefSrchStride, Pel* piAux, Int iCols, Int iRows, Int iNSSWindow, Int iStep, Int iHor, Int iVer, Int* piGTX, Int* piGTY, UInt uiCostBound );
+#endif
 #endif
 
   Void xExtDIFUpSamplingH( TComPattern* pcPattern, Bool biPred  );
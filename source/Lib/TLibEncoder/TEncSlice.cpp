@@ -604,6 +604,11 @@ Void TEncSlice::initEncSlice( TComPic* pcPic, Int pocLast, Int pocCurr, Int iNum
   }
   rpcSlice->setMicroImSize  ( m_pcCfg->getMicroImSize() );
 #endif // IT_MI_MERGE_CANDIDATE
+#if IT_GT
+  rpcSlice->setGTAffineFlag   ( m_pcCfg->getGTAffine() );
+  rpcSlice->setGTMaxIteration ( m_pcCfg->getGTMaxIteration() );
+  rpcSlice->setGTInterpFilter ( m_pcCfg->getGTInterpFilter() );
+#endif
 
   xStoreWPparam( pPPS->getUseWP(), pPPS->getWPBiPred() );
 }
@@ -902,6 +907,25 @@ Void TEncSlice::compressSlice( TComPic*& rpcPic )
     xCheckWPEnable( pcSlice );
   }
 
+#if IT_GT
+  m_pcPredSearch->setGTTools( pcSlice );
+  m_pcRdCost->setGTAffine( pcSlice->getGTAffineFlag() );
+  m_pcRdCost->setGTMaxIteration( pcSlice->getGTMaxIteration() );
+#endif
+
+#if IT_SS_HASH_SEARCH
+  // the SS reference is cleared with the reference lists of the slice, so is its hash table
+  if ( m_pcCfg->getUseSSHashSearch() &&
+       ( ( pcSlice->getSliceType() == ISS_SLICE && pcSlice->getNumRefIdx(REF_PIC_LIST_0) > 0 ) || pcSlice->getSliceType() == PSS_SLICE )
+#if IT_SCALABLE_V1
+       && !pcSlice->isScalableSlice()
+#endif
+     )
+  {
+    m_pcPredSearch->getSSHash()->reset( pcSlice->getRefPic( REF_PIC_LIST_0, pcSlice->getRefIdxOfSS() )->getPicYuvRec() );
+  }
+#endif
+
 #if ADAPTIVE_QP_SELECTION
   if( m_pcCfg->getUseAdaptQpSelect() )
   {